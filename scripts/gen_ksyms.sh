@@ -0,0 +1,30 @@
+#!/bin/bash
+# gen_ksyms.sh - Brandon Media OS kernel symbol table generator
+#
+# Reads `nm -n` output of the first-pass kernel link and writes assembly for
+# the .ksyms section: a symbol count, then {address, name} pairs sorted by
+# address, then the names. Only text symbols are kept.
+#
+# Usage: nm -n build/kernel.pass1.elf | bash scripts/gen_ksyms.sh > build/ksyms.S
+
+awk '
+BEGIN {
+    count = 0
+}
+$2 ~ /^[Tt]$/ && $3 !~ /^\.L/ {
+    address[count] = $1
+    name[count] = $3
+    count++
+}
+END {
+    print "/* Generated by scripts/gen_ksyms.sh - do not edit */"
+    print ".section .ksyms, \"a\""
+    print ".balign 8"
+    printf ".quad %d\n", count
+    for (i = 0; i < count; i++) {
+        printf ".quad 0x%s, .Lksym_name_%d\n", address[i], i
+    }
+    for (i = 0; i < count; i++) {
+        printf ".Lksym_name_%d: .asciz \"%s\"\n", i, name[i]
+    }
+}'
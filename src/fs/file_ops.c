@@ -332,6 +332,28 @@ int64_t vfs_seek(int fd_num, int64_t offset, int whence) {
     return new_offset;
 }
 
+/* Device control */
+int64_t vfs_ioctl(int fd_num, uint32_t cmd, void *arg) {
+    /* Get current process */
+    struct process *proc = process_get_current();
+    if (!proc) {
+        return -1;
+    }
+    
+    /* Get file descriptor */
+    struct file_descriptor *fd = fd_get(proc, fd_num);
+    if (!fd || !fd->node) {
+        return -1;
+    }
+    
+    if (!fd->node->ops || !fd->node->ops->ioctl) {
+        serial_puts("[ERROR] Neural channel has no control interface\n");
+        return -1;
+    }
+    
+    return fd->node->ops->ioctl(fd->node, cmd, arg);
+}
+
 /* Get file status */
 int vfs_stat(const char *path, struct file_stat *stat) {
     if (!path || !stat) {
@@ -265,6 +265,49 @@ struct vfs_node *vfs_node_lookup(struct vfs_node *parent, const char *name) {
     return NULL;
 }
 
+/* Create a device node, making missing parent directories on the way */
+struct vfs_node *vfs_create_device(const char *dir_path, const char *name,
+                                   struct file_operations *ops, void *data) {
+    if (!vfs_root || !dir_path || !name) return NULL;
+    
+    struct vfs_node *dir = vfs_root;
+    char component[FS_MAX_NAME];
+    
+    while (*dir_path) {
+        while (*dir_path == '/') dir_path++;
+        if (!*dir_path) break;
+        
+        int comp_len = 0;
+        while (*dir_path && *dir_path != '/' && comp_len < FS_MAX_NAME - 1) {
+            component[comp_len++] = *dir_path++;
+        }
+        component[comp_len] = 0;
+        
+        struct vfs_node *next = vfs_node_lookup(dir, component);
+        if (!next) {
+            next = vfs_node_create(component, FS_TYPE_DIRECTORY);
+            if (!next) return NULL;
+            next->permissions = FS_PERM_USER_ALL | FS_PERM_GROUP_ALL | FS_PERM_OTHER_ALL;
+            vfs_node_add_child(dir, next);
+        } else if (next->type != FS_TYPE_DIRECTORY) {
+            return NULL;
+        }
+        dir = next;
+    }
+    
+    struct vfs_node *node = vfs_node_create(name, FS_TYPE_DEVICE);
+    if (!node) return NULL;
+    
+    node->ops = ops;
+    node->fs_data = data;
+    if (vfs_node_add_child(dir, node) != FS_SUCCESS) {
+        kfree(node);
+        return NULL;
+    }
+    
+    return node;
+}
+
 /* Resolve path to VFS node */
 struct vfs_node *vfs_resolve_path(const char *path) {
     if (!path) return NULL;
@@ -0,0 +1,118 @@
+/* acpi.h - Brandon Media OS ACPI Table Access
+ * RSDP Discovery and System Description Table Lookup
+ */
+
+#ifndef KERNEL_ACPI_H
+#define KERNEL_ACPI_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Table Cache Configuration */
+#define ACPI_MAX_TABLES             32
+
+/* Root System Description Pointer */
+typedef struct {
+    char signature[8];              /* "RSD PTR " */
+    uint8_t checksum;
+    char oem_id[6];
+    uint8_t revision;               /* 0 = ACPI 1.0 (RSDT only) */
+    uint32_t rsdt_address;
+    
+    /* ACPI 2.0+ */
+    uint32_t length;
+    uint64_t xsdt_address;
+    uint8_t extended_checksum;
+    uint8_t reserved[3];
+} __attribute__((packed)) acpi_rsdp_t;
+
+/* Common Table Header */
+typedef struct {
+    char signature[4];
+    uint32_t length;                /* Including this header */
+    uint8_t revision;
+    uint8_t checksum;
+    char oem_id[6];
+    char oem_table_id[8];
+    uint32_t oem_revision;
+    uint32_t creator_id;
+    uint32_t creator_revision;
+} __attribute__((packed)) acpi_sdt_header_t;
+
+/* MCFG - PCI Express Memory-Mapped Configuration */
+typedef struct {
+    uint64_t base_address;          /* ECAM base for start_bus */
+    uint16_t segment;
+    uint8_t start_bus;
+    uint8_t end_bus;
+    uint32_t reserved;
+} __attribute__((packed)) acpi_mcfg_allocation_t;
+
+typedef struct {
+    acpi_sdt_header_t header;
+    uint64_t reserved;
+    acpi_mcfg_allocation_t allocations[];
+} __attribute__((packed)) acpi_mcfg_t;
+
+/* MADT - Multiple APIC Description Table ("APIC") */
+#define ACPI_MADT_LOCAL_APIC        0
+#define ACPI_MADT_IO_APIC           1
+#define ACPI_MADT_INT_OVERRIDE      2
+#define ACPI_MADT_LAPIC_OVERRIDE    5
+
+#define ACPI_MADT_PCAT_COMPAT       0x1     /* Dual 8259s present */
+#define ACPI_MADT_LAPIC_ENABLED     0x1
+
+/* Interrupt source override flags (MPS INTI) */
+#define ACPI_MADT_POLARITY_MASK     0x3
+#define ACPI_MADT_POLARITY_LOW      0x3
+#define ACPI_MADT_TRIGGER_MASK      0xC
+#define ACPI_MADT_TRIGGER_LEVEL     0xC
+
+typedef struct {
+    acpi_sdt_header_t header;
+    uint32_t lapic_address;
+    uint32_t flags;
+} __attribute__((packed)) acpi_madt_t;
+
+typedef struct {
+    uint8_t type;
+    uint8_t length;
+} __attribute__((packed)) acpi_madt_entry_t;
+
+typedef struct {
+    acpi_madt_entry_t entry;
+    uint8_t processor_id;
+    uint8_t apic_id;
+    uint32_t flags;
+} __attribute__((packed)) acpi_madt_lapic_t;
+
+typedef struct {
+    acpi_madt_entry_t entry;
+    uint8_t ioapic_id;
+    uint8_t reserved;
+    uint32_t address;
+    uint32_t gsi_base;
+} __attribute__((packed)) acpi_madt_ioapic_t;
+
+typedef struct {
+    acpi_madt_entry_t entry;
+    uint8_t bus;                    /* 0 = ISA */
+    uint8_t source;                 /* ISA IRQ */
+    uint32_t gsi;
+    uint16_t flags;
+} __attribute__((packed)) acpi_madt_override_t;
+
+typedef struct {
+    acpi_madt_entry_t entry;
+    uint16_t reserved;
+    uint64_t address;
+} __attribute__((packed)) acpi_madt_lapic_override_t;
+
+/* ACPI Functions */
+int acpi_init(void);
+bool acpi_is_available(void);
+const acpi_sdt_header_t *acpi_find_table(const char *signature);
+int acpi_get_mcfg_allocations(const acpi_mcfg_allocation_t **allocations);
+
+#endif /* KERNEL_ACPI_H */
@@ -0,0 +1,42 @@
+/* boot_profile.h - Brandon Media OS Boot-Phase Profiler
+ * TSC Timestamps Around Each Init Step, Reported in Microseconds
+ */
+
+#ifndef KERNEL_BOOT_PROFILE_H
+#define KERNEL_BOOT_PROFILE_H
+
+#include <stdint.h>
+
+/* Profiler Configuration */
+#define BOOT_PROFILE_MAX_SPANS      128
+#define BOOT_PROFILE_MAX_DEPTH      8
+#define BOOT_PROFILE_BUDGET_US      2000000     /* Warn when the timed init steps take longer */
+#define BOOT_PROFILE_TRACE_PATH     "/boot_trace.json"
+
+/* One timed init step; nested steps record their parent */
+typedef struct {
+    const char *name;
+    uint64_t start_tsc;
+    uint64_t end_tsc;
+    uint8_t depth;
+    int16_t parent;                 /* Span index, -1 at top level */
+} boot_span_t;
+
+/* Time a single init call under its own source text */
+#define BOOT_PROFILE_STEP(call) \
+    do { \
+        boot_profile_begin(#call); \
+        call; \
+        boot_profile_end(); \
+    } while (0)
+
+/* Boot Profiler Functions */
+void boot_profile_start(void);
+int boot_profile_begin(const char *name);
+void boot_profile_end(void);
+void boot_profile_finish(void);
+uint64_t boot_profile_total_us(void);
+void boot_profile_report(void);
+int boot_profile_write_trace(const char *path);
+
+#endif /* KERNEL_BOOT_PROFILE_H */
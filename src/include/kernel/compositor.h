@@ -0,0 +1,80 @@
+/* compositor.h - Brandon Media OS Neural Compositor
+ * Shared-Memory Client Surfaces with Damage-Driven Composition
+ */
+
+#ifndef KERNEL_COMPOSITOR_H
+#define KERNEL_COMPOSITOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Compositor Configuration */
+#define COMPOSITOR_MAX_SURFACES     16
+#define COMPOSITOR_MAX_DIMENSION    2048        /* 16MB per surface, fits one span */
+#define COMPOSITOR_DAMAGE_RING      32          /* Damage rects per surface header */
+#define COMPOSITOR_USER_BASE        0x0000700000000000ULL   /* Client mapping window */
+#define COMPOSITOR_USER_SPAN        0x0000000004000000ULL   /* 64MB per surface slot */
+#define COMPOSITOR_SURFACE_MAGIC    0x53555246  /* 'SURF' */
+
+/* Surface Flags */
+#define SURFACE_FLAG_OPAQUE         0x01    /* Ignore alpha, copy rows */
+#define SURFACE_FLAG_HIDDEN         0x02    /* Mapped but not composited */
+
+/* Damage Rectangle (surface-local pixels) */
+typedef struct {
+    int32_t x;
+    int32_t y;
+    int32_t width;
+    int32_t height;
+} surface_damage_t;
+
+/* Shared Surface Header - first page of every client mapping.
+ * Layout is ABI: userland mirrors it in neural_app.h.
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t id;
+    uint32_t width;
+    uint32_t height;
+    uint32_t pitch;                 /* Bytes per pixel row */
+    uint32_t pixel_offset;          /* Pixels start this far from the header */
+    uint32_t flags;
+    uint32_t reserved;
+    
+    /* Single-producer (client) / single-consumer (kernel) damage ring */
+    volatile uint32_t damage_head;  /* Written by client */
+    volatile uint32_t damage_tail;  /* Written by kernel on commit */
+    volatile uint32_t damage_overflow;  /* Client sets when ring was full */
+    volatile uint32_t frame_seq;    /* Kernel bumps per consumed commit */
+    surface_damage_t damage[COMPOSITOR_DAMAGE_RING];
+} surface_shared_t;
+
+/* Compositor Statistics */
+typedef struct {
+    uint32_t surfaces;
+    uint64_t commits;
+    uint64_t damage_rects;
+    uint64_t pixels_composited;
+    uint64_t full_frames;
+    uint64_t damage_frames;
+} compositor_stats_t;
+
+/* Compositor Functions */
+int compositor_init(void);
+void compositor_shutdown(void);
+bool compositor_is_initialized(void);
+
+/* Client Surface Management (called through syscalls) */
+int compositor_surface_create(uint32_t owner_pid, uint32_t width, uint32_t height,
+                              uint32_t flags, uint64_t *user_addr);
+int compositor_surface_destroy(uint32_t owner_pid, uint32_t id);
+int compositor_surface_commit(uint32_t owner_pid, uint32_t id);
+int compositor_surface_configure(uint32_t owner_pid, uint32_t id, int32_t x, int32_t y, int32_t z);
+void compositor_release_process(uint32_t owner_pid);
+
+/* Composition */
+void compositor_render(bool scene_redrawn);
+bool compositor_can_repair(void);
+void compositor_get_stats(compositor_stats_t *stats);
+
+#endif /* KERNEL_COMPOSITOR_H */
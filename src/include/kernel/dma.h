@@ -0,0 +1,83 @@
+/* dma.h - Brandon Media OS DMA Mapping Interface
+ * Bus Addresses, Scatter-Gather Lists, Descriptor Pools and Bounce Buffers
+ */
+
+#ifndef KERNEL_DMA_H
+#define KERNEL_DMA_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "kernel/pci.h"
+
+/* Bus address as seen by the device (identity with physical on x86) */
+typedef uint64_t dma_addr_t;
+
+#define DMA_BIT_MASK(n)             ((n) >= 64 ? ~0ULL : ((1ULL << (n)) - 1))
+#define DMA_MAPPING_ERROR           (~(dma_addr_t)0)
+
+/* Limits */
+#define DMA_MAX_BOUNCES             64          /* Live bounced mappings */
+#define DMA_POOL_MAX_PAGES          64
+
+/* Transfer Direction */
+typedef enum {
+    DMA_TO_DEVICE = 0,
+    DMA_FROM_DEVICE,
+    DMA_BIDIRECTIONAL
+} dma_direction_t;
+
+/* Scatter-Gather Entry */
+typedef struct {
+    void *cpu_addr;
+    size_t length;
+    dma_addr_t dma_address;         /* Filled in by dma_map_sg() */
+} dma_sg_entry_t;
+
+/* Descriptor Pool - fixed-size coherent blocks that never cross a page */
+typedef struct {
+    const char *name;
+    struct pci_device *dev;
+    size_t block_size;
+    void *free_list;
+    struct {
+        uint8_t *cpu_addr;
+        dma_addr_t dma_addr;
+    } pages[DMA_POOL_MAX_PAGES];
+    uint32_t page_count;
+    uint32_t in_use;
+} dma_pool_t;
+
+/* DMA Statistics */
+typedef struct {
+    uint64_t coherent_bytes;
+    uint64_t mappings;
+    uint64_t bounced;
+    uint64_t bounce_bytes;
+    uint64_t failures;
+} dma_stats_t;
+
+/* Addressing Limits */
+int dma_set_mask(struct pci_device *dev, uint64_t mask);
+uint64_t dma_get_mask(struct pci_device *dev);
+
+/* Coherent Memory - physically contiguous, page aligned */
+void *dma_alloc_coherent(struct pci_device *dev, size_t size, dma_addr_t *dma_handle);
+void dma_free_coherent(struct pci_device *dev, size_t size, void *cpu_addr, dma_addr_t dma_handle);
+
+/* Streaming Mappings - bounce when the buffer is out of reach or not contiguous */
+dma_addr_t dma_map_single(struct pci_device *dev, void *cpu_addr, size_t size, dma_direction_t dir);
+void dma_unmap_single(struct pci_device *dev, dma_addr_t dma_handle, size_t size, dma_direction_t dir);
+void dma_sync_single_for_cpu(struct pci_device *dev, dma_addr_t dma_handle, size_t size, dma_direction_t dir);
+void dma_sync_single_for_device(struct pci_device *dev, dma_addr_t dma_handle, size_t size, dma_direction_t dir);
+int dma_map_sg(struct pci_device *dev, dma_sg_entry_t *sg, int nents, dma_direction_t dir);
+void dma_unmap_sg(struct pci_device *dev, dma_sg_entry_t *sg, int nents, dma_direction_t dir);
+
+/* Descriptor Pools */
+dma_pool_t *dma_pool_create(const char *name, struct pci_device *dev, size_t size, size_t align);
+void *dma_pool_alloc(dma_pool_t *pool, dma_addr_t *dma_handle);
+void dma_pool_free(dma_pool_t *pool, void *cpu_addr, dma_addr_t dma_handle);
+void dma_pool_destroy(dma_pool_t *pool);
+
+void dma_get_stats(dma_stats_t *stats);
+
+#endif /* KERNEL_DMA_H */
@@ -0,0 +1,42 @@
+/* effects.h - Brandon Media OS Neural Effect Engine
+ * Fixed-Point Trig Tables and Cached Background Pattern Tiles
+ */
+
+#ifndef KERNEL_EFFECTS_H
+#define KERNEL_EFFECTS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Fixed-Point Trigonometry */
+#define EFFECT_ANGLE_STEPS      1024            /* LUT entries per full turn */
+#define EFFECT_ANGLE_MASK       (EFFECT_ANGLE_STEPS - 1)
+#define EFFECT_FIXED_SHIFT      15
+#define EFFECT_FIXED_ONE        (1 << EFFECT_FIXED_SHIFT)
+
+/* Matrix Rain Tile - one full period of the wave in each axis */
+#define EFFECT_MATRIX_TILE_W    64
+#define EFFECT_MATRIX_TILE_H    128
+#define EFFECT_MATRIX_STEP_X    8       /* Column spacing of matrix glyphs */
+#define EFFECT_MATRIX_STEP_Y    2       /* Row spacing of matrix glyphs */
+
+/* Holographic palette size (one hue cycle) */
+#define EFFECT_HUE_STEPS        256
+
+/* Effect Engine Function Prototypes */
+int effects_init(void);
+bool effects_is_initialized(void);
+
+/* Q15 sine/cosine, angle in EFFECT_ANGLE_STEPS units */
+int32_t effect_sin(uint32_t angle);
+int32_t effect_cos(uint32_t angle);
+uint32_t effect_ms_to_angle(uint32_t time_ms, uint32_t rate_millirad);
+
+/* Cached pattern lookups */
+uint8_t effect_matrix_intensity(uint32_t x, uint32_t y, uint32_t time_ms);
+uint32_t effect_hue_color(uint32_t hue);
+
+/* Detail control (quality governor) - glyph spacing doubles per shift step */
+void effects_set_detail(uint32_t detail_shift, bool scanlines);
+
+#endif /* KERNEL_EFFECTS_H */
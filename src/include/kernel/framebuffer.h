@@ -45,13 +45,52 @@ typedef struct {
     uint32_t max_resolution_y;
 } gpu_capabilities_t;
 
+/* Scanout Pixel Formats */
+typedef enum {
+    FB_FORMAT_NONE = 0,
+    FB_FORMAT_XRGB8888,     /* Native render format */
+    FB_FORMAT_XBGR8888,
+    FB_FORMAT_RGB888,       /* 24bpp, blue byte first */
+    FB_FORMAT_BGR888,       /* 24bpp, red byte first */
+    FB_FORMAT_RGB565,
+    FB_FORMAT_XRGB1555,
+    FB_FORMAT_GENERIC       /* Any other masks, converted per channel */
+} fb_format_t;
+
+/* Format Kernels - convert XRGB8888 into scanout memory */
+typedef struct {
+    fb_format_t format;
+    const char *name;
+    void (*fill_span)(uint8_t *dst, uint32_t color, uint32_t count);
+    void (*blit_span)(uint8_t *dst, const uint32_t *src, uint32_t count);
+} fb_format_ops_t;
+
+/* Linear Mode Description (VESA mode info or GOP) */
+typedef struct {
+    void *base;
+    uint32_t width;
+    uint32_t height;
+    uint32_t pitch;               /* Bytes per scanline, may be padded */
+    uint32_t bpp;
+    uint32_t red_mask;            /* Zero masks select the usual layout for bpp */
+    uint32_t green_mask;
+    uint32_t blue_mask;
+} fb_linear_mode_t;
+
+/* Off-Screen Render Target (XRGB8888, width pixels per row) */
+typedef struct {
+    uint32_t *pixels;
+    uint32_t width;
+    uint32_t height;
+} fb_target_t;
+
 /* Enhanced Framebuffer Device Structure */
 typedef struct framebuffer_device {
     struct hal_device *hal_dev;
     struct pci_device *pci_dev;
     
-    /* Display Properties */
-    uint32_t *framebuffer;        /* Primary framebuffer */
+    /* Display Properties - framebuffer is always XRGB8888, width pixels per row */
+    uint32_t *framebuffer;        /* Primary framebuffer (current render target) */
     uint32_t *back_buffer;        /* Back buffer for double buffering */
     uint32_t *depth_buffer;       /* Z-buffer for 3D rendering */
     uint32_t width;
@@ -60,6 +99,10 @@ typedef struct framebuffer_device {
     uint32_t bpp;                /* Bits per pixel */
     uint32_t bytes_per_pixel;
     
+    /* Scanout - pitch, bpp and masks describe this memory */
+    uint8_t *scanout;             /* Hardware linear framebuffer */
+    const fb_format_ops_t *format_ops;  /* Chosen once at mode set */
+    
     /* Color Masks */
     uint32_t red_mask;
     uint32_t green_mask;
@@ -84,7 +127,7 @@ typedef struct framebuffer_device {
     
     /* Performance Counters */
     uint64_t frames_rendered;
-    uint32_t last_frame_time;
+    uint32_t last_frame_time;     /* Microseconds */
     uint32_t fps;
     
     /* State */
@@ -119,6 +162,7 @@ typedef struct {
 
 /* Framebuffer Function Prototypes */
 int framebuffer_init(void);
+int fb_init_headless(uint32_t width, uint32_t height);
 void framebuffer_shutdown(void);
 void fb_print_info(void);
 void fb_test_graphics(void);
@@ -128,6 +172,8 @@ framebuffer_device_t *framebuffer_get_device(void);
 int fb_enumerate_modes(void);
 int fb_set_mode(uint32_t width, uint32_t height, uint32_t bpp);
 int fb_get_current_mode(display_mode_t *mode);
+int fb_set_linear_mode(const fb_linear_mode_t *mode);
+const fb_format_ops_t *fb_get_format_ops(void);
 void fb_list_modes(void);
 
 /* Enhanced Graphics Primitives */
@@ -148,6 +194,8 @@ void fb_swap_buffers(void);
 void fb_enable_double_buffering(bool enable);
 void fb_enable_vsync(bool enable);
 void fb_copy_buffer(uint32_t *src, uint32_t *dst, uint32_t width, uint32_t height);
+uint32_t *fb_set_render_target(uint32_t *target);   /* Returns previous target */
+void fb_bind_target(const fb_target_t *target, fb_target_t *previous);
 
 /* Blitting and Texture Operations */
 void fb_blit(uint32_t *src, int32_t sx, int32_t sy, int32_t dx, int32_t dy, uint32_t width, uint32_t height);
@@ -189,6 +237,7 @@ uint32_t fb_color_multiply(uint32_t color, float factor);
 /* Performance Monitoring */
 void fb_get_performance_stats(uint64_t *frames, uint32_t *fps, uint32_t *frame_time);
 void fb_reset_performance_stats(void);
+void fb_update_frame_stats(uint32_t frame_time_us);
 
 /* Hardware Detection */
 int fb_detect_gpu(void);
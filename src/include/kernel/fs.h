@@ -162,6 +162,7 @@ int vfs_close(int fd);
 int64_t vfs_read(int fd, void *buffer, size_t count);
 int64_t vfs_write(int fd, const void *buffer, size_t count);
 int64_t vfs_seek(int fd, int64_t offset, int whence);
+int64_t vfs_ioctl(int fd, uint32_t cmd, void *arg);
 int vfs_stat(const char *path, struct file_stat *stat);
 int vfs_fstat(int fd, struct file_stat *stat);
 
@@ -192,6 +193,8 @@ void vfs_node_unref(struct vfs_node *node);
 struct vfs_node *vfs_node_lookup(struct vfs_node *parent, const char *name);
 int vfs_node_add_child(struct vfs_node *parent, struct vfs_node *child);
 int vfs_node_remove_child(struct vfs_node *parent, const char *name);
+struct vfs_node *vfs_create_device(const char *dir_path, const char *name,
+                                   struct file_operations *ops, void *data);
 
 /* Utility functions */
 const char *vfs_get_type_name(uint32_t type);
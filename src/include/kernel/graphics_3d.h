@@ -159,6 +159,7 @@ typedef struct {
     uint32_t vertices_processed;
     uint32_t pixels_drawn;
     uint32_t frame_time_ms;
+    uint64_t frame_start_tsc;    /* Set by clear, consumed by present */
     
     bool initialized;
 } renderer_3d_t;
@@ -169,6 +170,8 @@ void graphics_3d_shutdown(void);
 void graphics_3d_clear(uint32_t color);
 void graphics_3d_present(void);
 void graphics_3d_set_viewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+int graphics_3d_set_target(uint32_t *framebuffer, uint32_t width, uint32_t height);
+renderer_3d_t *graphics_3d_get_renderer(void);
 
 /* Vector Math */
 vec3_t vec3_add(vec3_t a, vec3_t b);
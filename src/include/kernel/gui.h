@@ -9,10 +9,15 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "kernel/framebuffer.h"
+#include "kernel/texture.h"
+#include "kernel/graphics_3d.h"     /* vec3_t for parallax */
 
 /* GUI Layer System for 3D Parallax Effects */
 #define MAX_GUI_LAYERS 8
-#define MAX_WIDGETS_PER_LAYER 32
+#define GUI_WIDGET_INITIAL_CAPACITY 32  /* Per-layer storage grows on demand */
+#define GUI_GRID_CELL_SIZE 64           /* Spatial index cell edge in pixels */
+#define GUI_EASING_STEPS 256            /* Samples per precomputed easing curve */
+#define GUI_ANIMATION_INITIAL_CAPACITY 16
 
 /* Parallax Layer Types */
 typedef enum {
@@ -26,11 +31,6 @@ typedef enum {
     LAYER_CURSOR              /* Mouse cursor */
 } gui_layer_type_t;
 
-/* 3D Vector for Parallax Calculations */
-typedef struct {
-    float x, y, z;
-} vec3_t;
-
 /* 2D Point Structure */
 typedef struct {
     int32_t x, y;
@@ -55,6 +55,10 @@ typedef struct {
     bool visible;
     bool interactive;
     uint8_t opacity;         /* 0-255 */
+    
+    /* Cached off-screen surface (screen sized, alpha 0 = transparent) */
+    uint32_t *surface;
+    bool dirty;              /* Widgets changed since last repaint */
 } gui_layer_t;
 
 /* Widget Types */
@@ -98,6 +102,7 @@ typedef struct {
     uint32_t duration_ms;
     uint32_t elapsed_ms;
     float progress;          /* 0.0 to 1.0 */
+    float eased;             /* progress through the type's easing curve */
     bool active;
     bool loop;
     void (*on_complete)(void *widget);
@@ -134,6 +139,13 @@ typedef struct gui_widget {
     
     /* Widget-specific data */
     void *data;
+    uint32_t data_size;      /* Bytes copied into render snapshots */
+    
+    /* Layer storage and spatial index bookkeeping */
+    uint32_t layer_index;    /* Position in layer (render order) */
+    rect_t indexed_bounds;   /* Bounds the grid currently holds */
+    uint32_t query_stamp;    /* Dedupe marker for multi-cell queries */
+    bool indexed;
     
     /* Linked list for layer management */
     struct gui_widget *next;
@@ -161,11 +173,50 @@ typedef struct {
     color_rgba_t secondary_color;
 } neural_matrix_data_t;
 
+/* Growable Widget List */
+typedef struct {
+    gui_widget_t **items;
+    uint32_t count;
+    uint32_t capacity;
+} gui_widget_list_t;
+
+/* Uniform Grid Spatial Index (one per layer) */
+typedef struct {
+    uint32_t cols;
+    uint32_t rows;
+    gui_widget_list_t *cells;
+} gui_spatial_grid_t;
+
+/* Render Snapshot of One Layer - widgets are value copies in render order */
+typedef struct {
+    gui_widget_t *widgets;
+    uint32_t count;
+    uint32_t capacity;
+    vec3_t offset;
+    bool visible;
+} gui_snapshot_layer_t;
+
+/* Render Snapshot - everything gui_render needs from the update stage */
+typedef struct {
+    uint64_t seq;
+    uint64_t input_tsc;      /* Oldest input this snapshot first reflects (0 if none) */
+    uint32_t frame_time;     /* Animation clock for background effects */
+    point2d_t mouse_pos;
+    gui_snapshot_layer_t layers[MAX_GUI_LAYERS];
+    
+    /* Copies of widget data blocks, pointed to by the widget copies */
+    uint8_t *data_arena;
+    uint32_t data_used;
+    uint32_t data_capacity;
+} gui_snapshot_t;
+
 /* GUI System State */
 typedef struct {
     gui_layer_t layers[MAX_GUI_LAYERS];
-    gui_widget_t *widgets[MAX_GUI_LAYERS][MAX_WIDGETS_PER_LAYER];
-    uint32_t widget_count[MAX_GUI_LAYERS];
+    gui_widget_list_t widgets[MAX_GUI_LAYERS];
+    gui_spatial_grid_t grids[MAX_GUI_LAYERS];
+    uint32_t query_stamp;
+    uint32_t layout_generation;  /* Bumped when widgets are added, removed or moved */
     
     /* Camera/View State for Parallax */
     vec3_t camera_position;
@@ -181,6 +232,9 @@ typedef struct {
     /* Animation System */
     uint32_t frame_time_ms;
     uint32_t last_frame_time;
+    uint32_t animation_divisor;  /* Advance animations every Nth update */
+    uint32_t animation_tick;
+    uint32_t animation_pending_ms;
     
     /* Accessibility */
     bool reduced_motion;
@@ -206,11 +260,19 @@ void gui_update(uint32_t delta_ms);
 void gui_render(void);
 void gui_handle_input(void);
 
+/* Render Snapshots (update/render pipeline) */
+int gui_capture_snapshot(gui_snapshot_t *snapshot);
+void gui_free_snapshot(gui_snapshot_t *snapshot);
+uint32_t gui_take_dirty_layers(void);
+void gui_render_snapshot(const gui_snapshot_t *snapshot, uint32_t dirty_layers);
+
 /* Layer Management */
 void gui_set_layer_parallax(gui_layer_type_t layer, float factor);
 void gui_set_layer_visibility(gui_layer_type_t layer, bool visible);
 void gui_set_camera_position(vec3_t position);
 void gui_move_camera(vec3_t delta);
+void gui_set_parallax_strength(float strength);
+void gui_set_animation_divisor(uint32_t divisor);
 
 /* Widget Management */
 gui_widget_t *gui_create_widget(widget_type_t type, const char *name, rect_t bounds, gui_layer_type_t layer);
@@ -218,19 +280,37 @@ void gui_destroy_widget(gui_widget_t *widget);
 void gui_add_widget(gui_widget_t *widget);
 void gui_remove_widget(gui_widget_t *widget);
 gui_widget_t *gui_find_widget(const char *name);
+
+/* Spatial Queries and Input Routing */
+gui_widget_t *gui_widget_at(point2d_t point);
+uint32_t gui_query_widgets(gui_layer_type_t layer, rect_t area, gui_widget_t **out, uint32_t max);
+void gui_set_widget_bounds(gui_widget_t *widget, rect_t bounds);
+uint32_t gui_collect_tab_order(gui_widget_t **out, uint32_t max);
+uint32_t gui_get_widget_count(void);
+uint32_t gui_get_layout_generation(void);
+
+/* Layer Surface Cache */
+void gui_invalidate_layer(gui_layer_type_t layer);
+void gui_invalidate_widget(gui_widget_t *widget);
+void gui_invalidate_all(void);
 gui_widget_t *gui_widget_at_position(point2d_t pos);
 
 /* Specific Widget Creators */
 gui_widget_t *gui_create_button(const char *name, rect_t bounds, const char *text, widget_click_handler_t callback);
 gui_widget_t *gui_create_panel(const char *name, rect_t bounds, color_rgba_t bg_color);
+void gui_set_panel_texture(gui_widget_t *panel, texture_t *texture, texture_filter_t filter);
 gui_widget_t *gui_create_label(const char *name, rect_t bounds, const char *text);
 gui_widget_t *gui_create_scada_gauge(const char *name, rect_t bounds, float min_val, float max_val, const char *unit);
 gui_widget_t *gui_create_neural_matrix(const char *name, rect_t bounds, uint32_t width, uint32_t height);
+gui_widget_t *gui_create_progress_bar(const char *name, rect_t bounds, const char *label);
+void gui_set_progress_value(gui_widget_t *progress_bar, float value);
 
 /* Animation System */
 void gui_start_animation(gui_widget_t *widget, animation_type_t type, uint32_t duration_ms, bool loop);
 void gui_stop_animation(gui_widget_t *widget);
 void gui_update_animations(uint32_t delta_ms);
+uint32_t gui_get_active_animation_count(void);
+float gui_ease(animation_type_t type, float t);
 
 /* SCADA Functions */
 void gui_update_gauge_value(gui_widget_t *gauge, float value);
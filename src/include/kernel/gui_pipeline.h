@@ -0,0 +1,47 @@
+/* gui_pipeline.h - Brandon Media OS Neural GUI Pipeline
+ * Fixed-Rate Update Stage and Snapshot-Driven Render Stage
+ */
+
+#ifndef KERNEL_GUI_PIPELINE_H
+#define KERNEL_GUI_PIPELINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "kernel/gui.h"
+
+/* Pipeline Configuration */
+#define GUI_PIPELINE_UPDATE_HZ      125         /* Input + simulation rate */
+#define GUI_PIPELINE_STEP_US        (1000000 / GUI_PIPELINE_UPDATE_HZ)
+#define GUI_PIPELINE_MAX_CATCHUP    8           /* Steps per call before dropping time */
+#define GUI_PIPELINE_RENDER_US      16667       /* ~60fps render pacing */
+#define GUI_PIPELINE_NO_READER      0xFFFFFFFF
+
+/* Pipeline Statistics */
+typedef struct {
+    uint64_t update_steps;
+    uint64_t dropped_steps;         /* Steps discarded by the catch-up limit */
+    uint64_t snapshots_published;
+    uint64_t snapshots_deferred;    /* Back snapshot still held by the renderer */
+    uint64_t frames_rendered;
+    uint64_t frames_repeated;       /* Rendered without a newer snapshot */
+    uint32_t last_update_us;        /* Cost of the last update step */
+    uint32_t last_render_us;        /* Cost of the last rendered frame */
+} gui_pipeline_stats_t;
+
+/* Pipeline Functions */
+int gui_pipeline_init(void);
+void gui_pipeline_shutdown(void);
+bool gui_pipeline_is_initialized(void);
+
+/* Stages - each may run on its own CPU */
+void gui_pipeline_update_stage(uint64_t now_us);
+bool gui_pipeline_render_stage(uint64_t now_us);
+void gui_pipeline_render_loop(void);
+void gui_pipeline_poll(void);
+
+/* Snapshot Exchange */
+const gui_snapshot_t *gui_pipeline_acquire(void);
+void gui_pipeline_release(void);
+void gui_pipeline_get_stats(gui_pipeline_stats_t *stats);
+
+#endif /* KERNEL_GUI_PIPELINE_H */
@@ -6,8 +6,14 @@
 #define KERNEL_HAL_H
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "kernel/pci.h"
 
+/* Asynchronous Probe */
+#define HAL_PROBE_PENDING           1           /* init/poll: started, not finished */
+#define HAL_MAX_DEPENDENCIES        4
+#define HAL_PROBE_TIMEOUT_US        2000000     /* Per device, from first init call */
+
 /* Device Types */
 typedef enum {
     DEVICE_TYPE_UNKNOWN = 0,
@@ -50,6 +56,23 @@ struct hal_device {
     int (*reset)(struct hal_device *dev);
     void (*cleanup)(struct hal_device *dev);
     
+    /* Split-phase init: after init returns HAL_PROBE_PENDING, poll is called
+     * until it returns 0 (ready) or negative (failed). Lets slow hardware
+     * waits overlap instead of stacking up.
+     */
+    int (*poll)(struct hal_device *dev);
+    
+    /* Devices that must be active before this one probes */
+    struct hal_device *depends_on[HAL_MAX_DEPENDENCIES];
+    uint8_t dependency_count;
+    
+    /* Probe bookkeeping */
+    volatile uint32_t probe_busy;   /* Held by the CPU running init/poll */
+    uint8_t probe_cpu;              /* CPU that started the probe */
+    uint64_t probe_start_tsc;
+    uint64_t probe_ready_tsc;
+    uint64_t probe_cycles;          /* Time spent inside init/poll */
+    
     /* Linked list */
     struct hal_device *next;
 };
@@ -70,5 +93,8 @@ void hal_print_device_info(struct hal_device *device);
 void hal_print_all_devices(void);
 int hal_get_device_count(void);
 void hal_initialize_all_devices(void);
+int hal_add_dependency(struct hal_device *device, struct hal_device *dependency);
+int hal_probe_worker_step(bool *progress);
+void hal_print_probe_timings(void);
 
 #endif /* KERNEL_HAL_H */
\ No newline at end of file
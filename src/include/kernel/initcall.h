@@ -0,0 +1,60 @@
+/* initcall.h - Brandon Media OS Initcall Graph
+ * Declared Subsystem Start-Up with Dependencies, Levels and Lazy Activation
+ */
+
+#ifndef KERNEL_INITCALL_H
+#define KERNEL_INITCALL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Initcall Configuration */
+#define INITCALL_MAX_CALLS          64
+#define INITCALL_MAX_DEPENDENCIES   4
+#define INITCALL_LATE_TIMEOUT_TICKS 500     /* Start late calls anyway after 5s at 100Hz */
+
+/* Levels run in order; a dependency may pull a call from a later level forward */
+typedef enum {
+    INITCALL_LEVEL_CORE = 0,        /* Memory management */
+    INITCALL_LEVEL_SUBSYS,          /* Processes, syscalls, filesystems */
+    INITCALL_LEVEL_DEVICE,          /* Drivers, SMP, interrupts */
+    INITCALL_LEVEL_USER,            /* First userland process */
+    INITCALL_LEVEL_LATE,            /* Non-critical, once userland is running */
+    INITCALL_LEVEL_COUNT
+} initcall_level_t;
+
+/* Initcall Flags */
+#define INITCALL_LAZY               0x01    /* Only started by initcall_require() */
+#define INITCALL_GRAPHICS           0x02    /* Never started when headless */
+
+/* Initcall State */
+typedef enum {
+    INITCALL_PENDING = 0,
+    INITCALL_RUNNING,
+    INITCALL_DONE,
+    INITCALL_FAILED,
+    INITCALL_SKIPPED
+} initcall_state_t;
+
+/* Declared initcall. A dependency written "?name" only orders this call after
+ * `name` when that one runs anyway; it never pulls it in or blocks on it.
+ */
+typedef struct {
+    const char *name;
+    int (*fn)(void);                /* Returns 0 on success */
+    initcall_level_t level;
+    uint8_t flags;
+    const char *depends_on[INITCALL_MAX_DEPENDENCIES];
+} initcall_t;
+
+/* Initcall Functions */
+int initcall_register(const initcall_t *calls, uint32_t count);
+void initcall_set_headless(bool headless);
+bool initcall_is_headless(void);
+int initcall_run_level(initcall_level_t level);
+int initcall_require(const char *name);
+bool initcall_is_done(const char *name);
+bool initcall_poll_deferred(void);
+void initcall_print_status(void);
+
+#endif /* KERNEL_INITCALL_H */
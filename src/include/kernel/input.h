@@ -8,6 +8,10 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+/* Event Ring Configuration */
+#define INPUT_RING_SIZE     256         /* Power of two */
+#define INPUT_RING_MASK     (INPUT_RING_SIZE - 1)
+
 /* Input Device Types */
 typedef enum {
     INPUT_DEVICE_KEYBOARD,
@@ -59,6 +63,7 @@ typedef enum {
 typedef struct {
     input_event_type_t type;
     uint32_t timestamp;
+    uint64_t tsc;            /* rdtsc() in the IRQ handler, latency origin */
     
     union {
         /* Keyboard Events */
@@ -89,12 +94,47 @@ typedef struct {
 /* Input Event Handler Function */
 typedef void (*input_event_handler_t)(input_event_t *event);
 
+/* Event Ring Slot - seq is odd while the producer merges motion into it */
+typedef struct {
+    input_event_t event;
+    volatile uint32_t seq;
+} input_ring_slot_t;
+
+/* Per-Device Event Ring
+ * Single producer (the device's IRQ handler) and single consumer
+ * (input_process_events). head is written only by the producer, tail only
+ * by the consumer; counters are owned by the side that updates them.
+ */
+typedef struct {
+    input_ring_slot_t slots[INPUT_RING_SIZE];
+    volatile uint32_t head;
+    volatile uint32_t tail;
+    
+    /* Producer counters */
+    uint64_t queued;
+    uint64_t dropped;               /* Ring full, event discarded */
+    uint64_t coalesced;             /* Motion merged into a pending move */
+    
+    /* Consumer counters */
+    uint64_t delivered;
+} input_ring_t;
+
+/* Input Ring Statistics (all devices) */
+typedef struct {
+    uint64_t queued;
+    uint64_t delivered;
+    uint64_t dropped;
+    uint64_t coalesced;
+    uint32_t pending;
+} input_stats_t;
+
 /* Input Device Structure */
 typedef struct input_device {
     input_device_type_t type;
     char name[64];
     bool connected;
     void *device_data;
+    input_ring_t *ring;             /* Allocated at registration */
     
     /* Device-specific functions */
     int (*init)(struct input_device *device);
@@ -145,11 +185,13 @@ typedef struct {
     keyboard_state_t keyboard;
     touch_state_t touch;
     
-    /* Event Queue */
-    input_event_t event_queue[256];
-    uint32_t queue_head;
-    uint32_t queue_tail;
-    uint32_t queue_count;
+    /* Event currently being dispatched (rings are drained by copy) */
+    input_event_t current_event;
+    input_device_t *current_device;
+    
+    /* Latency tracing */
+    uint64_t pending_tsc;           /* Oldest event not yet on screen */
+    uint64_t pointer_tsc;           /* Newest pointer event processed */
     
     /* Event Handlers */
     input_event_handler_t handlers[16];
@@ -180,8 +222,12 @@ input_device_t *input_find_device(input_device_type_t type);
 void input_add_event_handler(input_event_handler_t handler);
 void input_remove_event_handler(input_event_handler_t handler);
 void input_queue_event(input_event_t *event);
+int input_device_queue_event(input_device_t *device, const input_event_t *event);
 input_event_t *input_get_next_event(void);
 void input_process_events(void);
+void input_get_stats(input_stats_t *stats);
+uint64_t input_take_pending_tsc(void);
+uint64_t input_get_pointer_tsc(void);
 
 /* Mouse Functions */
 void input_get_mouse_position(int32_t *x, int32_t *y);
@@ -200,8 +246,8 @@ uint32_t input_get_active_touches(void);
 bool input_get_touch_point(uint32_t index, int32_t *x, int32_t *y, float *pressure);
 
 /* Hardware Interrupt Handlers */
-void keyboard_interrupt_handler(void);
-void mouse_interrupt_handler(void);
+int keyboard_interrupt_handler(uint8_t irq, void *data);
+int mouse_interrupt_handler(uint8_t irq, void *data);
 
 /* PS/2 Keyboard Driver */
 int ps2_keyboard_init(void);
@@ -0,0 +1,88 @@
+/* input_dev.h - Brandon Media OS Neural Input Device Nodes
+ * evdev-Style /dev/input/eventN Files Backed by Shared-Memory Rings
+ */
+
+#ifndef KERNEL_INPUT_DEV_H
+#define KERNEL_INPUT_DEV_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "kernel/input.h"
+
+/* Device Node Configuration */
+#define INPUT_DEV_DIR               "/dev/input"
+#define INPUT_DEV_MAX_NODES         8
+#define INPUT_DEV_MAX_CLIENTS       16
+#define INPUT_DEV_RING_SIZE         256         /* Power of two */
+#define INPUT_DEV_RING_MASK         (INPUT_DEV_RING_SIZE - 1)
+#define INPUT_DEV_USER_BASE         0x0000710000000000ULL   /* Client mapping window */
+#define INPUT_DEV_USER_SPAN         0x0000000000010000ULL   /* 64KB per client slot */
+#define INPUT_DEV_MAGIC             0x45564E54  /* 'EVNT' */
+
+/* ioctl Commands */
+#define INPUT_IOCTL_MAP_RING        0x4901      /* Returns the reader's ring address */
+#define INPUT_IOCTL_GET_INFO        0x4902      /* arg: input_dev_info_t * */
+#define INPUT_IOCTL_WAIT            0x4903      /* arg: timeout ms; 1 = ready, 0 = timed out */
+
+/* Modifier Bits (key events, value field) */
+#define INPUT_DEV_MOD_CTRL          0x01
+#define INPUT_DEV_MOD_ALT           0x02
+#define INPUT_DEV_MOD_SHIFT         0x04
+
+/* Wire Event - fixed-size mirror of input_event_t.
+ * Layout is ABI: userland mirrors it in neural_app.h.
+ */
+typedef struct {
+    uint64_t tsc;                   /* IRQ timestamp */
+    uint32_t timestamp;             /* Milliseconds */
+    uint16_t type;                  /* input_event_type_t */
+    uint16_t code;                  /* Key code, mouse button or touch id */
+    int32_t value;                  /* Modifiers, wheel delta or pressure x1000 */
+    int32_t x, y;
+    int32_t dx, dy;
+    uint32_t reserved;
+} input_dev_event_t;
+
+/* Shared Ring - mapped read/write into the reader.
+ * Single producer (kernel, head) / single consumer (reader, tail).
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t device_type;           /* input_device_type_t */
+    uint32_t ring_size;
+    uint32_t event_size;
+    
+    volatile uint32_t head;         /* Written by kernel */
+    volatile uint32_t tail;         /* Written by reader */
+    volatile uint32_t dropped;      /* Kernel counts events lost to a full ring */
+    volatile uint32_t waiting;      /* Reader sets before sleeping in INPUT_IOCTL_WAIT */
+    
+    char name[32];
+    input_dev_event_t events[INPUT_DEV_RING_SIZE];
+} input_dev_shared_t;
+
+/* Device Info (INPUT_IOCTL_GET_INFO) */
+typedef struct {
+    uint32_t index;                 /* N in /dev/input/eventN */
+    uint32_t type;                  /* input_device_type_t */
+    char name[32];
+} input_dev_info_t;
+
+/* Device Node Statistics */
+typedef struct {
+    uint32_t nodes;
+    uint32_t clients;
+    uint64_t published;
+    uint64_t dropped;
+    uint64_t wakeups;
+} input_dev_stats_t;
+
+/* Device Node Functions */
+int input_dev_init(void);
+void input_dev_shutdown(void);
+int input_dev_attach(input_device_t *device);
+void input_dev_publish(input_device_t *device, const input_event_t *event);
+void input_dev_release_process(uint32_t owner_pid);
+void input_dev_get_stats(input_dev_stats_t *stats);
+
+#endif /* KERNEL_INPUT_DEV_H */
@@ -26,6 +26,15 @@ struct idt_ptr {
 #define IRQ_KEYBOARD     33  /* Keyboard */
 #define IRQ_SERIAL       36  /* Serial COM1 */
 
+/* Legacy IRQ lines (vectors 32-47) and the local APIC spurious vector */
+#define IRQ_LEGACY_COUNT         16
+#define IRQ_SPURIOUS_VECTOR      0xFF
+
+/* Dynamically allocated vectors (MSI/MSI-X), below the IPI range */
+#define IRQ_VECTOR_DYNAMIC_BASE  48
+#define IRQ_VECTOR_DYNAMIC_END   0xF0
+#define IRQ_VECTOR_STUB_SIZE     16
+
 /* Interrupt attribute flags */
 #define IDT_PRESENT      0x80
 #define IDT_INTERRUPT    0x0E
@@ -39,6 +48,65 @@ void idt_set_gate(uint8_t num, uint64_t handler, uint16_t sel, uint8_t flags);
 void interrupts_enable(void);
 void interrupts_disable(void);
 
+/* Legacy IRQ control - I/O APIC when available, else the 8259 */
+void pic_init(void);
+void pic_disable(void);
+void irq_enable(uint8_t irq);
+int irq_set_affinity(uint8_t irq, uint8_t cpu_id);
+
+/* Dynamic vector allocation - handlers run with the local APIC EOI'd after */
+typedef void (*irq_vector_handler_t)(uint8_t vector, void *data);
+int irq_vector_alloc(uint32_t count, irq_vector_handler_t handler, void *data, uint8_t cpu_id);
+void irq_vector_free(uint8_t vector, uint32_t count);
+uint8_t irq_vector_get_cpu(uint8_t vector);
+
+/* Legacy IRQ handlers - chained on shared lines; each returns IRQ_HANDLED
+ * if its device raised the interrupt, IRQ_NONE otherwise
+ */
+#define IRQ_NONE                 0
+#define IRQ_HANDLED              1
+#define IRQ_MAX_ACTIONS          32
+
+typedef int (*irq_handler_t)(uint8_t irq, void *data);
+int irq_register_handler(uint8_t irq, irq_handler_t handler, void *data, const char *name);
+int irq_unregister_handler(uint8_t irq, irq_handler_t handler, void *data);
+
+/* Interrupted context, for samplers running inside a handler */
+typedef struct {
+    uint64_t rip;
+    uint64_t rsp;
+    uint64_t rbp;
+    uint64_t cs;
+} irq_context_t;
+
+const irq_context_t *irq_get_context(void);     /* NULL outside an IRQ */
+
+/* Interrupt Statistics - per vector, handler time in log2(TSC cycles) buckets */
+#define IRQ_STATS_MAX_CPUS       8           /* Higher CPUs fold into the last slot */
+#define IRQ_LATENCY_BUCKETS      16
+#define IRQ_LATENCY_MIN_SHIFT    8           /* Bucket 0: < 512 cycles */
+#define IRQ_STORM_THRESHOLD      20000       /* Interrupts per second on one vector */
+
+typedef struct {
+    uint64_t count;
+    uint64_t cpu_count[IRQ_STATS_MAX_CPUS];
+    uint64_t unhandled;             /* No handler claimed it */
+    uint64_t spurious;
+    uint64_t total_cycles;
+    uint64_t max_cycles;
+    uint32_t histogram[IRQ_LATENCY_BUCKETS];
+    uint32_t storms;
+    uint64_t window_start;          /* TSC at the start of the storm window */
+    uint32_t window_count;
+} irq_stats_t;
+
+const irq_stats_t *irq_get_stats(uint8_t vector);
+uint64_t irq_get_cpu_total(uint8_t cpu_id);
+uint64_t irq_get_spurious_total(void);
+void irq_reset_stats(void);
+void irq_print_stats(void);
+int irq_stats_device_init(void);
+
 /* Exception handlers */
 void divide_error_handler(void);
 void debug_handler(void);
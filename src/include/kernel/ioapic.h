@@ -0,0 +1,39 @@
+/* ioapic.h - Brandon Media OS I/O APIC Interrupt Routing
+ * MADT-Described Redirection Tables with Per-IRQ CPU Affinity
+ */
+
+#ifndef KERNEL_IOAPIC_H
+#define KERNEL_IOAPIC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Controller Limits */
+#define IOAPIC_MAX_CONTROLLERS      4
+#define IOAPIC_ISA_IRQS             16
+
+/* Register Window */
+#define IOAPIC_REGSEL               0x00
+#define IOAPIC_WINDOW               0x10
+
+/* Registers */
+#define IOAPIC_REG_ID               0x00
+#define IOAPIC_REG_VERSION          0x01
+#define IOAPIC_REG_REDIRECT         0x10    /* Two dwords per pin */
+
+/* Redirection Entry Bits */
+#define IOAPIC_REDIRECT_POLARITY_LOW    (1U << 13)
+#define IOAPIC_REDIRECT_TRIGGER_LEVEL   (1U << 15)
+#define IOAPIC_REDIRECT_MASKED          (1U << 16)
+#define IOAPIC_REDIRECT_DEST_SHIFT      24  /* In the high dword */
+
+/* I/O APIC Functions */
+int ioapic_init(void);
+bool ioapic_is_enabled(void);
+int ioapic_route_irq(uint8_t irq, uint8_t vector, uint8_t cpu_id);
+int ioapic_set_affinity(uint8_t irq, uint8_t cpu_id);
+void ioapic_mask_irq(uint8_t irq, bool masked);
+uint32_t ioapic_irq_to_gsi(uint8_t irq);
+void ioapic_print_routes(void);
+
+#endif /* KERNEL_IOAPIC_H */
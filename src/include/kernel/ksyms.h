@@ -0,0 +1,24 @@
+/* ksyms.h - Brandon Media OS Kernel Symbol Table
+ * Function Names Embedded at Link Time for Symbolizing Addresses
+ */
+
+#ifndef KERNEL_KSYMS_H
+#define KERNEL_KSYMS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* One text symbol; the table is sorted by address (scripts/gen_ksyms.sh) */
+typedef struct {
+    uint64_t address;
+    const char *name;
+} ksym_t;
+
+/* Symbol Table Functions */
+uint64_t ksyms_count(void);                 /* 0 when linked without the table */
+const ksym_t *ksyms_get(uint64_t index);
+int64_t ksyms_lookup_index(uint64_t address);
+const char *ksyms_lookup(uint64_t address, uint64_t *offset);
+bool ksyms_is_kernel_text(uint64_t address);
+
+#endif /* KERNEL_KSYMS_H */
@@ -0,0 +1,68 @@
+/* msi.h - Brandon Media OS Message Signalled Interrupts
+ * PCI MSI/MSI-X Programming with Per-CPU Vector Targeting
+ */
+
+#ifndef KERNEL_MSI_H
+#define KERNEL_MSI_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "kernel/pci.h"
+#include "kernel/interrupts.h"
+
+/* Message Address - fixed delivery to one local APIC */
+#define MSI_ADDRESS_BASE            0xFEE00000
+#define MSI_ADDRESS_DEST_SHIFT      12
+
+/* MSI Capability Registers */
+#define PCI_MSI_FLAGS               0x02
+#define PCI_MSI_ADDRESS_LO          0x04
+#define PCI_MSI_ADDRESS_HI          0x08
+#define PCI_MSI_DATA_32             0x08
+#define PCI_MSI_DATA_64             0x0C
+#define PCI_MSI_FLAGS_ENABLE        0x0001
+#define PCI_MSI_FLAGS_QMASK         0x000E      /* log2 messages capable */
+#define PCI_MSI_FLAGS_QSIZE         0x0070      /* log2 messages enabled */
+#define PCI_MSI_FLAGS_64BIT         0x0080
+
+/* MSI-X Capability Registers */
+#define PCI_MSIX_FLAGS              0x02
+#define PCI_MSIX_TABLE              0x04
+#define PCI_MSIX_FLAGS_QSIZE        0x07FF      /* Table size - 1 */
+#define PCI_MSIX_FLAGS_MASKALL      0x4000
+#define PCI_MSIX_FLAGS_ENABLE       0x8000
+#define PCI_MSIX_BIR_MASK           0x7
+
+/* MSI-X Table Entry */
+#define PCI_MSIX_ENTRY_SIZE         16
+#define PCI_MSIX_ENTRY_ADDR_LO      0x0
+#define PCI_MSIX_ENTRY_ADDR_HI      0x4
+#define PCI_MSIX_ENTRY_DATA         0x8
+#define PCI_MSIX_ENTRY_CTRL         0xC
+#define PCI_MSIX_ENTRY_CTRL_MASK    0x1
+
+/* Entries tracked per device */
+#define MSIX_MAX_ENTRIES            32
+
+/* MSI-X Device State */
+typedef struct {
+    struct pci_device *pci_dev;
+    volatile uint8_t *table;        /* Mapped vector table */
+    uint16_t table_size;            /* Entries usable (capped at MSIX_MAX_ENTRIES) */
+    uint8_t vectors[MSIX_MAX_ENTRIES];  /* IDT vector per entry, 0 if unassigned */
+} pci_msix_t;
+
+/* MSI-X Functions */
+int pci_msix_init(pci_msix_t *msix, struct pci_device *device);
+int pci_msix_assign(pci_msix_t *msix, uint16_t entry, irq_vector_handler_t handler, void *data, uint8_t cpu_id);
+void pci_msix_mask(pci_msix_t *msix, uint16_t entry, bool masked);
+void pci_msix_release(pci_msix_t *msix);
+
+/* MSI Functions - `count` vectors, all delivered to one CPU */
+int pci_msi_enable(struct pci_device *device, uint32_t count, irq_vector_handler_t handler, void *data, uint8_t cpu_id);
+void pci_msi_disable(struct pci_device *device);
+
+/* CPU for a device queue, spreading queues over online CPUs */
+uint8_t pci_msi_queue_cpu(uint32_t queue);
+
+#endif /* KERNEL_MSI_H */
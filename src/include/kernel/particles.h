@@ -0,0 +1,51 @@
+/* particles.h - Brandon Media OS Neural Particle Engine
+ * Structure-of-Arrays Particle Simulation with Additive Splats
+ */
+
+#ifndef KERNEL_PARTICLES_H
+#define KERNEL_PARTICLES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Engine Limits */
+#define PARTICLE_MAX            4096    /* Must be a multiple of PARTICLE_LANES */
+#define PARTICLE_LANES          4       /* Floats per SIMD vector */
+#define PARTICLE_SPLAT_SIZE     2       /* Splat edge in pixels */
+
+/* SoA Particle Storage - live particles are packed in [0, count) */
+typedef struct {
+    float *x, *y, *z;
+    float *vx, *vy, *vz;
+    float *life;
+    float *inv_max_life;
+    uint32_t *color;
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t rng_state;
+    uint32_t dropped;           /* Spawns rejected because the pool was full */
+    uint32_t budget;            /* Live particle limit (<= capacity) */
+    void *storage;              /* Single backing allocation */
+} particle_pool_t;
+
+/* Particle Engine Function Prototypes */
+int particle_engine_init(uint32_t capacity);
+void particle_engine_shutdown(void);
+bool particle_emit(float x, float y, float z, uint32_t color);
+uint32_t particle_emit_burst(float x, float y, float z, uint32_t count, uint32_t color);
+void particle_engine_update(float delta_time);
+void particle_engine_update_range(uint32_t start, uint32_t end, float delta_time);
+void particle_engine_compact(void);
+void particle_engine_render(void);
+uint32_t particle_engine_count(void);
+void particle_engine_clear(void);
+void particle_engine_set_budget(uint32_t budget);
+void particle_engine_seed(uint32_t seed);
+
+/* Legacy Neural Particle API */
+void neural_particle_system_init(void);
+void neural_spawn_particle(float x, float y, float z, uint32_t color);
+void neural_particle_system_update(float delta_time);
+void neural_particle_system_render(void);
+
+#endif /* KERNEL_PARTICLES_H */
@@ -21,11 +21,72 @@ struct pci_device {
     uint32_t bar[6];
     uint8_t irq_line;
     uint8_t irq_pin;
+    uint8_t secondary_bus;          /* Bus behind a PCI-to-PCI bridge */
+    uint8_t pcie_cap;               /* PCI Express capability offset, 0 if none */
+    uint8_t msi_cap;                /* MSI capability offset, 0 if none */
+    uint8_t msix_cap;               /* MSI-X capability offset, 0 if none */
+    uint64_t dma_mask;              /* Highest bus address the device can reach */
     const char *device_name;
     const char *vendor_name;
     struct pci_device *next;
 };
 
+/* PCI Configuration Registers */
+#define PCI_VENDOR_ID      0x00
+#define PCI_DEVICE_ID      0x02
+#define PCI_COMMAND        0x04
+#define PCI_STATUS         0x06
+#define PCI_REVISION_ID    0x08
+#define PCI_PROG_IF        0x09
+#define PCI_SUBCLASS       0x0A
+#define PCI_CLASS          0x0B
+#define PCI_CACHE_LINE     0x0C
+#define PCI_LATENCY_TIMER  0x0D
+#define PCI_HEADER_TYPE    0x0E
+#define PCI_BIST           0x0F
+#define PCI_BAR0           0x10
+#define PCI_BAR1           0x14
+#define PCI_BAR2           0x18
+#define PCI_BAR3           0x1C
+#define PCI_BAR4           0x20
+#define PCI_BAR5           0x24
+#define PCI_PRIMARY_BUS    0x18     /* Type 1 (bridge) header */
+#define PCI_SECONDARY_BUS  0x19
+#define PCI_SUBORDINATE_BUS 0x1A
+#define PCI_CAPABILITY_LIST 0x34
+#define PCI_CAPABILITY_LIST_CARDBUS 0x14
+#define PCI_INTERRUPT_LINE 0x3C
+#define PCI_INTERRUPT_PIN  0x3D
+
+/* Configuration Space Sizes */
+#define PCI_CONFIG_SPACE_SIZE     256
+#define PCI_EXT_CONFIG_SPACE_SIZE 4096
+
+/* Header Types */
+#define PCI_HEADER_TYPE_MASK          0x7F
+#define PCI_HEADER_TYPE_NORMAL        0x00
+#define PCI_HEADER_TYPE_BRIDGE        0x01
+#define PCI_HEADER_TYPE_CARDBUS       0x02
+#define PCI_HEADER_TYPE_MULTIFUNCTION 0x80
+
+/* Command and Status Bits */
+#define PCI_COMMAND_IO             0x0001
+#define PCI_COMMAND_MEMORY         0x0002
+#define PCI_COMMAND_MASTER         0x0004
+#define PCI_COMMAND_INTX_DISABLE   0x0400
+#define PCI_STATUS_CAP_LIST        0x0010
+
+/* Capability IDs */
+#define PCI_CAP_ID_PM      0x01
+#define PCI_CAP_ID_MSI     0x05
+#define PCI_CAP_ID_VNDR    0x09
+#define PCI_CAP_ID_EXP     0x10
+#define PCI_CAP_ID_MSIX    0x11
+
+/* Extended Capability IDs */
+#define PCI_EXT_CAP_ID_AER 0x0001
+#define PCI_EXT_CAP_ID_SRIOV 0x0010
+
 /* PCI Function Prototypes */
 void pci_init(void);
 void pci_enumerate_devices(void);
@@ -37,6 +98,19 @@ void pci_print_all_devices(void);
 int pci_get_device_count(void);
 struct pci_device *pci_get_device_by_index(int index);
 
+/* Configuration Space Access - ECAM when ACPI MCFG is present, else port I/O */
+uint32_t pci_config_read_dword(uint8_t bus, uint8_t device, uint8_t function, uint16_t offset);
+uint16_t pci_config_read_word(uint8_t bus, uint8_t device, uint8_t function, uint16_t offset);
+uint8_t pci_config_read_byte(uint8_t bus, uint8_t device, uint8_t function, uint16_t offset);
+void pci_config_write_dword(uint8_t bus, uint8_t device, uint8_t function, uint16_t offset, uint32_t value);
+void pci_config_write_word(uint8_t bus, uint8_t device, uint8_t function, uint16_t offset, uint16_t value);
+int pci_has_extended_config(struct pci_device *device);
+uint64_t pci_get_bar_address(struct pci_device *device, uint8_t bar_num);
+
+/* Capability Lists */
+uint8_t pci_find_capability(struct pci_device *device, uint8_t cap_id);
+uint16_t pci_find_ext_capability(struct pci_device *device, uint16_t cap_id);
+
 /* PCI Device Classes */
 #define PCI_CLASS_NETWORK  0x02
 #define PCI_CLASS_DISPLAY  0x03
@@ -0,0 +1,85 @@
+/* perf.h - Brandon Media OS Neural Frame Profiler
+ * TSC-Based Frame Timing, Stage Breakdown and Performance Overlay
+ */
+
+#ifndef KERNEL_PERF_H
+#define KERNEL_PERF_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Profiler Configuration */
+#define PERF_WINDOW_FRAMES      256     /* Rolling window for percentiles */
+#define PERF_FRAME_BUDGET_US    16667   /* 60 FPS frame budget */
+#define PERF_HIST_BUCKETS       24      /* log2(us) buckets: 1us .. ~8s */
+#define PERF_DUMP_INTERVAL      300     /* Headless serial dump period (frames) */
+
+/* Frame Pipeline Stages */
+typedef enum {
+    PERF_STAGE_UPDATE = 0,    /* Input + GUI update + simulation */
+    PERF_STAGE_EFFECTS,       /* Background effects (matrix, scanlines) */
+    PERF_STAGE_WIDGETS,       /* Layer and widget rendering */
+    PERF_STAGE_3D,            /* 3D renderer clear..present */
+    PERF_STAGE_PRESENT,       /* Buffer swap / present */
+    PERF_STAGE_COUNT
+} perf_stage_t;
+
+/* Input Latency Stages - all measured from the IRQ that read the input */
+typedef enum {
+    PERF_LATENCY_QUEUE = 0,   /* Dequeued by input_process_events() */
+    PERF_LATENCY_DISPATCH,    /* Event handlers returned */
+    PERF_LATENCY_WIDGET,      /* Widget click callback returned */
+    PERF_LATENCY_PHOTON,      /* Frame showing the result presented */
+    PERF_LATENCY_COUNT
+} perf_latency_stage_t;
+
+/* Log2 Latency Histogram (microseconds) */
+typedef struct {
+    uint32_t buckets[PERF_HIST_BUCKETS];
+    uint64_t count;
+    uint64_t sum_us;
+    uint32_t max_us;
+} perf_histogram_t;
+
+/* Per-Stage Summary */
+typedef struct {
+    uint32_t last_us;
+    uint32_t p50_us;
+    uint32_t p95_us;
+    uint32_t p99_us;
+    uint32_t max_us;
+} perf_stage_stats_t;
+
+/* Profiler Function Prototypes */
+int perf_init(void);
+void perf_frame_begin(void);
+void perf_frame_end(void);
+void perf_stage_begin(perf_stage_t stage);
+void perf_stage_end(perf_stage_t stage);
+void perf_get_stage_stats(perf_stage_t stage, perf_stage_stats_t *stats);
+void perf_get_frame_stats(perf_stage_stats_t *stats);
+const char *perf_stage_name(perf_stage_t stage);
+void perf_reset(void);
+
+/* Overlay and Headless Output */
+void perf_overlay_enable(bool enable);
+void perf_overlay_toggle(void);
+bool perf_overlay_enabled(void);
+void perf_overlay_render(void);
+void perf_set_headless(bool headless);
+void perf_dump_serial(void);
+
+/* Input Latency Tracing */
+void perf_latency_record(perf_latency_stage_t stage, uint64_t start_tsc);
+void perf_latency_get(perf_latency_stage_t stage, perf_histogram_t *hist);
+const char *perf_latency_name(perf_latency_stage_t stage);
+void perf_latency_reset(void);
+void perf_latency_dump(void);
+
+/* Histogram Helpers */
+void perf_hist_reset(perf_histogram_t *hist);
+void perf_hist_add(perf_histogram_t *hist, uint32_t value_us);
+uint32_t perf_hist_percentile(const perf_histogram_t *hist, uint32_t percent);
+void perf_hist_print(const char *tag, const perf_histogram_t *hist);
+
+#endif /* KERNEL_PERF_H */
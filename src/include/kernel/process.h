@@ -4,6 +4,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 #include "kernel/memory.h"
 
 /* Brandon Media OS - Neural Process Matrix Definitions */
@@ -129,6 +130,8 @@ void process_destroy(struct process *proc);
 struct process *process_get_current(void);
 struct process *process_get_by_pid(uint32_t pid);
 void process_sleep(uint32_t milliseconds);
+void process_prepare_sleep(uint32_t milliseconds);
+void process_cancel_sleep(void);
 void process_wake(struct process *proc);
 
 /* Scheduling */
@@ -139,6 +142,7 @@ void scheduler_yield(void);
 void scheduler_preempt(void);
 struct process *scheduler_next(void);
 void scheduler_tick(void);
+bool scheduler_userland_started(void);
 
 /* Context switching */
 void context_switch(struct process *from, struct process *to);
@@ -175,6 +179,7 @@ void signal_handle(struct process *proc, uint32_t signal);
 #define PROCESS_HEAP_SIZE   (64 * 1024)    /* 64KB default heap */
 #define MAX_PROCESSES       256             /* Maximum processes */
 #define DEFAULT_TIME_SLICE  10              /* 10ms time slice */
+#define USER_CODE_SELECTOR  0x1B            /* Ring 3 code segment */
 
 /* Scheduler algorithms */
 typedef enum {
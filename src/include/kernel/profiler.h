@@ -0,0 +1,58 @@
+/* profiler.h - Brandon Media OS Sampling Profiler
+ * Periodic Interrupted-RIP Samples with Frame-Pointer Call Stacks
+ */
+
+#ifndef KERNEL_PROFILER_H
+#define KERNEL_PROFILER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/* Profiler Configuration */
+#define PROFILER_MAX_CPUS           8           /* Higher CPUs fold into the last buffer */
+#define PROFILER_SAMPLES_PER_CPU    4096        /* Ring per CPU; oldest overwritten */
+#define PROFILER_MAX_DEPTH          16          /* Interrupted RIP plus callers */
+#define PROFILER_DEFAULT_HZ         1024
+#define PROFILER_MIN_HZ             2           /* RTC periodic rates: 2..8192Hz, powers of two */
+#define PROFILER_MAX_HZ             8192
+#define PROFILER_STACK_WINDOW       (64 * 1024) /* Frame pointers must stay this close to RSP */
+#define PROFILER_REPORT_TOP         32
+#define PROFILER_MAX_STACKS         512         /* Distinct stacks in folded output */
+
+/* /dev/profile - read returns the report in the selected format */
+#define PROFILER_DEVICE_DIR         "/dev"
+#define PROFILER_DEVICE_NAME        "profile"
+#define PROFILER_IOCTL_START        0x5001      /* arg: rate in Hz, 0 = default */
+#define PROFILER_IOCTL_STOP         0x5002
+#define PROFILER_IOCTL_RESET        0x5003
+#define PROFILER_IOCTL_FORMAT       0x5004      /* arg: profiler_format_t */
+
+/* Report Formats */
+typedef enum {
+    PROFILER_FORMAT_FLAT = 0,       /* Samples per function, then per process */
+    PROFILER_FORMAT_GRAPH,          /* Inclusive/self time with callers */
+    PROFILER_FORMAT_FOLDED          /* "outer;inner;leaf count" for flame graphs */
+} profiler_format_t;
+
+/* One Sample */
+typedef struct {
+    uint64_t pc[PROFILER_MAX_DEPTH];    /* pc[0] = interrupted RIP, then return addresses */
+    uint32_t pid;
+    uint8_t cpu;
+    uint8_t depth;
+    bool user;                          /* Interrupted ring 3; no stack walk */
+} profiler_sample_t;
+
+/* Profiler Functions */
+int profiler_init(void);
+int profiler_start(uint32_t hz);
+void profiler_stop(void);
+void profiler_reset(void);
+bool profiler_is_running(void);
+uint32_t profiler_get_rate(void);
+uint64_t profiler_sample_count(void);
+size_t profiler_format(profiler_format_t format, char *text, size_t size);
+void profiler_print(profiler_format_t format);
+
+#endif /* KERNEL_PROFILER_H */
@@ -0,0 +1,52 @@
+/* quality.h - Brandon Media OS Neural Quality Governor
+ * Frame-Budget Driven Rendering Detail Levels
+ */
+
+#ifndef KERNEL_QUALITY_H
+#define KERNEL_QUALITY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Governor Configuration */
+#define QUALITY_LEVELS              6       /* 0 = full detail .. 5 = minimal */
+#define QUALITY_EWMA_SHIFT          3       /* Frame time smoothing, alpha = 1/8 */
+#define QUALITY_SHED_FRAMES         8       /* Over-budget frames before shedding */
+#define QUALITY_RESTORE_FRAMES      120     /* Frames with headroom before restoring */
+#define QUALITY_HEADROOM_PERCENT    60      /* Headroom means below this share of budget */
+#define QUALITY_SETTLE_FRAMES       30      /* Samples ignored after a level change */
+
+/* One Rendering Detail Level */
+typedef struct {
+    const char *name;
+    uint32_t particle_budget;       /* Live particle cap */
+    uint32_t effect_detail_shift;   /* Background glyph spacing = base << shift */
+    bool scanlines;
+    float parallax_strength;        /* 1.0 = full depth, 0.0 = flat */
+    uint32_t animation_divisor;     /* Advance animations every Nth update */
+} quality_level_t;
+
+/* Governor Statistics */
+typedef struct {
+    bool enabled;
+    uint32_t level;
+    uint32_t budget_us;
+    uint32_t average_us;            /* Smoothed frame time */
+    uint64_t frames;
+    uint64_t sheds;
+    uint64_t restores;
+} quality_stats_t;
+
+/* Governor Functions */
+int quality_governor_init(uint32_t budget_us);
+void quality_governor_enable(bool enable);
+void quality_governor_submit(uint32_t frame_us);
+void quality_governor_set_budget(uint32_t budget_us);
+
+/* Manual Control (takes effect immediately, governor keeps running if enabled) */
+int quality_set_level(uint32_t level);
+uint32_t quality_get_level(void);
+const quality_level_t *quality_get_level_info(uint32_t level);
+void quality_get_stats(quality_stats_t *stats);
+
+#endif /* KERNEL_QUALITY_H */
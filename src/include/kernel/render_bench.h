@@ -0,0 +1,47 @@
+/* render_bench.h - Brandon Media OS Neural Render Benchmark
+ * Deterministic Headless Scenes with Frame Timing and Checksums
+ */
+
+#ifndef KERNEL_RENDER_BENCH_H
+#define KERNEL_RENDER_BENCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "kernel/perf.h"
+
+/* Benchmark Configuration */
+#define RENDER_BENCH_WIDTH          640     /* Fixed so checksums don't depend on the display */
+#define RENDER_BENCH_HEIGHT         480
+#define RENDER_BENCH_FRAME_MS       16      /* Simulated time per frame */
+#define RENDER_BENCH_DEFAULT_FRAMES 120
+#define RENDER_BENCH_SEED           0x1BADB002
+
+/* Benchmark Scenes */
+typedef enum {
+    RENDER_BENCH_SCADA = 0,         /* Gauges, progress bars and panels */
+    RENDER_BENCH_NEURAL_GRID,       /* Rotating 3D neural grid over the matrix effect */
+    RENDER_BENCH_PARTICLE_STORM,    /* Particle bursts at full budget */
+    RENDER_BENCH_TEXT_PANELS,       /* Dense text over panels */
+    RENDER_BENCH_SCENE_COUNT
+} render_bench_scene_t;
+
+/* Scene Result */
+typedef struct {
+    const char *name;
+    uint32_t frames;
+    bool skipped;                   /* Subsystem the scene needs is missing */
+    perf_histogram_t timing;        /* Per-frame render time */
+    uint32_t min_us;
+    uint32_t max_us;
+    uint32_t last_checksum;         /* Final frame */
+    uint32_t checksum;              /* Folded over every frame */
+} render_bench_result_t;
+
+/* Benchmark Functions */
+int render_bench_run(render_bench_scene_t scene, uint32_t frames, bool per_frame,
+                     render_bench_result_t *result);
+int render_bench_run_all(uint32_t frames, bool per_frame);
+const char *render_bench_scene_name(render_bench_scene_t scene);
+uint32_t render_bench_checksum(const uint32_t *pixels, uint32_t count);
+
+#endif /* KERNEL_RENDER_BENCH_H */
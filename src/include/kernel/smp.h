@@ -28,6 +28,7 @@ struct neural_cpu {
     uint32_t interrupts_handled;
     const char *neural_designation;
     int online;
+    int running;                    /* Executing kernel code; safe interrupt target */
 } __attribute__((aligned(64)));
 
 /* SMP Function Prototypes */
@@ -42,6 +43,10 @@ void smp_get_statistics(uint32_t *total_cores, uint32_t *active_cores, uint64_t
 int smp_is_available(void);
 uint32_t smp_get_cpu_count(void);
 uint32_t smp_get_active_cpu_count(void);
+uint32_t smp_get_running_cpu_count(void);
+int smp_cpu_is_running(uint8_t cpu_id);
+uint32_t smp_get_apic_id(uint8_t cpu_id);
+void smp_apic_eoi(void);
 
 /* IPI Vectors */
 #define IPI_VECTOR_RESCHEDULE   0xF0
@@ -41,8 +41,12 @@
 #define SYS_CONNECT         30  /* Connect to remote */
 #define SYS_SEND            31  /* Send network data */
 #define SYS_RECV            32  /* Receive network data */
+#define SYS_SURFACE_CREATE  33  /* Map a shared compositor surface */
+#define SYS_SURFACE_COMMIT  34  /* Submit queued damage for a surface */
+#define SYS_SURFACE_DESTROY 35  /* Unmap and release a surface */
+#define SYS_SURFACE_CONFIGURE 36  /* Position and stack a surface */
 
-#define MAX_SYSCALL_NUM     32
+#define MAX_SYSCALL_NUM     36
 
 /* System call error codes */
 #define ESUCCESS            0   /* Neural operation successful */
@@ -181,6 +185,11 @@ int64_t sys_mmap(void *addr, size_t length, int32_t prot, int32_t flags, int32_t
 int64_t sys_munmap(void *addr, size_t length);
 int64_t sys_brk(void *addr);
 int64_t sys_pipe(int32_t pipefd[2]);
+int64_t sys_ioctl(int32_t fd, uint32_t cmd, void *arg);
+int64_t sys_surface_create(uint32_t width, uint32_t height, uint32_t flags);
+int64_t sys_surface_commit(uint32_t id);
+int64_t sys_surface_destroy(uint32_t id);
+int64_t sys_surface_configure(uint32_t id, int32_t x, int32_t y, int32_t z);
 
 /* User mode support */
 void enter_user_mode(uint64_t entry_point, uint64_t stack_pointer);
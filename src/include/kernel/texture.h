@@ -0,0 +1,77 @@
+/* texture.h - Brandon Media OS Neural Texture Engine
+ * Morton-Tiled Mipmapped Textures with Fixed-Point Sampling
+ */
+
+#ifndef KERNEL_TEXTURE_H
+#define KERNEL_TEXTURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Texture Configuration */
+#define TEXTURE_MAX_SIZE        2048
+#define TEXTURE_MAX_LEVELS      12          /* 2048 .. 1 */
+#define TEXTURE_TILE_SHIFT      3           /* 8x8 texel tiles (256 bytes) */
+#define TEXTURE_TILE_SIZE       (1 << TEXTURE_TILE_SHIFT)
+#define TEXTURE_TILE_TEXELS     (TEXTURE_TILE_SIZE * TEXTURE_TILE_SIZE)
+#define TEXTURE_CACHE_ENTRIES   32          /* Tiles per rasterizer thread (8KB) */
+#define TEXTURE_CACHE_THREADS   8
+#define TEXTURE_FIXED_SHIFT     16          /* Texel coordinates are 16.16 */
+#define TEXTURE_FIXED_ONE       (1 << TEXTURE_FIXED_SHIFT)
+
+/* Sampling Filters */
+typedef enum {
+    TEXTURE_FILTER_NEAREST = 0,
+    TEXTURE_FILTER_BILINEAR
+} texture_filter_t;
+
+/* Texture Object - each level stored as row-major 8x8 tiles, Morton order inside */
+typedef struct texture {
+    uint32_t id;
+    uint32_t width;                 /* Power of two */
+    uint32_t height;                /* Power of two */
+    uint32_t levels;
+    uint32_t *storage;              /* Single allocation for all levels */
+    uint32_t *level_data[TEXTURE_MAX_LEVELS];
+    uint32_t level_width[TEXTURE_MAX_LEVELS];
+    uint32_t level_height[TEXTURE_MAX_LEVELS];
+    uint32_t level_tiles_x[TEXTURE_MAX_LEVELS];
+} texture_t;
+
+/* Cached Tile */
+typedef struct {
+    const texture_t *texture;
+    uint32_t level;
+    uint32_t tile;
+    uint32_t texels[TEXTURE_TILE_TEXELS];
+} __attribute__((aligned(64))) texture_cache_entry_t;
+
+/* Per-Thread Tile Cache */
+typedef struct {
+    texture_cache_entry_t entries[TEXTURE_CACHE_ENTRIES];
+    uint64_t hits;
+    uint64_t misses;
+} texture_cache_t;
+
+/* Texture Management */
+texture_t *texture_create(uint32_t width, uint32_t height);
+void texture_destroy(texture_t *texture);
+int texture_upload(texture_t *texture, const uint32_t *pixels, uint32_t pitch_pixels);
+void texture_generate_mipmaps(texture_t *texture);
+
+/* Sampling (s, t in level-0 texels, 16.16 fixed point; coordinates wrap) */
+texture_cache_t *texture_cache_get(void);
+uint32_t texture_fetch(texture_cache_t *cache, const texture_t *texture, uint32_t level, int32_t x, int32_t y);
+uint32_t texture_sample(texture_cache_t *cache, const texture_t *texture, uint32_t level,
+                        int32_t s, int32_t t, texture_filter_t filter);
+void texture_sample_span(texture_cache_t *cache, const texture_t *texture, uint32_t level,
+                         int32_t s, int32_t t, int32_t ds, int32_t dt,
+                         uint32_t count, texture_filter_t filter, uint32_t *out);
+uint32_t texture_select_level(const texture_t *texture, int32_t ds, int32_t dt);
+
+/* Drawing */
+void texture_draw_panel(const texture_t *texture, int32_t x, int32_t y,
+                        uint32_t width, uint32_t height, texture_filter_t filter);
+void texture_get_cache_stats(uint64_t *hits, uint64_t *misses);
+
+#endif /* KERNEL_TEXTURE_H */
@@ -0,0 +1,24 @@
+/* tsc.h - Brandon Media OS Time Stamp Counter Interface
+ * High-Resolution Neural Timing Source
+ */
+
+#ifndef KERNEL_TSC_H
+#define KERNEL_TSC_H
+
+#include <stdint.h>
+
+/* Read the CPU time stamp counter */
+static inline uint64_t rdtsc(void) {
+    uint32_t low, high;
+    asm volatile ("rdtsc" : "=a"(low), "=d"(high));
+    return ((uint64_t)high << 32) | low;
+}
+
+/* TSC Function Prototypes */
+void tsc_calibrate(void);
+uint64_t tsc_get_frequency(void);       /* Ticks per second */
+uint64_t tsc_cycles_to_us(uint64_t cycles);
+uint64_t tsc_cycles_to_ns(uint64_t cycles);
+uint64_t tsc_get_us(void);              /* Microseconds since calibration */
+
+#endif /* KERNEL_TSC_H */
@@ -0,0 +1,53 @@
+/* uart.h - Brandon Media OS 16550 UART Console
+ * Interrupt-Driven Serial Output with Transmit and Receive Rings
+ */
+
+#ifndef KERNEL_UART_H
+#define KERNEL_UART_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/* COM1 */
+#define UART_COM1_BASE              0x3F8
+#define UART_COM1_IRQ               4
+#define UART_CLOCK_HZ               115200      /* Divisor 1 */
+
+/* Console baud rate; override with -DUART_BAUD=<rate> */
+#ifndef UART_BAUD
+#define UART_BAUD                   115200
+#endif
+
+/* Ring sizes (powers of two) */
+#define UART_TX_BUFFER_SIZE         16384
+#define UART_RX_BUFFER_SIZE         1024
+
+/* UART Statistics */
+typedef struct {
+    uint64_t tx_bytes;
+    uint64_t rx_bytes;
+    uint64_t tx_stalls;             /* Ring full, drained by polling */
+    uint64_t rx_dropped;            /* Input ring full */
+    uint64_t line_errors;           /* Overrun, parity, framing, break */
+    uint64_t interrupts;
+    uint32_t tx_high_water;         /* Most bytes queued at once */
+} uart_stats_t;
+
+/* UART Functions */
+int uart_init(uint32_t baud);
+int uart_set_baud(uint32_t baud);
+size_t uart_write(const char *data, size_t length);
+size_t uart_read(char *buffer, size_t length);
+void uart_flush(void);
+void uart_panic(void);
+bool uart_is_buffered(void);
+uint32_t uart_fifo_size(void);
+void uart_get_stats(uart_stats_t *stats);
+void uart_print_stats(void);
+
+/* Console output; polled until uart_init() and after uart_panic() */
+void serial_putc(char c);
+void serial_puts(const char *s);
+
+#endif /* KERNEL_UART_H */
@@ -12,6 +12,11 @@
 #define STDOUT_FILENO   1
 #define STDERR_FILENO   2
 
+/* File access modes */
+#define O_RDONLY        0x0000
+#define O_WRONLY        0x0001
+#define O_RDWR          0x0002
+
 /* System call error codes */
 extern int errno;
 
@@ -33,6 +38,7 @@ int32_t close(int fd);
 ssize_t read(int fd, void *buf, size_t count);
 ssize_t write(int fd, const void *buf, size_t count);
 off_t lseek(int fd, off_t offset, int whence);
+int64_t ioctl(int fd, uint32_t cmd, void *arg);
 
 /* Memory management */
 void *mmap(void *addr, size_t length, int prot, int flags, int fd, off_t offset);
@@ -40,6 +46,12 @@ int munmap(void *addr, size_t length);
 void *sbrk(intptr_t increment);
 void *brk(void *addr);
 
+/* Compositor surfaces */
+void *surface_create(uint32_t width, uint32_t height, uint32_t flags);
+int32_t surface_commit(uint32_t id);
+int32_t surface_destroy(uint32_t id);
+int32_t surface_configure(uint32_t id, int32_t x, int32_t y, int32_t z);
+
 /* String functions */
 size_t strlen(const char *s);
 char *strcpy(char *dest, const char *src);
@@ -0,0 +1,267 @@
+/* boot_profile.c - Brandon Media OS Boot-Phase Profiler
+ * Timestamps Init Steps with the TSC and Reports Where Boot Time Goes
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "kernel/boot_profile.h"
+#include "kernel/tsc.h"
+#include "kernel/memory.h"
+#include "kernel/fs.h"
+
+/* Trace output buffer, enough for every span as one JSON event */
+#define BOOT_PROFILE_TRACE_SIZE     (BOOT_PROFILE_MAX_SPANS * 128 + 64)
+#define BOOT_PROFILE_NAME_MAX       48
+
+/* External functions */
+extern void serial_puts(const char *s);
+extern void print_dec(uint64_t num);
+extern int snprintf(char *str, size_t size, const char *format, ...);
+
+/* Boot Profiler State */
+typedef struct {
+    boot_span_t spans[BOOT_PROFILE_MAX_SPANS];
+    uint32_t span_count;
+    int16_t stack[BOOT_PROFILE_MAX_DEPTH];
+    uint32_t depth;
+    uint64_t start_tsc;             /* kmain entry */
+    uint64_t end_tsc;               /* Late initcalls done */
+    uint32_t dropped;
+} boot_profile_state_t;
+
+static boot_profile_state_t boot_profile;
+static bool boot_profile_active = false;
+
+/* Mark kmain entry; the TSC has been counting since reset */
+void boot_profile_start(void) {
+    boot_profile.span_count = 0;
+    boot_profile.depth = 0;
+    boot_profile.dropped = 0;
+    boot_profile.end_tsc = 0;
+    boot_profile.start_tsc = rdtsc();
+    boot_profile_active = true;
+}
+
+/* Open a span nested under the current one; returns its index or -1 */
+int boot_profile_begin(const char *name) {
+    if (!boot_profile_active) {
+        return -1;
+    }
+    
+    /* Dropped spans still nest so begin/end stay balanced */
+    if (boot_profile.depth >= BOOT_PROFILE_MAX_DEPTH) {
+        boot_profile.dropped++;
+        boot_profile.depth++;
+        return -1;
+    }
+    if (boot_profile.span_count >= BOOT_PROFILE_MAX_SPANS) {
+        boot_profile.dropped++;
+        boot_profile.stack[boot_profile.depth++] = -1;
+        return -1;
+    }
+    
+    int16_t index = (int16_t)boot_profile.span_count++;
+    boot_span_t *span = &boot_profile.spans[index];
+    span->name = name;
+    span->depth = (uint8_t)boot_profile.depth;
+    span->parent = boot_profile.depth ? boot_profile.stack[boot_profile.depth - 1] : -1;
+    span->end_tsc = 0;
+    
+    boot_profile.stack[boot_profile.depth++] = index;
+    span->start_tsc = rdtsc();
+    return index;
+}
+
+void boot_profile_end(void) {
+    uint64_t now = rdtsc();
+    
+    if (!boot_profile_active || boot_profile.depth == 0) {
+        return;
+    }
+    
+    boot_profile.depth--;
+    if (boot_profile.depth < BOOT_PROFILE_MAX_DEPTH) {
+        int16_t index = boot_profile.stack[boot_profile.depth];
+        if (index >= 0 && boot_profile.spans[index].end_tsc == 0) {
+            boot_profile.spans[index].end_tsc = now;
+        }
+    }
+}
+
+/* Boot is over; later init-style calls are not recorded */
+void boot_profile_finish(void) {
+    if (!boot_profile_active) {
+        return;
+    }
+    
+    boot_profile.end_tsc = rdtsc();
+    boot_profile_active = false;
+}
+
+static uint64_t boot_profile_span_cycles(const boot_span_t *span) {
+    return span->end_tsc > span->start_tsc ? span->end_tsc - span->start_tsc : 0;
+}
+
+uint64_t boot_profile_total_us(void) {
+    uint64_t end = boot_profile.end_tsc ? boot_profile.end_tsc : rdtsc();
+    return tsc_cycles_to_us(end - boot_profile.start_tsc);
+}
+
+/* Copy a span name up to its argument list: "pmm_init(memory_map, 2)" -> "pmm_init" */
+static void boot_profile_short_name(const char *name, char *out, size_t size) {
+    size_t i = 0;
+    while (name[i] && name[i] != '(' && i + 1 < size) {
+        out[i] = name[i];
+        i++;
+    }
+    out[i] = '\0';
+}
+
+/* Span indices at `depth`, longest first */
+static uint32_t boot_profile_sorted(int depth, uint16_t *order) {
+    uint32_t count = 0;
+    
+    for (uint32_t i = 0; i < boot_profile.span_count; i++) {
+        const boot_span_t *span = &boot_profile.spans[i];
+        if ((depth == 0) != (span->depth == 0)) {
+            continue;
+        }
+        
+        uint64_t cycles = boot_profile_span_cycles(span);
+        uint32_t pos = count++;
+        while (pos > 0 && boot_profile_span_cycles(&boot_profile.spans[order[pos - 1]]) < cycles) {
+            order[pos] = order[pos - 1];
+            pos--;
+        }
+        order[pos] = (uint16_t)i;
+    }
+    return count;
+}
+
+static void boot_profile_print_span(const boot_span_t *span, uint64_t total_us) {
+    char name[BOOT_PROFILE_NAME_MAX];
+    boot_profile_short_name(span->name, name, sizeof(name));
+    
+    uint64_t us = tsc_cycles_to_us(boot_profile_span_cycles(span));
+    uint64_t permille = total_us ? us * 1000 / total_us : 0;
+    
+    serial_puts("[BOOT] ");
+    print_dec(us);
+    serial_puts("us ");
+    print_dec(permille / 10);
+    serial_puts(".");
+    print_dec(permille % 10);
+    serial_puts("% ");
+    serial_puts(name);
+    
+    if (span->parent >= 0) {
+        boot_profile_short_name(boot_profile.spans[span->parent].name, name, sizeof(name));
+        serial_puts(" (in ");
+        serial_puts(name);
+        serial_puts(")");
+    }
+    serial_puts("\n");
+}
+
+/* Print the boot breakdown: top-level steps, then nested phases, longest first */
+void boot_profile_report(void) {
+    static uint16_t order[BOOT_PROFILE_MAX_SPANS];
+    uint64_t total_us = boot_profile_total_us();
+    
+    serial_puts("[NEURAL-BOOT] === Boot Time Breakdown ===\n");
+    serial_puts("[INFO] Firmware and loader: ");
+    print_dec(tsc_cycles_to_us(boot_profile.start_tsc) / 1000);
+    serial_puts("ms before kmain\n");
+    serial_puts("[INFO] kmain to boot complete: ");
+    print_dec(total_us);
+    serial_puts("us\n");
+    
+    uint64_t accounted_us = 0;
+    uint32_t count = boot_profile_sorted(0, order);
+    for (uint32_t i = 0; i < count; i++) {
+        const boot_span_t *span = &boot_profile.spans[order[i]];
+        accounted_us += tsc_cycles_to_us(boot_profile_span_cycles(span));
+        boot_profile_print_span(span, total_us);
+    }
+    
+    serial_puts("[INFO] Timed init steps: ");
+    print_dec(accounted_us);
+    serial_puts("us\n");
+    serial_puts("[INFO] Untimed (logging, waiting for userland): ");
+    print_dec(total_us > accounted_us ? total_us - accounted_us : 0);
+    serial_puts("us\n");
+    
+    count = boot_profile_sorted(1, order);
+    if (count) {
+        serial_puts("[NEURAL-BOOT] --- Nested phases ---\n");
+        for (uint32_t i = 0; i < count; i++) {
+            boot_profile_print_span(&boot_profile.spans[order[i]], total_us);
+        }
+    }
+    
+    if (boot_profile.dropped) {
+        serial_puts("[WARNING] ");
+        print_dec(boot_profile.dropped);
+        serial_puts(" spans not recorded (table full or too deep)\n");
+    }
+    /* Wall time includes waiting for userland; only the init work is budgeted */
+    if (accounted_us > BOOT_PROFILE_BUDGET_US) {
+        serial_puts("[WARNING] Boot exceeded its ");
+        print_dec(BOOT_PROFILE_BUDGET_US / 1000);
+        serial_puts("ms budget\n");
+    }
+    
+    serial_puts("[NEURAL-BOOT] === End Boot Breakdown ===\n");
+}
+
+/* Write the spans as a Chrome trace ("X" complete events, microseconds) */
+int boot_profile_write_trace(const char *path) {
+    if (!path || boot_profile.span_count == 0) {
+        return -1;
+    }
+    
+    char *text = (char *)kmalloc(BOOT_PROFILE_TRACE_SIZE);
+    if (!text) {
+        return -1;
+    }
+    
+    size_t len = (size_t)snprintf(text, BOOT_PROFILE_TRACE_SIZE, "{\"traceEvents\":[\n");
+    for (uint32_t i = 0; i < boot_profile.span_count && len < BOOT_PROFILE_TRACE_SIZE; i++) {
+        const boot_span_t *span = &boot_profile.spans[i];
+        char name[BOOT_PROFILE_NAME_MAX];
+        boot_profile_short_name(span->name, name, sizeof(name));
+        
+        int n = snprintf(text + len, BOOT_PROFILE_TRACE_SIZE - len,
+                         "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%u,\"dur\":%u,\"pid\":0,\"tid\":0}\n",
+                         i ? "," : "", name,
+                         (uint32_t)tsc_cycles_to_us(span->start_tsc - boot_profile.start_tsc),
+                         (uint32_t)tsc_cycles_to_us(boot_profile_span_cycles(span)));
+        len += n > 0 ? (size_t)n : 0;
+    }
+    if (len < BOOT_PROFILE_TRACE_SIZE) {
+        int n = snprintf(text + len, BOOT_PROFILE_TRACE_SIZE - len, "]}\n");
+        len += n > 0 ? (size_t)n : 0;
+    }
+    if (len >= BOOT_PROFILE_TRACE_SIZE) {
+        len = BOOT_PROFILE_TRACE_SIZE - 1;
+    }
+    
+    int result = -1;
+    vfs_create_file(path, FS_PERM_DEFAULT);
+    int fd = vfs_open(path, FS_PERM_READ | FS_PERM_WRITE, 0);
+    if (fd >= 0) {
+        if (vfs_write(fd, text, len) == (int64_t)len) {
+            result = 0;
+        }
+        vfs_close(fd);
+    }
+    kfree(text);
+    
+    if (result == 0) {
+        serial_puts("[NEURAL-BOOT] Trace written to ");
+        serial_puts(path);
+        serial_puts("\n");
+    }
+    return result;
+}
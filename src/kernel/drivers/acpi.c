@@ -0,0 +1,216 @@
+/* acpi.c - Brandon Media OS ACPI Table Access
+ * Finds the RSDP in BIOS Memory and Caches Validated Tables
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "kernel/acpi.h"
+#include "kernel/memory.h"
+
+/* BIOS areas searched for the RSDP (identity mapped) */
+#define ACPI_EBDA_POINTER       0x40E
+#define ACPI_EBDA_SEARCH_SIZE   1024
+#define ACPI_BIOS_START         0xE0000
+#define ACPI_BIOS_END           0x100000
+
+/* Table page flags */
+#define ACPI_TABLE_FLAGS        (PAGE_PRESENT | PAGE_NO_EXECUTE)
+
+/* External functions */
+extern void serial_puts(const char *s);
+extern void print_hex(uint64_t num);
+extern void print_dec(uint64_t num);
+
+/* ACPI State */
+typedef struct {
+    const acpi_rsdp_t *rsdp;
+    const acpi_sdt_header_t *tables[ACPI_MAX_TABLES];
+    uint32_t table_count;
+} acpi_state_t;
+
+static acpi_state_t acpi;
+static bool acpi_initialized = false;
+
+static bool acpi_checksum_ok(const void *data, size_t length) {
+    const uint8_t *bytes = (const uint8_t *)data;
+    uint8_t sum = 0;
+    
+    for (size_t i = 0; i < length; i++) {
+        sum += bytes[i];
+    }
+    return sum == 0;
+}
+
+static bool acpi_signature_is(const char *signature, const char *expected, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        if (signature[i] != expected[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Physical table address to a kernel pointer; low memory is identity mapped */
+static const void *acpi_map(uint64_t phys, size_t length) {
+    if (phys + length <= KERNEL_PHYSICAL_END) {
+        return (const void *)phys;
+    }
+    
+    uint64_t offset = phys & PAGE_MASK;
+    uint8_t *base = (uint8_t *)vmm_map(phys, offset + length, ACPI_TABLE_FLAGS);
+    return base ? base + offset : NULL;
+}
+
+static void acpi_unmap(uint64_t phys, const void *mapped, size_t length) {
+    if (phys + length <= KERNEL_PHYSICAL_END) {
+        return;
+    }
+    
+    uint64_t offset = phys & PAGE_MASK;
+    vmm_unmap((uint8_t *)mapped - offset, offset + length);
+}
+
+/* Map a table header, then the whole table once its length is known */
+static const acpi_sdt_header_t *acpi_map_table(uint64_t phys) {
+    const acpi_sdt_header_t *header = (const acpi_sdt_header_t *)acpi_map(phys, sizeof(acpi_sdt_header_t));
+    if (!header) {
+        return NULL;
+    }
+    
+    uint32_t length = header->length;
+    if (length < sizeof(acpi_sdt_header_t)) {
+        acpi_unmap(phys, header, sizeof(acpi_sdt_header_t));
+        return NULL;
+    }
+    
+    /* The header mapping covers whole pages; replace it only if the table runs past them */
+    size_t mapped = sizeof(acpi_sdt_header_t);
+    if ((phys & PAGE_MASK) + length > PAGE_ALIGN_UP((phys & PAGE_MASK) + mapped)) {
+        acpi_unmap(phys, header, mapped);
+        header = (const acpi_sdt_header_t *)acpi_map(phys, length);
+        if (!header) {
+            return NULL;
+        }
+        mapped = length;
+    }
+    
+    if (!acpi_checksum_ok(header, length)) {
+        acpi_unmap(phys, header, mapped);
+        return NULL;
+    }
+    return header;
+}
+
+static const acpi_rsdp_t *acpi_scan_rsdp(uint64_t start, uint64_t end) {
+    for (uint64_t addr = start; addr + sizeof(acpi_rsdp_t) <= end; addr += 16) {
+        const acpi_rsdp_t *rsdp = (const acpi_rsdp_t *)addr;
+        if (!acpi_signature_is(rsdp->signature, "RSD PTR ", 8)) {
+            continue;
+        }
+        
+        /* v1 checksum covers the first 20 bytes, v2 the whole structure */
+        if (!acpi_checksum_ok(rsdp, 20)) {
+            continue;
+        }
+        if (rsdp->revision >= 2 && !acpi_checksum_ok(rsdp, rsdp->length)) {
+            continue;
+        }
+        return rsdp;
+    }
+    return NULL;
+}
+
+static const acpi_rsdp_t *acpi_find_rsdp(void) {
+    /* BIOS data area holds the EBDA segment; hide the constant address from -Warray-bounds */
+    volatile uint16_t *bda = (volatile uint16_t *)ACPI_EBDA_POINTER;
+    asm volatile("" : "+r"(bda));
+    uint64_t ebda = (uint64_t)(*bda) << 4;
+    if (ebda) {
+        const acpi_rsdp_t *rsdp = acpi_scan_rsdp(ebda, ebda + ACPI_EBDA_SEARCH_SIZE);
+        if (rsdp) {
+            return rsdp;
+        }
+    }
+    return acpi_scan_rsdp(ACPI_BIOS_START, ACPI_BIOS_END);
+}
+
+/* Initialize ACPI - validate and cache every table the root table lists */
+int acpi_init(void) {
+    if (acpi_initialized) {
+        return 0;
+    }
+    
+    memset(&acpi, 0, sizeof(acpi_state_t));
+    
+    acpi.rsdp = acpi_find_rsdp();
+    if (!acpi.rsdp) {
+        serial_puts("[NEURAL-ACPI] No RSDP found, ACPI tables unavailable\n");
+        return -1;
+    }
+    
+    /* Prefer the XSDT's 64-bit entries when the firmware provides one */
+    bool xsdt = acpi.rsdp->revision >= 2 && acpi.rsdp->xsdt_address;
+    const acpi_sdt_header_t *root = acpi_map_table(xsdt ? acpi.rsdp->xsdt_address : acpi.rsdp->rsdt_address);
+    if (!root) {
+        serial_puts("[NEURAL-ACPI] Root table failed validation\n");
+        return -1;
+    }
+    
+    size_t entry_size = xsdt ? sizeof(uint64_t) : sizeof(uint32_t);
+    size_t entries = (root->length - sizeof(acpi_sdt_header_t)) / entry_size;
+    const uint8_t *entry = (const uint8_t *)(root + 1);
+    
+    for (size_t i = 0; i < entries && acpi.table_count < ACPI_MAX_TABLES; i++, entry += entry_size) {
+        uint64_t phys = xsdt ? *(const uint64_t *)entry : *(const uint32_t *)entry;
+        const acpi_sdt_header_t *table = acpi_map_table(phys);
+        if (table) {
+            acpi.tables[acpi.table_count++] = table;
+        }
+    }
+    
+    acpi_initialized = true;
+    
+    serial_puts("[NEURAL-ACPI] ");
+    serial_puts(xsdt ? "XSDT" : "RSDT");
+    serial_puts(" with ");
+    print_dec(acpi.table_count);
+    serial_puts(" tables:");
+    for (uint32_t i = 0; i < acpi.table_count; i++) {
+        char signature[6] = {' ', 0, 0, 0, 0, 0};
+        memcpy(signature + 1, acpi.tables[i]->signature, 4);
+        serial_puts(signature);
+    }
+    serial_puts("\n");
+    return 0;
+}
+
+bool acpi_is_available(void) {
+    return acpi_initialized;
+}
+
+/* Find a table by its four-character signature */
+const acpi_sdt_header_t *acpi_find_table(const char *signature) {
+    if (!acpi_initialized || !signature) {
+        return NULL;
+    }
+    
+    for (uint32_t i = 0; i < acpi.table_count; i++) {
+        if (acpi_signature_is(acpi.tables[i]->signature, signature, 4)) {
+            return acpi.tables[i];
+        }
+    }
+    return NULL;
+}
+
+/* Get the MCFG ECAM allocations; returns their count */
+int acpi_get_mcfg_allocations(const acpi_mcfg_allocation_t **allocations) {
+    const acpi_mcfg_t *mcfg = (const acpi_mcfg_t *)acpi_find_table("MCFG");
+    if (!mcfg || !allocations) {
+        return 0;
+    }
+    
+    *allocations = mcfg->allocations;
+    return (int)((mcfg->header.length - sizeof(acpi_mcfg_t)) / sizeof(acpi_mcfg_allocation_t));
+}
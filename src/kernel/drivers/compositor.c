@@ -0,0 +1,505 @@
+/* compositor.c - Brandon Media OS Neural Compositor Implementation
+ * Zero-Copy Client Surfaces Blended Straight From Shared Pages
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "kernel/compositor.h"
+#include "kernel/framebuffer.h"
+#include "kernel/memory.h"
+#include "kernel/process.h"
+
+/* Surface page flags */
+#define SURFACE_KERNEL_FLAGS    (PAGE_PRESENT | PAGE_WRITABLE | PAGE_NO_EXECUTE)
+#define SURFACE_USER_FLAGS      (PAGE_PRESENT | PAGE_WRITABLE | PAGE_USER | PAGE_NO_EXECUTE)
+
+/* External functions */
+extern void serial_puts(const char *s);
+extern void print_dec(uint64_t num);
+
+/* Screen-Space Rectangle (exclusive max) */
+typedef struct {
+    int32_t x0, y0, x1, y1;
+} comp_rect_t;
+
+/* Kernel-Side Surface Record */
+typedef struct {
+    bool used;
+    uint32_t id;
+    uint32_t owner_pid;
+    uint32_t width;
+    uint32_t height;
+    int32_t x;
+    int32_t y;
+    int32_t z;
+    
+    /* Backing store: contiguous frames mapped twice (kernel + client) */
+    uint64_t phys;
+    size_t pages;
+    surface_shared_t *shared;
+    uint32_t *pixels;
+    uint64_t user_addr;
+    pml4_t *owner_space;
+    
+    /* Committed damage not yet on screen */
+    comp_rect_t damage;
+    bool has_damage;
+} comp_surface_t;
+
+/* Compositor State */
+typedef struct {
+    comp_surface_t surfaces[COMPOSITOR_MAX_SURFACES];
+    comp_surface_t *order[COMPOSITOR_MAX_SURFACES];     /* Back to front */
+    uint32_t order_count;
+    bool order_dirty;
+    bool needs_full;            /* Geometry changed under translucent content */
+    compositor_stats_t stats;
+} compositor_t;
+
+static compositor_t compositor;
+static bool compositor_initialized = false;
+
+/* Rectangle helpers */
+static bool comp_rect_clip(comp_rect_t *r, const comp_rect_t *clip) {
+    if (r->x0 < clip->x0) r->x0 = clip->x0;
+    if (r->y0 < clip->y0) r->y0 = clip->y0;
+    if (r->x1 > clip->x1) r->x1 = clip->x1;
+    if (r->y1 > clip->y1) r->y1 = clip->y1;
+    return r->x0 < r->x1 && r->y0 < r->y1;
+}
+
+static void comp_rect_union(comp_rect_t *r, const comp_rect_t *add) {
+    if (add->x0 < r->x0) r->x0 = add->x0;
+    if (add->y0 < r->y0) r->y0 = add->y0;
+    if (add->x1 > r->x1) r->x1 = add->x1;
+    if (add->y1 > r->y1) r->y1 = add->y1;
+}
+
+static comp_rect_t comp_surface_rect(const comp_surface_t *surface) {
+    comp_rect_t r = {surface->x, surface->y,
+                     surface->x + (int32_t)surface->width,
+                     surface->y + (int32_t)surface->height};
+    return r;
+}
+
+static void comp_surface_add_damage(comp_surface_t *surface, comp_rect_t screen) {
+    if (surface->has_damage) {
+        comp_rect_union(&surface->damage, &screen);
+    } else {
+        surface->damage = screen;
+        surface->has_damage = true;
+    }
+}
+
+/* Lookup a surface owned by the caller */
+static comp_surface_t *comp_find(uint32_t owner_pid, uint32_t id) {
+    if (id == 0 || id > COMPOSITOR_MAX_SURFACES) {
+        return NULL;
+    }
+    
+    comp_surface_t *surface = &compositor.surfaces[id - 1];
+    if (!surface->used || surface->owner_pid != owner_pid) {
+        return NULL;
+    }
+    return surface;
+}
+
+/* Initialize Compositor */
+int compositor_init(void) {
+    if (compositor_initialized) {
+        return 0;
+    }
+    
+    memset(&compositor, 0, sizeof(compositor));
+    compositor_initialized = true;
+    
+    serial_puts("[NEURAL-COMP] Compositor online - ");
+    print_dec(COMPOSITOR_MAX_SURFACES);
+    serial_puts(" shared surface slots\n");
+    return 0;
+}
+
+void compositor_shutdown(void) {
+    if (!compositor_initialized) {
+        return;
+    }
+    
+    for (uint32_t i = 0; i < COMPOSITOR_MAX_SURFACES; i++) {
+        comp_surface_t *surface = &compositor.surfaces[i];
+        if (surface->used) {
+            compositor_surface_destroy(surface->owner_pid, surface->id);
+        }
+    }
+    
+    compositor_initialized = false;
+    serial_puts("[NEURAL-COMP] Compositor shutdown\n");
+}
+
+bool compositor_is_initialized(void) {
+    return compositor_initialized;
+}
+
+/* Create a surface and map it into the owner's address space */
+int compositor_surface_create(uint32_t owner_pid, uint32_t width, uint32_t height,
+                              uint32_t flags, uint64_t *user_addr) {
+    if (!compositor_initialized || !user_addr || width == 0 || height == 0 ||
+        width > COMPOSITOR_MAX_DIMENSION || height > COMPOSITOR_MAX_DIMENSION) {
+        return -1;
+    }
+    
+    /* Find free slot */
+    uint32_t slot = COMPOSITOR_MAX_SURFACES;
+    for (uint32_t i = 0; i < COMPOSITOR_MAX_SURFACES; i++) {
+        if (!compositor.surfaces[i].used) {
+            slot = i;
+            break;
+        }
+    }
+    if (slot == COMPOSITOR_MAX_SURFACES) {
+        serial_puts("[NEURAL-COMP] No free surface slots\n");
+        return -1;
+    }
+    
+    /* Header page followed by the pixel rows */
+    uint32_t pitch = width * sizeof(uint32_t);
+    size_t bytes = PAGE_SIZE + (size_t)pitch * height;
+    size_t pages = PAGE_ALIGN_UP(bytes) / PAGE_SIZE;
+    
+    uint64_t phys = pmm_alloc_frames(pages);
+    if (!phys) {
+        return -1;
+    }
+    
+    surface_shared_t *shared = (surface_shared_t *)vmm_map(phys, pages * PAGE_SIZE, SURFACE_KERNEL_FLAGS);
+    if (!shared) {
+        pmm_free_frames(phys, pages);
+        return -1;
+    }
+    memset(shared, 0, pages * PAGE_SIZE);
+    
+    comp_surface_t *surface = &compositor.surfaces[slot];
+    memset(surface, 0, sizeof(comp_surface_t));
+    surface->id = slot + 1;
+    surface->owner_pid = owner_pid;
+    surface->width = width;
+    surface->height = height;
+    surface->phys = phys;
+    surface->pages = pages;
+    surface->shared = shared;
+    surface->pixels = (uint32_t *)((uint8_t *)shared + PAGE_SIZE);
+    
+    shared->magic = COMPOSITOR_SURFACE_MAGIC;
+    shared->id = surface->id;
+    shared->width = width;
+    shared->height = height;
+    shared->pitch = pitch;
+    shared->pixel_offset = PAGE_SIZE;
+    shared->flags = flags;
+    
+    /* Map the same frames into the client - it draws, we read, nothing is copied */
+    struct process *owner = owner_pid ? process_get_by_pid(owner_pid) : NULL;
+    if (owner && owner->page_directory) {
+        uint64_t base = COMPOSITOR_USER_BASE + (uint64_t)slot * COMPOSITOR_USER_SPAN;
+        
+        for (size_t i = 0; i < pages; i++) {
+            if (paging_map_page(owner->page_directory, base + i * PAGE_SIZE,
+                                phys + i * PAGE_SIZE, SURFACE_USER_FLAGS) != 0) {
+                for (size_t j = 0; j < i; j++) {
+                    paging_unmap_page(owner->page_directory, base + j * PAGE_SIZE);
+                }
+                vmm_unmap(shared, pages * PAGE_SIZE);
+                pmm_free_frames(phys, pages);
+                surface->id = 0;
+                return -1;
+            }
+        }
+        surface->owner_space = owner->page_directory;
+        surface->user_addr = base;
+    } else {
+        /* Kernel-side client */
+        surface->user_addr = (uint64_t)shared;
+    }
+    
+    surface->used = true;
+    compositor.order_dirty = true;
+    compositor.stats.surfaces++;
+    
+    serial_puts("[NEURAL-COMP] Surface ");
+    print_dec(surface->id);
+    serial_puts(" created for PID ");
+    print_dec(owner_pid);
+    serial_puts(": ");
+    print_dec(width);
+    serial_puts("x");
+    print_dec(height);
+    serial_puts("\n");
+    
+    *user_addr = surface->user_addr;
+    return (int)surface->id;
+}
+
+int compositor_surface_destroy(uint32_t owner_pid, uint32_t id) {
+    comp_surface_t *surface = comp_find(owner_pid, id);
+    if (!surface) {
+        return -1;
+    }
+    
+    if (surface->owner_space) {
+        for (size_t i = 0; i < surface->pages; i++) {
+            paging_unmap_page(surface->owner_space, surface->user_addr + i * PAGE_SIZE);
+        }
+    }
+    vmm_unmap(surface->shared, surface->pages * PAGE_SIZE);
+    pmm_free_frames(surface->phys, surface->pages);
+    
+    memset(surface, 0, sizeof(comp_surface_t));
+    compositor.order_dirty = true;
+    compositor.needs_full = true;
+    compositor.stats.surfaces--;
+    return 0;
+}
+
+/* Drain the client's damage ring; the IPC carries no pixels */
+int compositor_surface_commit(uint32_t owner_pid, uint32_t id) {
+    comp_surface_t *surface = comp_find(owner_pid, id);
+    if (!surface) {
+        return -1;
+    }
+    
+    surface_shared_t *shared = surface->shared;
+    comp_rect_t bounds = {0, 0, (int32_t)surface->width, (int32_t)surface->height};
+    uint32_t head = __atomic_load_n(&shared->damage_head, __ATOMIC_ACQUIRE);
+    uint32_t tail = shared->damage_tail;
+    
+    if (shared->damage_overflow || head - tail > COMPOSITOR_DAMAGE_RING) {
+        /* Client lost track - repaint everything */
+        comp_surface_add_damage(surface, comp_surface_rect(surface));
+        shared->damage_overflow = 0;
+        tail = head;
+    }
+    
+    for (; tail != head; tail++) {
+        surface_damage_t d = shared->damage[tail % COMPOSITOR_DAMAGE_RING];
+        if (d.width <= 0 || d.height <= 0) {
+            continue;
+        }
+        
+        /* Client-written extents: add in 64 bits and clamp before narrowing */
+        int64_t x1 = (int64_t)d.x + d.width;
+        int64_t y1 = (int64_t)d.y + d.height;
+        comp_rect_t r = {d.x, d.y,
+                         x1 < bounds.x1 ? (int32_t)x1 : bounds.x1,
+                         y1 < bounds.y1 ? (int32_t)y1 : bounds.y1};
+        
+        if (!comp_rect_clip(&r, &bounds)) {
+            continue;
+        }
+        
+        r.x0 += surface->x;
+        r.x1 += surface->x;
+        r.y0 += surface->y;
+        r.y1 += surface->y;
+        comp_surface_add_damage(surface, r);
+        compositor.stats.damage_rects++;
+    }
+    
+    __atomic_store_n(&shared->damage_tail, tail, __ATOMIC_RELEASE);
+    shared->frame_seq++;
+    compositor.stats.commits++;
+    return 0;
+}
+
+int compositor_surface_configure(uint32_t owner_pid, uint32_t id, int32_t x, int32_t y, int32_t z) {
+    comp_surface_t *surface = comp_find(owner_pid, id);
+    if (!surface) {
+        return -1;
+    }
+    
+    surface->x = x;
+    surface->y = y;
+    if (surface->z != z) {
+        surface->z = z;
+        compositor.order_dirty = true;
+    }
+    
+    /* Uncovered pixels belong to the scene beneath */
+    compositor.needs_full = true;
+    comp_surface_add_damage(surface, comp_surface_rect(surface));
+    return 0;
+}
+
+/* Drop every surface of an exiting process */
+void compositor_release_process(uint32_t owner_pid) {
+    if (!compositor_initialized) {
+        return;
+    }
+    
+    for (uint32_t i = 0; i < COMPOSITOR_MAX_SURFACES; i++) {
+        comp_surface_t *surface = &compositor.surfaces[i];
+        if (surface->used && surface->owner_pid == owner_pid) {
+            compositor_surface_destroy(owner_pid, surface->id);
+        }
+    }
+}
+
+/* Rebuild back-to-front order after z changes */
+static void comp_sort_surfaces(void) {
+    compositor.order_count = 0;
+    
+    for (uint32_t i = 0; i < COMPOSITOR_MAX_SURFACES; i++) {
+        comp_surface_t *surface = &compositor.surfaces[i];
+        if (!surface->used) {
+            continue;
+        }
+        
+        uint32_t j = compositor.order_count++;
+        while (j > 0 && compositor.order[j - 1]->z > surface->z) {
+            compositor.order[j] = compositor.order[j - 1];
+            j--;
+        }
+        compositor.order[j] = surface;
+    }
+    
+    compositor.order_dirty = false;
+}
+
+/* Blend one surface region straight from client pages onto the screen */
+static void comp_blit(framebuffer_device_t *fb, comp_surface_t *surface, comp_rect_t area) {
+    uint32_t span = area.x1 - area.x0;
+    bool opaque = surface->shared->flags & SURFACE_FLAG_OPAQUE;
+    
+    for (int32_t y = area.y0; y < area.y1; y++) {
+        const uint32_t *src = surface->pixels + (y - surface->y) * surface->width + (area.x0 - surface->x);
+        uint32_t *dst = fb->framebuffer + y * fb->width + area.x0;
+        
+        if (opaque) {
+            memcpy(dst, src, span * sizeof(uint32_t));
+            continue;
+        }
+        
+        for (uint32_t x = 0; x < span; x++) {
+            uint32_t s = src[x];
+            uint32_t a = s >> 24;
+            
+            if (a == 0xFF) {
+                dst[x] = s;
+            } else if (a) {
+                uint32_t d = dst[x];
+                uint32_t inv = 255 - a;
+                uint32_t rb = (((s & 0x00FF00FF) * a + (d & 0x00FF00FF) * inv) >> 8) & 0x00FF00FF;
+                uint32_t g = (((s & 0x0000FF00) * a + (d & 0x0000FF00) * inv) >> 8) & 0x0000FF00;
+                dst[x] = 0xFF000000 | rb | g;
+            }
+        }
+    }
+    
+    compositor.stats.pixels_composited += (uint64_t)span * (area.y1 - area.y0);
+}
+
+/* True when pending damage can be repaired over the previous frame: no
+ * surface moved, and every surface touching damage is opaque (translucent
+ * pixels blended again over themselves would compound)
+ */
+bool compositor_can_repair(void) {
+    if (!compositor_initialized) {
+        return true;
+    }
+    if (compositor.needs_full) {
+        return false;
+    }
+    
+    for (uint32_t i = 0; i < compositor.order_count; i++) {
+        comp_surface_t *damaged = compositor.order[i];
+        if (!damaged->has_damage) {
+            continue;
+        }
+        
+        for (uint32_t j = 0; j < compositor.order_count; j++) {
+            comp_surface_t *surface = compositor.order[j];
+            comp_rect_t area = comp_surface_rect(surface);
+            
+            if (!(surface->shared->flags & (SURFACE_FLAG_HIDDEN | SURFACE_FLAG_OPAQUE)) &&
+                comp_rect_clip(&area, &damaged->damage)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/* Composite client surfaces above the GUI.
+ * scene_redrawn: the caller repainted everything beneath this frame, so every
+ * visible surface is blended in full. Otherwise only committed damage is
+ * refreshed, which is exact for opaque surfaces.
+ */
+void compositor_render(bool scene_redrawn) {
+    if (!compositor_initialized) {
+        return;
+    }
+    
+    framebuffer_device_t *fb = framebuffer_get_device();
+    if (!fb || !fb->framebuffer) {
+        return;
+    }
+    
+    if (compositor.order_dirty) {
+        comp_sort_surfaces();
+    }
+    
+    comp_rect_t screen = {0, 0, (int32_t)fb->width, (int32_t)fb->height};
+    bool full = scene_redrawn || compositor.needs_full;
+    
+    if (full) {
+        for (uint32_t i = 0; i < compositor.order_count; i++) {
+            comp_surface_t *surface = compositor.order[i];
+            comp_rect_t area = comp_surface_rect(surface);
+            
+            surface->has_damage = false;
+            if (!(surface->shared->flags & SURFACE_FLAG_HIDDEN) && comp_rect_clip(&area, &screen)) {
+                comp_blit(fb, surface, area);
+            }
+        }
+        
+        compositor.needs_full = false;
+        compositor.stats.full_frames++;
+        return;
+    }
+    
+    /* Damage-only: re-layer every surface touching each damaged rect */
+    bool any = false;
+    for (uint32_t i = 0; i < compositor.order_count; i++) {
+        comp_surface_t *damaged = compositor.order[i];
+        if (!damaged->has_damage) {
+            continue;
+        }
+        
+        comp_rect_t dirty = damaged->damage;
+        damaged->has_damage = false;
+        if (!comp_rect_clip(&dirty, &screen)) {
+            continue;
+        }
+        
+        for (uint32_t j = 0; j < compositor.order_count; j++) {
+            comp_surface_t *surface = compositor.order[j];
+            comp_rect_t area = comp_surface_rect(surface);
+            
+            if (!(surface->shared->flags & SURFACE_FLAG_HIDDEN) && comp_rect_clip(&area, &dirty)) {
+                comp_blit(fb, surface, area);
+            }
+        }
+        any = true;
+    }
+    
+    if (any) {
+        compositor.stats.damage_frames++;
+    }
+}
+
+void compositor_get_stats(compositor_stats_t *stats) {
+    if (!stats) {
+        return;
+    }
+    *stats = compositor.stats;
+}
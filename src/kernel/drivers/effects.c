@@ -0,0 +1,157 @@
+/* effects.c - Brandon Media OS Neural Effect Engine Implementation
+ * LUT-Driven Background Effects Rendered From Cached Tiles
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+#include "kernel/effects.h"
+#include "kernel/framebuffer.h"
+
+/* Matrix wave: sin(t + 0.1x + 0.05y) sampled in LUT units per pixel */
+#define MATRIX_UNITS_X          (EFFECT_ANGLE_STEPS / EFFECT_MATRIX_TILE_W)    /* ~0.098 rad */
+#define MATRIX_UNITS_Y          (EFFECT_ANGLE_STEPS / EFFECT_MATRIX_TILE_H)    /* ~0.049 rad */
+#define MATRIX_THRESHOLD        22938   /* 0.7 in Q15 */
+
+/* External functions */
+extern void serial_puts(const char *s);
+
+/* Effect Engine State */
+static int16_t sin_lut[EFFECT_ANGLE_STEPS];
+static uint8_t matrix_tile[EFFECT_MATRIX_TILE_H][EFFECT_MATRIX_TILE_W];
+static uint32_t hue_palette[EFFECT_HUE_STEPS];
+static bool effects_initialized = false;
+static uint32_t effect_detail_shift = 0;
+static bool effect_scanlines_enabled = true;
+
+/* Initialize Effect Engine - all trig happens here, once */
+int effects_init(void) {
+    if (effects_initialized) {
+        return 0;
+    }
+
+    /* Q15 sine table */
+    for (uint32_t i = 0; i < EFFECT_ANGLE_STEPS; i++) {
+        float angle = (float)i * (6.28318530718f / EFFECT_ANGLE_STEPS);
+        sin_lut[i] = (int16_t)(sinf(angle) * (EFFECT_FIXED_ONE - 1));
+    }
+
+    /* Pre-render one period of the matrix wave; time becomes a horizontal scroll */
+    for (uint32_t y = 0; y < EFFECT_MATRIX_TILE_H; y++) {
+        for (uint32_t x = 0; x < EFFECT_MATRIX_TILE_W; x++) {
+            int32_t wave = sin_lut[(x * MATRIX_UNITS_X + y * MATRIX_UNITS_Y) & EFFECT_ANGLE_MASK];
+            matrix_tile[y][x] = wave > MATRIX_THRESHOLD ? (uint8_t)((wave * 255) >> EFFECT_FIXED_SHIFT) : 0;
+        }
+    }
+
+    /* Holographic hue ring: three phase-shifted sines */
+    for (uint32_t h = 0; h < EFFECT_HUE_STEPS; h++) {
+        uint32_t angle = h * (EFFECT_ANGLE_STEPS / EFFECT_HUE_STEPS);
+        uint32_t r = 128 + ((127 * sin_lut[angle & EFFECT_ANGLE_MASK]) >> EFFECT_FIXED_SHIFT);
+        uint32_t g = 128 + ((127 * sin_lut[(angle + EFFECT_ANGLE_STEPS / 3) & EFFECT_ANGLE_MASK]) >> EFFECT_FIXED_SHIFT);
+        uint32_t b = 128 + ((127 * sin_lut[(angle + 2 * EFFECT_ANGLE_STEPS / 3) & EFFECT_ANGLE_MASK]) >> EFFECT_FIXED_SHIFT);
+        hue_palette[h] = 0xFF000000 | (r << 16) | (g << 8) | b;
+    }
+
+    effects_initialized = true;
+    serial_puts("[NEURAL-FX] Effect engine initialized - trig tables and pattern tiles cached\n");
+    return 0;
+}
+
+bool effects_is_initialized(void) {
+    return effects_initialized;
+}
+
+/* Fixed-Point Trigonometry */
+int32_t effect_sin(uint32_t angle) {
+    return sin_lut[angle & EFFECT_ANGLE_MASK];
+}
+
+int32_t effect_cos(uint32_t angle) {
+    return sin_lut[(angle + EFFECT_ANGLE_STEPS / 4) & EFFECT_ANGLE_MASK];
+}
+
+/* Convert elapsed milliseconds at a rate of N milliradians/ms into LUT units */
+uint32_t effect_ms_to_angle(uint32_t time_ms, uint32_t rate_millirad) {
+    /* One turn is 6283.185 milliradians */
+    return (uint32_t)(((uint64_t)time_ms * rate_millirad * EFFECT_ANGLE_STEPS * 1000ULL) / 6283185ULL);
+}
+
+/* Cached Pattern Lookups */
+uint8_t effect_matrix_intensity(uint32_t x, uint32_t y, uint32_t time_ms) {
+    if (!effects_initialized) {
+        effects_init();
+    }
+
+    uint32_t scroll = effect_ms_to_angle(time_ms, 1) / MATRIX_UNITS_X;
+    return matrix_tile[y % EFFECT_MATRIX_TILE_H][(x + scroll) % EFFECT_MATRIX_TILE_W];
+}
+
+uint32_t effect_hue_color(uint32_t hue) {
+    if (!effects_initialized) {
+        effects_init();
+    }
+    return hue_palette[hue % EFFECT_HUE_STEPS];
+}
+
+/* Neural matrix background: scroll the cached tile under the glyph grid */
+void fb_neural_matrix_effect(uint32_t time_ms) {
+    framebuffer_device_t *fb = framebuffer_get_device();
+    if (!fb || !fb->framebuffer) {
+        return;
+    }
+
+    if (!effects_initialized) {
+        effects_init();
+    }
+
+    uint32_t scroll = effect_ms_to_angle(time_ms, 1) / MATRIX_UNITS_X;
+    uint32_t step_x = EFFECT_MATRIX_STEP_X << effect_detail_shift;
+    uint32_t step_y = EFFECT_MATRIX_STEP_Y << effect_detail_shift;
+
+    for (uint32_t y = 0; y < fb->height; y += step_y) {
+        const uint8_t *tile_row = matrix_tile[y % EFFECT_MATRIX_TILE_H];
+        uint32_t *row = fb->framebuffer + y * fb->width;
+
+        for (uint32_t x = 0; x < fb->width; x += step_x) {
+            uint8_t intensity = tile_row[(x + scroll) % EFFECT_MATRIX_TILE_W];
+            if (intensity) {
+                row[x] = 0xFF000000 | ((uint32_t)intensity << 8);
+            }
+        }
+    }
+}
+
+/* Cyberpunk scanlines: fixed-point blend of a premultiplied cyan row */
+void fb_cyberpunk_scanlines(uint32_t intensity) {
+    framebuffer_device_t *fb = framebuffer_get_device();
+    if (!fb || !fb->framebuffer || !effect_scanlines_enabled) {
+        return;
+    }
+
+    if (intensity > 255) intensity = 255;
+    uint32_t inv = 256 - intensity;
+
+    /* Cyan premultiplied by alpha */
+    uint32_t src_rb = ((0x000000FF * intensity) >> 8) & 0x00FF00FF;
+    uint32_t src_g = ((0x0000FF00 * intensity) >> 8) & 0x0000FF00;
+
+    for (uint32_t y = 0; y < fb->height; y += 4) {
+        uint32_t *row = fb->framebuffer + y * fb->width;
+
+        for (uint32_t x = 0; x < fb->width; x++) {
+            uint32_t dst = row[x];
+            uint32_t rb = ((((dst & 0x00FF00FF) * inv) >> 8) & 0x00FF00FF) + src_rb;
+            uint32_t g = ((((dst & 0x0000FF00) * inv) >> 8) & 0x0000FF00) + src_g;
+            row[x] = (dst & 0xFF000000) | rb | g;
+        }
+    }
+}
+
+/* Coarsen background effects under load */
+void effects_set_detail(uint32_t detail_shift, bool scanlines) {
+    effect_detail_shift = detail_shift > 3 ? 3 : detail_shift;
+    effect_scanlines_enabled = scanlines;
+}
@@ -4,6 +4,8 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <string.h>
+#include "kernel/framebuffer.h"
 #include "kernel/memory.h"
 #include "kernel/pci.h"
 #include "kernel/hal.h"
@@ -13,36 +15,75 @@
 #define VGA_WIDTH           80
 #define VGA_HEIGHT          25
 
-/* Framebuffer Device Structure */
-struct framebuffer_device {
-    struct hal_device *hal_dev;
-    struct pci_device *pci_dev;
-    uint32_t *framebuffer;
-    uint32_t width;
-    uint32_t height;
-    uint32_t pitch;
-    uint32_t bpp;          /* Bits per pixel */
-    uint32_t red_mask;
-    uint32_t green_mask;
-    uint32_t blue_mask;
-    int initialized;
-};
-
-static struct framebuffer_device *fb_dev = NULL;
+static framebuffer_device_t *fb_dev = NULL;
 
 /* External functions */
 extern void serial_puts(const char *s);
 extern void print_hex(uint64_t num);
 extern void print_dec(uint64_t num);
 
-/* Color definitions for cyberpunk theme */
-#define NEURAL_BLACK      0x00000000
-#define NEURAL_BLUE       0x000080FF
-#define NEURAL_CYAN       0x0000FFFF
-#define NEURAL_WHITE      0x00FFFFFF
-#define NEURAL_GREEN      0x0000FF00
-#define NEURAL_PURPLE     0x00800080
-#define NEURAL_MATRIX     0x0000AA00
+/* Channel layout for FB_FORMAT_GENERIC, derived from the masks at mode set */
+static struct {
+    uint32_t bytes;
+    uint8_t shift[3];
+    uint8_t bits[3];
+} fb_generic;
+
+/* Pixel packers: XRGB8888 in, scanout word out */
+#define FB_PACK_XRGB8888(c)     (c)
+#define FB_PACK_XBGR8888(c)     ((((c) >> 16) & 0xFF) | ((c) & 0xFF00) | (((c) & 0xFF) << 16))
+#define FB_PACK_RGB565(c)       ((((c) >> 8) & 0xF800) | (((c) >> 5) & 0x07E0) | (((c) >> 3) & 0x001F))
+#define FB_PACK_XRGB1555(c)     ((((c) >> 9) & 0x7C00) | (((c) >> 6) & 0x03E0) | (((c) >> 3) & 0x001F))
+#define FB_PACK_GENERIC(c)      fb_pack_generic(c)
+
+/* Pixel stores */
+#define FB_STORE_32(p, v)       (*(uint32_t *)(p) = (uint32_t)(v))
+#define FB_STORE_16(p, v)       (*(uint16_t *)(p) = (uint16_t)(v))
+#define FB_STORE_24(p, v)       ((p)[0] = (uint8_t)(v), (p)[1] = (uint8_t)((v) >> 8), (p)[2] = (uint8_t)((v) >> 16))
+#define FB_STORE_GENERIC(p, v)  fb_store_generic(p, v)
+
+static inline uint32_t fb_scale_channel(uint32_t value, uint8_t bits) {
+    return bits >= 8 ? value << (bits - 8) : value >> (8 - bits);
+}
+
+static inline uint32_t fb_pack_generic(uint32_t color) {
+    return (fb_scale_channel((color >> 16) & 0xFF, fb_generic.bits[0]) << fb_generic.shift[0]) |
+           (fb_scale_channel((color >> 8) & 0xFF, fb_generic.bits[1]) << fb_generic.shift[1]) |
+           (fb_scale_channel(color & 0xFF, fb_generic.bits[2]) << fb_generic.shift[2]);
+}
+
+static inline void fb_store_generic(uint8_t *p, uint32_t value) {
+    for (uint32_t i = 0; i < fb_generic.bytes; i++) {
+        p[i] = (uint8_t)(value >> (i * 8));
+    }
+}
+
+/* Generate the fill and blit kernels for one scanout format. The packer and
+ * store are expanded inline so each loop compiles down to straight stores.
+ */
+#define FB_DEFINE_FORMAT(name, id, BYTES, PACK, STORE)                              \
+    static void fb_fill_span_##name(uint8_t *dst, uint32_t color, uint32_t count) { \
+        uint32_t pixel = PACK(color);                                               \
+        for (uint32_t i = 0; i < count; i++, dst += (BYTES)) {                      \
+            STORE(dst, pixel);                                                      \
+        }                                                                           \
+    }                                                                               \
+    static void fb_blit_span_##name(uint8_t *dst, const uint32_t *src, uint32_t count) { \
+        for (uint32_t i = 0; i < count; i++, dst += (BYTES)) {                      \
+            STORE(dst, PACK(src[i]));                                               \
+        }                                                                           \
+    }                                                                               \
+    static const fb_format_ops_t fb_format_##name = {                               \
+        id, #name, fb_fill_span_##name, fb_blit_span_##name                         \
+    }
+
+FB_DEFINE_FORMAT(xrgb8888, FB_FORMAT_XRGB8888, 4, FB_PACK_XRGB8888, FB_STORE_32);
+FB_DEFINE_FORMAT(xbgr8888, FB_FORMAT_XBGR8888, 4, FB_PACK_XBGR8888, FB_STORE_32);
+FB_DEFINE_FORMAT(rgb888, FB_FORMAT_RGB888, 3, FB_PACK_XRGB8888, FB_STORE_24);
+FB_DEFINE_FORMAT(bgr888, FB_FORMAT_BGR888, 3, FB_PACK_XBGR8888, FB_STORE_24);
+FB_DEFINE_FORMAT(rgb565, FB_FORMAT_RGB565, 2, FB_PACK_RGB565, FB_STORE_16);
+FB_DEFINE_FORMAT(xrgb1555, FB_FORMAT_XRGB1555, 2, FB_PACK_XRGB1555, FB_STORE_16);
+FB_DEFINE_FORMAT(generic, FB_FORMAT_GENERIC, fb_generic.bytes, FB_PACK_GENERIC, FB_STORE_GENERIC);
 
 /* Basic VGA text mode operations */
 static void vga_clear_screen(void) {
@@ -85,24 +126,28 @@ static void vga_put_string(int x, int y, const char *str, uint8_t color) {
     }
 }
 
-/* Framebuffer operations */
-static void fb_put_pixel(uint32_t x, uint32_t y, uint32_t color) {
+/* Framebuffer operations - the render target is always linear XRGB8888 */
+void fb_put_pixel(uint32_t x, uint32_t y, uint32_t color) {
     if (!fb_dev || !fb_dev->framebuffer || !fb_dev->initialized) return;
     if (x >= fb_dev->width || y >= fb_dev->height) return;
     
-    uint32_t *pixel = fb_dev->framebuffer + (y * fb_dev->width + x);
-    *pixel = color;
+    fb_dev->framebuffer[y * fb_dev->width + x] = color;
 }
 
-static void fb_fill_rect(uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t color) {
-    for (uint32_t row = y; row < y + height && row < fb_dev->height; row++) {
-        for (uint32_t col = x; col < x + width && col < fb_dev->width; col++) {
-            fb_put_pixel(col, row, color);
-        }
+void fb_fill_rect(uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t color) {
+    if (!fb_dev || !fb_dev->framebuffer || !fb_dev->initialized) return;
+    if (x >= fb_dev->width || y >= fb_dev->height) return;
+    
+    if (width > fb_dev->width - x) width = fb_dev->width - x;
+    if (height > fb_dev->height - y) height = fb_dev->height - y;
+    
+    uint32_t *row = fb_dev->framebuffer + y * fb_dev->width + x;
+    for (uint32_t i = 0; i < height; i++, row += fb_dev->width) {
+        fb_fill_span_xrgb8888((uint8_t *)row, color, width);
     }
 }
 
-static void fb_clear_screen(uint32_t color) {
+void fb_clear_screen(uint32_t color) {
     if (!fb_dev || !fb_dev->framebuffer || !fb_dev->initialized) return;
     
     fb_fill_rect(0, 0, fb_dev->width, fb_dev->height, color);
@@ -139,7 +184,7 @@ static int fb_init_device(struct hal_device *hal_dev) {
     serial_puts("[NEURAL-GFX] Initializing neural display interface...\n");
     
     /* Allocate device structure */
-    fb_dev = (struct framebuffer_device *)kmalloc(sizeof(struct framebuffer_device));
+    fb_dev = (framebuffer_device_t *)kcalloc(1, sizeof(framebuffer_device_t));
     if (!fb_dev) {
         serial_puts("[NEURAL-GFX] Failed to allocate device structure\n");
         return -1;
@@ -154,7 +199,13 @@ static int fb_init_device(struct hal_device *hal_dev) {
     fb_dev->height = VGA_HEIGHT;
     fb_dev->pitch = VGA_WIDTH * 2;
     fb_dev->bpp = 16;
-    fb_dev->initialized = 1;
+    fb_dev->bytes_per_pixel = 2;
+    fb_dev->scanout = NULL;          /* Text mode: nothing to present */
+    fb_dev->format_ops = NULL;
+    fb_dev->frames_rendered = 0;
+    fb_dev->last_frame_time = 0;
+    fb_dev->fps = 0;
+    fb_dev->initialized = true;
     
     hal_dev->device_data = fb_dev;
     
@@ -232,7 +283,10 @@ static void fb_cleanup_device(struct hal_device *hal_dev) {
     /* Clear screen */
     vga_clear_screen();
     
-    /* Free device structure */
+    /* Free shadow buffer and device structure */
+    if (fb_dev->back_buffer) {
+        kfree(fb_dev->back_buffer);
+    }
     kfree(fb_dev);
     fb_dev = NULL;
     
@@ -261,11 +315,19 @@ void fb_print_info(void) {
     print_hex((uint64_t)fb_dev->framebuffer);
     serial_puts("\n");
     
+    if (fb_dev->format_ops) {
+        serial_puts("[INFO] Scanout format: ");
+        serial_puts(fb_dev->format_ops->name);
+        serial_puts(", pitch ");
+        print_dec(fb_dev->pitch);
+        serial_puts(fb_dev->back_buffer ? " (shadowed)\n" : " (direct)\n");
+    }
+    
     serial_puts("[NEURAL-GFX] === End Display Information ===\n");
 }
 
 /* Initialize framebuffer driver */
-void framebuffer_init(void) {
+int framebuffer_init(void) {
     serial_puts("[NEURAL-GFX] Initializing neural display driver...\n");
     
     /* Find VGA/Graphics device */
@@ -277,7 +339,7 @@ void framebuffer_init(void) {
                                                    "Neural Graphics Corporation");
     if (!hal_dev) {
         serial_puts("[NEURAL-GFX] Failed to create HAL device\n");
-        return;
+        return -1;
     }
     
     hal_dev->pci_dev = gfx_dev;  /* May be NULL for VGA */
@@ -291,10 +353,53 @@ void framebuffer_init(void) {
     if (hal_register_device(hal_dev) != 0) {
         serial_puts("[NEURAL-GFX] Failed to register HAL device\n");
         kfree(hal_dev);
-        return;
+        return -1;
     }
     
     serial_puts("[NEURAL-GFX] Neural display driver initialized\n");
+    return 0;
+}
+
+/* Display-less device: drawing lands in memory, present is a no-op */
+int fb_init_headless(uint32_t width, uint32_t height) {
+    if (fb_dev) {
+        return 0;
+    }
+    
+    if (width == 0 || height == 0) {
+        return -1;
+    }
+    
+    fb_dev = (framebuffer_device_t *)kcalloc(1, sizeof(framebuffer_device_t));
+    if (!fb_dev) {
+        return -1;
+    }
+    
+    fb_dev->back_buffer = (uint32_t *)kcalloc(width * height, sizeof(uint32_t));
+    if (!fb_dev->back_buffer) {
+        kfree(fb_dev);
+        fb_dev = NULL;
+        return -1;
+    }
+    
+    fb_dev->framebuffer = fb_dev->back_buffer;
+    fb_dev->width = width;
+    fb_dev->height = height;
+    fb_dev->pitch = width * 4;
+    fb_dev->bpp = 32;
+    fb_dev->bytes_per_pixel = 4;
+    fb_dev->scanout = NULL;
+    fb_dev->format_ops = NULL;
+    fb_dev->gpu_type = GPU_TYPE_SOFTWARE;
+    strncpy(fb_dev->gpu_name, "Headless", sizeof(fb_dev->gpu_name) - 1);
+    fb_dev->initialized = true;
+    
+    serial_puts("[NEURAL-GFX] Headless render target ");
+    print_dec(width);
+    serial_puts("x");
+    print_dec(height);
+    serial_puts("\n");
+    return 0;
 }
 
 /* Test graphics functions */
@@ -325,6 +430,208 @@ void fb_test_graphics(void) {
 }
 
 /* Get framebuffer device */
-struct framebuffer_device *framebuffer_get_device(void) {
+framebuffer_device_t *framebuffer_get_device(void) {
     return fb_dev;
-}
\ No newline at end of file
+}
+
+/* Bit position and width of a contiguous channel mask */
+static void fb_mask_layout(uint32_t mask, uint8_t *shift, uint8_t *bits) {
+    uint8_t s = 0;
+    uint8_t b = 0;
+    
+    while (mask && !(mask & 1)) {
+        mask >>= 1;
+        s++;
+    }
+    while (mask & 1) {
+        mask >>= 1;
+        b++;
+    }
+    
+    *shift = s;
+    *bits = b;
+}
+
+/* Pick the specialized kernels for a mode; unusual layouts fall back to generic */
+static const fb_format_ops_t *fb_select_format(uint32_t bpp, uint32_t r, uint32_t g, uint32_t b) {
+    if (bpp == 32 && r == 0x00FF0000 && g == 0x0000FF00 && b == 0x000000FF) return &fb_format_xrgb8888;
+    if (bpp == 32 && r == 0x000000FF && g == 0x0000FF00 && b == 0x00FF0000) return &fb_format_xbgr8888;
+    if (bpp == 24 && r == 0x00FF0000 && g == 0x0000FF00 && b == 0x000000FF) return &fb_format_rgb888;
+    if (bpp == 24 && r == 0x000000FF && g == 0x0000FF00 && b == 0x00FF0000) return &fb_format_bgr888;
+    if (bpp == 16 && r == 0xF800 && g == 0x07E0 && b == 0x001F) return &fb_format_rgb565;
+    if ((bpp == 15 || bpp == 16) && r == 0x7C00 && g == 0x03E0 && b == 0x001F) return &fb_format_xrgb1555;
+    
+    return &fb_format_generic;
+}
+
+/* Switch to a linear graphics mode. Drawing keeps targeting an XRGB8888
+ * surface; only when the scanout differs (format or padded pitch) is a
+ * shadow allocated and converted on fb_swap_buffers().
+ */
+int fb_set_linear_mode(const fb_linear_mode_t *mode) {
+    if (!fb_dev || !mode || !mode->base || !mode->width || !mode->height) {
+        return -1;
+    }
+    
+    uint32_t bytes = (mode->bpp + 7) / 8;
+    if (bytes < 2 || bytes > 4 || mode->pitch < mode->width * bytes) {
+        serial_puts("[NEURAL-GFX] Unsupported linear mode\n");
+        return -1;
+    }
+    
+    /* Firmware that reports no masks means the usual layout for its depth */
+    uint32_t red_mask = mode->red_mask;
+    uint32_t green_mask = mode->green_mask;
+    uint32_t blue_mask = mode->blue_mask;
+    if (!red_mask && !green_mask && !blue_mask) {
+        if (mode->bpp == 15) {
+            red_mask = 0x7C00; green_mask = 0x03E0; blue_mask = 0x001F;
+        } else if (mode->bpp == 16) {
+            red_mask = 0xF800; green_mask = 0x07E0; blue_mask = 0x001F;
+        } else {
+            red_mask = 0x00FF0000; green_mask = 0x0000FF00; blue_mask = 0x000000FF;
+        }
+    }
+    
+    const fb_format_ops_t *ops = fb_select_format(mode->bpp, red_mask, green_mask, blue_mask);
+    bool direct = ops->format == FB_FORMAT_XRGB8888 && mode->pitch == mode->width * 4;
+    
+    uint32_t *shadow = NULL;
+    if (!direct) {
+        shadow = (uint32_t *)kcalloc((size_t)mode->width * mode->height, sizeof(uint32_t));
+        if (!shadow) {
+            serial_puts("[NEURAL-GFX] Failed to allocate shadow buffer\n");
+            return -1;
+        }
+    }
+    
+    if (fb_dev->back_buffer) {
+        kfree(fb_dev->back_buffer);
+    }
+    
+    fb_dev->scanout = (uint8_t *)mode->base;
+    fb_dev->width = mode->width;
+    fb_dev->height = mode->height;
+    fb_dev->pitch = mode->pitch;
+    fb_dev->bpp = mode->bpp;
+    fb_dev->bytes_per_pixel = bytes;
+    fb_dev->red_mask = red_mask;
+    fb_dev->green_mask = green_mask;
+    fb_dev->blue_mask = blue_mask;
+    fb_dev->alpha_mask = 0;
+    
+    fb_mask_layout(red_mask, &fb_dev->red_shift, &fb_generic.bits[0]);
+    fb_mask_layout(green_mask, &fb_dev->green_shift, &fb_generic.bits[1]);
+    fb_mask_layout(blue_mask, &fb_dev->blue_shift, &fb_generic.bits[2]);
+    fb_dev->alpha_shift = 0;
+    fb_generic.bytes = bytes;
+    fb_generic.shift[0] = fb_dev->red_shift;
+    fb_generic.shift[1] = fb_dev->green_shift;
+    fb_generic.shift[2] = fb_dev->blue_shift;
+    
+    fb_dev->format_ops = ops;
+    fb_dev->back_buffer = shadow;
+    fb_dev->framebuffer = direct ? (uint32_t *)mode->base : shadow;
+    fb_dev->double_buffering_enabled = !direct;
+    
+    /* Start from a black scanout, padding columns are never touched again */
+    uint8_t *line = fb_dev->scanout;
+    for (uint32_t y = 0; y < mode->height; y++, line += mode->pitch) {
+        ops->fill_span(line, 0, mode->width);
+    }
+    
+    serial_puts("[NEURAL-GFX] Linear mode ");
+    print_dec(mode->width);
+    serial_puts("x");
+    print_dec(mode->height);
+    serial_puts(" ");
+    serial_puts(ops->name);
+    serial_puts(direct ? " (direct)\n" : " (shadowed)\n");
+    return 0;
+}
+
+/* Kernels selected at the last mode set (NULL in text mode) */
+const fb_format_ops_t *fb_get_format_ops(void) {
+    return fb_dev ? fb_dev->format_ops : NULL;
+}
+
+/* Present the shadow buffer through the format's blit kernel */
+void fb_swap_buffers(void) {
+    if (!fb_dev || !fb_dev->scanout || !fb_dev->back_buffer || !fb_dev->format_ops) {
+        return;
+    }
+    
+    const uint32_t *src = fb_dev->back_buffer;
+    uint8_t *dst = fb_dev->scanout;
+    void (*blit_span)(uint8_t *, const uint32_t *, uint32_t) = fb_dev->format_ops->blit_span;
+    
+    for (uint32_t y = 0; y < fb_dev->height; y++) {
+        blit_span(dst, src, fb_dev->width);
+        src += fb_dev->width;
+        dst += fb_dev->pitch;
+    }
+}
+
+/* Redirect drawing to an off-screen buffer of the same dimensions */
+uint32_t *fb_set_render_target(uint32_t *target) {
+    if (!fb_dev || !target) {
+        return NULL;
+    }
+    
+    uint32_t *previous = fb_dev->framebuffer;
+    fb_dev->framebuffer = target;
+    return previous;
+}
+
+/* Redirect drawing to a buffer of any size; previous receives the old target */
+void fb_bind_target(const fb_target_t *target, fb_target_t *previous) {
+    if (!fb_dev || !target || !target->pixels) {
+        return;
+    }
+    
+    if (previous) {
+        previous->pixels = fb_dev->framebuffer;
+        previous->width = fb_dev->width;
+        previous->height = fb_dev->height;
+    }
+    
+    fb_dev->framebuffer = target->pixels;
+    fb_dev->width = target->width;
+    fb_dev->height = target->height;
+}
+
+/* Record a completed frame (called by the frame profiler) */
+void fb_update_frame_stats(uint32_t frame_time_us) {
+    if (!fb_dev) {
+        return;
+    }
+    
+    fb_dev->frames_rendered++;
+    fb_dev->last_frame_time = frame_time_us;
+    fb_dev->fps = frame_time_us ? 1000000 / frame_time_us : 0;
+}
+
+/* Get performance counters */
+void fb_get_performance_stats(uint64_t *frames, uint32_t *fps, uint32_t *frame_time) {
+    if (!fb_dev) {
+        if (frames) *frames = 0;
+        if (fps) *fps = 0;
+        if (frame_time) *frame_time = 0;
+        return;
+    }
+    
+    if (frames) *frames = fb_dev->frames_rendered;
+    if (fps) *fps = fb_dev->fps;
+    if (frame_time) *frame_time = fb_dev->last_frame_time;
+}
+
+/* Reset performance counters */
+void fb_reset_performance_stats(void) {
+    if (!fb_dev) {
+        return;
+    }
+    
+    fb_dev->frames_rendered = 0;
+    fb_dev->last_frame_time = 0;
+    fb_dev->fps = 0;
+}
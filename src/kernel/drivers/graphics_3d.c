@@ -10,6 +10,9 @@
 #include "kernel/graphics_3d.h"
 #include "kernel/framebuffer.h"
 #include "kernel/memory.h"
+#include "kernel/tsc.h"
+#include "kernel/perf.h"
+#include "kernel/effects.h"
 
 /* External functions */
 extern void serial_puts(const char *s);
@@ -82,12 +85,42 @@ void graphics_3d_shutdown(void) {
     serial_puts("[NEURAL-3D] Neural 3D Graphics Engine shutdown complete\n");
 }
 
+/* Retarget rendering; the Z-buffer follows the new size */
+int graphics_3d_set_target(uint32_t *framebuffer, uint32_t width, uint32_t height) {
+    if (!graphics_3d_initialized || !framebuffer || width == 0 || height == 0) {
+        return -1;
+    }
+    
+    if (width != renderer.width || height != renderer.height) {
+        zbuffer_destroy(&renderer.zbuffer);
+        zbuffer_init(&renderer.zbuffer, width, height);
+        if (!renderer.zbuffer.buffer) {
+            return -1;
+        }
+        renderer.projection_matrix = matrix4_perspective(60.0f, (float)width / (float)height, 0.1f, 1000.0f);
+    }
+    
+    renderer.framebuffer = framebuffer;
+    renderer.width = width;
+    renderer.height = height;
+    return 0;
+}
+
+/* Renderer for direct rasterizer calls (NULL before init) */
+renderer_3d_t *graphics_3d_get_renderer(void) {
+    return graphics_3d_initialized ? &renderer : NULL;
+}
+
 /* Clear Screen and Z-buffer */
 void graphics_3d_clear(uint32_t color) {
     if (!graphics_3d_initialized || !renderer.framebuffer) {
         return;
     }
     
+    /* Start of a 3D frame */
+    renderer.frame_start_tsc = rdtsc();
+    perf_stage_begin(PERF_STAGE_3D);
+    
     /* Clear framebuffer */
     for (uint32_t i = 0; i < renderer.width * renderer.height; i++) {
         renderer.framebuffer[i] = color;
@@ -102,6 +135,19 @@ void graphics_3d_clear(uint32_t color) {
     renderer.pixels_drawn = 0;
 }
 
+/* Finish 3D Frame */
+void graphics_3d_present(void) {
+    if (!graphics_3d_initialized || renderer.frame_start_tsc == 0) {
+        return;
+    }
+    
+    perf_stage_end(PERF_STAGE_3D);
+    
+    uint64_t elapsed_us = tsc_cycles_to_us(rdtsc() - renderer.frame_start_tsc);
+    renderer.frame_time_ms = (uint32_t)(elapsed_us / 1000);
+    renderer.frame_start_tsc = 0;
+}
+
 /* Vector Math Operations */
 vec3_t vec3_add(vec3_t a, vec3_t b) {
     return (vec3_t){a.x + b.x, a.y + b.y, a.z + b.z};
@@ -383,13 +429,13 @@ void neural_matrix_effect(renderer_3d_t *r, float time) {
         return;
     }
     
-    /* Create flowing matrix pattern */
-    for (uint32_t y = 0; y < r->height; y += 2) {
-        for (uint32_t x = 0; x < r->width; x += 8) {
-            float wave = sinf(time * 0.001f + x * 0.1f + y * 0.05f);
-            if (wave > 0.7f) {
-                uint32_t intensity = (uint32_t)(wave * 255.0f);
-                uint32_t color = (intensity << 8); /* Green channel */
+    /* Create flowing matrix pattern from the cached effect tile */
+    uint32_t time_ms = (uint32_t)time;
+    for (uint32_t y = 0; y < r->height; y += EFFECT_MATRIX_STEP_Y) {
+        for (uint32_t x = 0; x < r->width; x += EFFECT_MATRIX_STEP_X) {
+            uint8_t intensity = effect_matrix_intensity(x, y, time_ms);
+            if (intensity) {
+                uint32_t color = ((uint32_t)intensity << 8); /* Green channel */
                 plot_pixel_3d(x, y, 0.5f, color, r);
             }
         }
@@ -486,6 +532,7 @@ void graphics_3d_test(void) {
     /* Enable neural matrix mode */
     graphics_3d_set_render_mode(RENDER_MODE_NEURAL_MATRIX);
     neural_matrix_effect(&renderer, get_time_ms());
+    graphics_3d_present();
     
     /* Print statistics */
     uint32_t triangles, vertices, pixels, frame_time;
@@ -495,5 +542,9 @@ void graphics_3d_test(void) {
     print_dec(pixels);
     serial_puts("\n");
     
+    serial_puts("[STATS] Frame time: ");
+    print_dec(frame_time);
+    serial_puts(" ms\n");
+    
     serial_puts("[NEURAL-3D] 3D Graphics test completed\n");
 }
\ No newline at end of file
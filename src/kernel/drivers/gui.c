@@ -10,6 +10,10 @@
 #include "kernel/framebuffer.h"
 #include "kernel/input.h"
 #include "kernel/memory.h"
+#include "kernel/perf.h"
+#include "kernel/particles.h"
+#include "kernel/effects.h"
+#include "kernel/compositor.h"
 
 /* External functions */
 extern void serial_puts(const char *s);
@@ -19,6 +23,151 @@ extern uint32_t get_time_ms(void);
 /* Global GUI System State */
 static gui_system_t gui_system;
 static bool gui_initialized = false;
+static uint32_t gui_stale_layers = 0;  /* Render side: dirty but skipped while hidden */
+
+/* Widget List Helpers */
+static int gui_list_append(gui_widget_list_t *list, gui_widget_t *widget, uint32_t initial_capacity) {
+    if (list->count == list->capacity) {
+        uint32_t new_capacity = list->capacity ? list->capacity * 2 : initial_capacity;
+        gui_widget_t **items = (gui_widget_t **)krealloc(list->items, new_capacity * sizeof(gui_widget_t *));
+        if (!items) {
+            return -1;
+        }
+        list->items = items;
+        list->capacity = new_capacity;
+    }
+    
+    list->items[list->count++] = widget;
+    return 0;
+}
+
+/* Unordered removal for grid cells */
+static void gui_list_remove_unordered(gui_widget_list_t *list, gui_widget_t *widget) {
+    for (uint32_t i = 0; i < list->count; i++) {
+        if (list->items[i] == widget) {
+            list->items[i] = list->items[--list->count];
+            return;
+        }
+    }
+}
+
+static bool gui_rect_equal(rect_t a, rect_t b) {
+    return a.x == b.x && a.y == b.y && a.width == b.width && a.height == b.height;
+}
+
+static bool gui_rect_overlap(rect_t a, rect_t b) {
+    return a.x < b.x + b.width && b.x < a.x + a.width &&
+           a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+/* Spatial Grid */
+static int gui_grid_init(gui_spatial_grid_t *grid, uint32_t width, uint32_t height) {
+    grid->cols = (width + GUI_GRID_CELL_SIZE - 1) / GUI_GRID_CELL_SIZE;
+    grid->rows = (height + GUI_GRID_CELL_SIZE - 1) / GUI_GRID_CELL_SIZE;
+    if (grid->cols == 0) grid->cols = 1;
+    if (grid->rows == 0) grid->rows = 1;
+    
+    grid->cells = (gui_widget_list_t *)kcalloc(grid->cols * grid->rows, sizeof(gui_widget_list_t));
+    return grid->cells ? 0 : -1;
+}
+
+static void gui_grid_destroy(gui_spatial_grid_t *grid) {
+    if (!grid->cells) {
+        return;
+    }
+    
+    for (uint32_t i = 0; i < grid->cols * grid->rows; i++) {
+        if (grid->cells[i].items) {
+            kfree(grid->cells[i].items);
+        }
+    }
+    kfree(grid->cells);
+    grid->cells = NULL;
+}
+
+/* Cells covered by a rect, clamped to the grid (off-screen parts land on edges) */
+static bool gui_grid_cell_range(gui_spatial_grid_t *grid, rect_t rect,
+                                uint32_t *c0, uint32_t *r0, uint32_t *c1, uint32_t *r1) {
+    if (!grid->cells || rect.width <= 0 || rect.height <= 0) {
+        return false;
+    }
+    
+    int32_t x0 = rect.x / GUI_GRID_CELL_SIZE;
+    int32_t y0 = rect.y / GUI_GRID_CELL_SIZE;
+    int32_t x1 = (rect.x + rect.width - 1) / GUI_GRID_CELL_SIZE;
+    int32_t y1 = (rect.y + rect.height - 1) / GUI_GRID_CELL_SIZE;
+    int32_t max_c = (int32_t)grid->cols - 1;
+    int32_t max_r = (int32_t)grid->rows - 1;
+    
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 < 0) x1 = 0;
+    if (y1 < 0) y1 = 0;
+    if (x0 > max_c) x0 = max_c;
+    if (y0 > max_r) y0 = max_r;
+    if (x1 > max_c) x1 = max_c;
+    if (y1 > max_r) y1 = max_r;
+    
+    *c0 = x0;
+    *r0 = y0;
+    *c1 = x1;
+    *r1 = y1;
+    return true;
+}
+
+static gui_widget_list_t *gui_grid_cell_at(gui_spatial_grid_t *grid, point2d_t point) {
+    if (!grid->cells || point.x < 0 || point.y < 0) {
+        return NULL;
+    }
+    
+    uint32_t c = point.x / GUI_GRID_CELL_SIZE;
+    uint32_t r = point.y / GUI_GRID_CELL_SIZE;
+    if (c >= grid->cols || r >= grid->rows) {
+        return NULL;
+    }
+    return &grid->cells[r * grid->cols + c];
+}
+
+static void gui_grid_insert(gui_spatial_grid_t *grid, gui_widget_t *widget) {
+    uint32_t c0, r0, c1, r1;
+    
+    widget->indexed_bounds = widget->bounds;
+    widget->indexed = true;
+    
+    if (!gui_grid_cell_range(grid, widget->bounds, &c0, &r0, &c1, &r1)) {
+        return;
+    }
+    
+    for (uint32_t r = r0; r <= r1; r++) {
+        for (uint32_t c = c0; c <= c1; c++) {
+            gui_list_append(&grid->cells[r * grid->cols + c], widget, 4);
+        }
+    }
+}
+
+static void gui_grid_remove(gui_spatial_grid_t *grid, gui_widget_t *widget) {
+    uint32_t c0, r0, c1, r1;
+    
+    widget->indexed = false;
+    
+    if (!gui_grid_cell_range(grid, widget->indexed_bounds, &c0, &r0, &c1, &r1)) {
+        return;
+    }
+    
+    for (uint32_t r = r0; r <= r1; r++) {
+        for (uint32_t c = c0; c <= c1; c++) {
+            gui_list_remove_unordered(&grid->cells[r * grid->cols + c], widget);
+        }
+    }
+}
+
+static void gui_reindex_widget(gui_widget_t *widget) {
+    gui_spatial_grid_t *grid = &gui_system.grids[widget->layer];
+    
+    gui_grid_remove(grid, widget);
+    gui_grid_insert(grid, widget);
+    gui_system.layout_generation++;
+}
 
 /* Initialize GUI System */
 int gui_init(void) {
@@ -37,7 +186,17 @@ int gui_init(void) {
         gui_system.layers[i].visible = true;
         gui_system.layers[i].interactive = (i >= LAYER_FOREGROUND);
         gui_system.layers[i].opacity = 255;
-        gui_system.widget_count[i] = 0;
+    }
+    
+    /* Build per-layer spatial index over the screen */
+    framebuffer_device_t *fb = framebuffer_get_device();
+    uint32_t index_width = fb ? fb->width : 1024;
+    uint32_t index_height = fb ? fb->height : 768;
+    for (int i = 0; i < MAX_GUI_LAYERS; i++) {
+        if (gui_grid_init(&gui_system.grids[i], index_width, index_height) != 0) {
+            serial_puts("[NEURAL-GUI] Failed to allocate spatial index\n");
+            return -1;
+        }
     }
     
     /* Set parallax factors for specific layers */
@@ -62,6 +221,10 @@ int gui_init(void) {
     /* Initialize timing */
     gui_system.frame_time_ms = 16; /* Target 60fps */
     gui_system.last_frame_time = get_time_ms();
+    gui_system.animation_divisor = 1;
+    
+    /* Build effect LUTs and pattern tiles up front */
+    effects_init();
     
     /* Initialize accessibility settings */
     gui_system.reduced_motion = false;
@@ -94,12 +257,22 @@ void gui_shutdown(void) {
     
     /* Destroy all widgets */
     for (int layer = 0; layer < MAX_GUI_LAYERS; layer++) {
-        for (int i = 0; i < gui_system.widget_count[layer]; i++) {
-            if (gui_system.widgets[layer][i]) {
-                gui_destroy_widget(gui_system.widgets[layer][i]);
-            }
+        /* Destroy from the back so removal never shifts pending entries */
+        while (gui_system.widgets[layer].count > 0) {
+            gui_destroy_widget(gui_system.widgets[layer].items[gui_system.widgets[layer].count - 1]);
+        }
+        
+        if (gui_system.widgets[layer].items) {
+            kfree(gui_system.widgets[layer].items);
+        }
+        memset(&gui_system.widgets[layer], 0, sizeof(gui_widget_list_t));
+        gui_grid_destroy(&gui_system.grids[layer]);
+        
+        /* Release cached layer surface */
+        if (gui_system.layers[layer].surface) {
+            kfree(gui_system.layers[layer].surface);
+            gui_system.layers[layer].surface = NULL;
         }
-        gui_system.widget_count[layer] = 0;
     }
     
     gui_system.initialized = false;
@@ -131,27 +304,228 @@ void gui_update(uint32_t delta_ms) {
     /* Update layer offsets based on camera movement */
     for (int i = 0; i < MAX_GUI_LAYERS; i++) {
         gui_layer_t *layer = &gui_system.layers[i];
-        layer->offset.x = gui_system.camera_position.x * layer->parallax_factor;
-        layer->offset.y = gui_system.camera_position.y * layer->parallax_factor;
-        layer->offset.z = gui_system.camera_position.z * layer->parallax_factor;
+        float factor = layer->parallax_factor * gui_system.parallax_strength;
+        layer->offset.x = gui_system.camera_position.x * factor;
+        layer->offset.y = gui_system.camera_position.y * factor;
+        layer->offset.z = gui_system.camera_position.z * factor;
     }
     
     /* Update widgets */
     for (int layer = 0; layer < MAX_GUI_LAYERS; layer++) {
-        for (int i = 0; i < gui_system.widget_count[layer]; i++) {
-            gui_widget_t *widget = gui_system.widgets[layer][i];
+        for (uint32_t i = 0; i < gui_system.widgets[layer].count; i++) {
+            gui_widget_t *widget = gui_system.widgets[layer].items[i];
             if (widget && widget->update) {
+                /* Update handlers call gui_invalidate_widget() on visible change */
                 widget->update(widget, delta_ms);
             }
+            
+            /* Widgets moved by animations or direct writes get re-indexed */
+            if (widget && !gui_rect_equal(widget->bounds, widget->indexed_bounds)) {
+                gui_reindex_widget(widget);
+            }
         }
     }
     
-    /* Update animations */
-    gui_update_animations(delta_ms);
+    /* Route pointer input through the spatial index */
+    gui_handle_input();
+    
+    /* Update animations, possibly thinned out by the quality governor */
+    gui_system.animation_pending_ms += delta_ms;
+    if (++gui_system.animation_tick >= gui_system.animation_divisor) {
+        gui_update_animations(gui_system.animation_pending_ms);
+        gui_system.animation_tick = 0;
+        gui_system.animation_pending_ms = 0;
+    }
+    
+    /* Advance neural particles */
+    particle_engine_update(delta_ms / 1000.0f);
 }
 
-/* Render GUI System */
-void gui_render(void) {
+/* Render widgets of one layer to the current render target */
+static void gui_render_layer_widgets(int layer, const gui_snapshot_t *snapshot) {
+    if (snapshot) {
+        const gui_snapshot_layer_t *snap = &snapshot->layers[layer];
+        for (uint32_t i = 0; i < snap->count; i++) {
+            gui_widget_t *widget = &snap->widgets[i];
+            if (widget->visible && widget->render) {
+                widget->render(widget);
+            }
+        }
+        return;
+    }
+    
+    for (uint32_t i = 0; i < gui_system.widgets[layer].count; i++) {
+        gui_widget_t *widget = gui_system.widgets[layer].items[i];
+        if (widget && widget->visible && widget->render) {
+            widget->render(widget);
+        }
+    }
+}
+
+/* Allocate a layer surface on first use; returns 1 when it still needs painting */
+static int gui_prepare_layer_surface(gui_layer_t *layer, framebuffer_device_t *fb) {
+    if (layer->surface) {
+        return 0;
+    }
+    
+    if (!fb->framebuffer) {
+        return -1;
+    }
+    
+    layer->surface = (uint32_t *)kmalloc(fb->width * fb->height * sizeof(uint32_t));
+    if (!layer->surface) {
+        /* Fall back to direct rendering for this layer */
+        return -1;
+    }
+    
+    return 1;
+}
+
+/* Blit a cached layer surface at its parallax offset; translucent pixels
+ * blend over what is already on screen, transparent ones are skipped
+ */
+static void gui_composite_layer(gui_layer_t *layer, framebuffer_device_t *fb, int32_t offset_x, int32_t offset_y) {
+    int32_t width = (int32_t)fb->width;
+    int32_t height = (int32_t)fb->height;
+    
+    /* Clip destination against the screen */
+    int32_t dst_x0 = offset_x > 0 ? offset_x : 0;
+    int32_t dst_y0 = offset_y > 0 ? offset_y : 0;
+    int32_t dst_x1 = offset_x < 0 ? width + offset_x : width;
+    int32_t dst_y1 = offset_y < 0 ? height + offset_y : height;
+    
+    if (dst_x0 >= dst_x1 || dst_y0 >= dst_y1) {
+        return;
+    }
+    
+    for (int32_t y = dst_y0; y < dst_y1; y++) {
+        const uint32_t *src = layer->surface + (y - offset_y) * width + (dst_x0 - offset_x);
+        uint32_t *dst = fb->framebuffer + y * width + dst_x0;
+        
+        for (int32_t x = dst_x0; x < dst_x1; x++, src++, dst++) {
+            uint32_t s = *src;
+            uint32_t a = s >> 24;
+            
+            if (a == 0xFF) {
+                *dst = s;
+            } else if (a) {
+                uint32_t d = *dst;
+                uint32_t inv = 255 - a;
+                uint32_t rb = (((s & 0x00FF00FF) * a + (d & 0x00FF00FF) * inv) >> 8) & 0x00FF00FF;
+                uint32_t g = (((s & 0x0000FF00) * a + (d & 0x0000FF00) * inv) >> 8) & 0x0000FF00;
+                *dst = 0xFF000000 | rb | g;
+            }
+        }
+    }
+}
+
+/* Collect and clear the layers invalidated since the last call */
+uint32_t gui_take_dirty_layers(void) {
+    uint32_t mask = 0;
+    
+    for (int layer = 0; layer < MAX_GUI_LAYERS; layer++) {
+        if (gui_system.layers[layer].dirty) {
+            gui_system.layers[layer].dirty = false;
+            mask |= 1u << layer;
+        }
+    }
+    
+    return mask;
+}
+
+/* Copy render-visible state into a snapshot. Runs on the update side; the
+ * renderer then never reads live widgets, so both can run concurrently.
+ */
+int gui_capture_snapshot(gui_snapshot_t *snapshot) {
+    if (!gui_initialized || !snapshot) {
+        return -1;
+    }
+    
+    /* Size the data arena up front so copied data pointers stay valid */
+    uint32_t data_bytes = 0;
+    for (int layer = 0; layer < MAX_GUI_LAYERS; layer++) {
+        for (uint32_t i = 0; i < gui_system.widgets[layer].count; i++) {
+            gui_widget_t *widget = gui_system.widgets[layer].items[i];
+            if (widget && widget->data) {
+                data_bytes += (widget->data_size + 15) & ~15u;
+            }
+        }
+    }
+    
+    if (data_bytes > snapshot->data_capacity) {
+        uint8_t *arena = (uint8_t *)krealloc(snapshot->data_arena, data_bytes);
+        if (!arena) {
+            return -1;
+        }
+        snapshot->data_arena = arena;
+        snapshot->data_capacity = data_bytes;
+    }
+    snapshot->data_used = 0;
+    
+    for (int layer = 0; layer < MAX_GUI_LAYERS; layer++) {
+        gui_widget_list_t *list = &gui_system.widgets[layer];
+        gui_snapshot_layer_t *snap = &snapshot->layers[layer];
+        
+        if (list->count > snap->capacity) {
+            gui_widget_t *widgets = (gui_widget_t *)krealloc(snap->widgets, list->count * sizeof(gui_widget_t));
+            if (!widgets) {
+                return -1;
+            }
+            snap->widgets = widgets;
+            snap->capacity = list->count;
+        }
+        
+        snap->count = 0;
+        for (uint32_t i = 0; i < list->count; i++) {
+            gui_widget_t *widget = list->items[i];
+            if (!widget) {
+                continue;
+            }
+            
+            gui_widget_t *copy = &snap->widgets[snap->count++];
+            *copy = *widget;
+            copy->next = NULL;
+            copy->prev = NULL;
+            
+            /* Data without a recorded size stays shared with the live widget */
+            if (widget->data && widget->data_size) {
+                copy->data = snapshot->data_arena + snapshot->data_used;
+                memcpy(copy->data, widget->data, widget->data_size);
+                snapshot->data_used += (widget->data_size + 15) & ~15u;
+            }
+        }
+        
+        snap->offset = gui_system.layers[layer].offset;
+        snap->visible = gui_system.layers[layer].visible;
+    }
+    
+    snapshot->frame_time = gui_system.last_frame_time;
+    snapshot->mouse_pos = gui_system.mouse_pos;
+    return 0;
+}
+
+/* Release snapshot storage */
+void gui_free_snapshot(gui_snapshot_t *snapshot) {
+    if (!snapshot) {
+        return;
+    }
+    
+    for (int layer = 0; layer < MAX_GUI_LAYERS; layer++) {
+        if (snapshot->layers[layer].widgets) {
+            kfree(snapshot->layers[layer].widgets);
+        }
+    }
+    if (snapshot->data_arena) {
+        kfree(snapshot->data_arena);
+    }
+    
+    memset(snapshot, 0, sizeof(gui_snapshot_t));
+}
+
+/* Render from a snapshot, or from live widgets when snapshot is NULL.
+ * dirty_layers comes from gui_take_dirty_layers() on the update side.
+ */
+void gui_render_snapshot(const gui_snapshot_t *snapshot, uint32_t dirty_layers) {
     if (!gui_initialized) {
         return;
     }
@@ -161,47 +535,84 @@ void gui_render(void) {
         return;
     }
     
+    /* Layers skipped while hidden keep their invalidation */
+    dirty_layers |= gui_stale_layers;
+    gui_stale_layers = 0;
+    
     /* Clear background with cyberpunk theme */
     uint32_t bg_color = fb_color_from_rgba(gui_system.theme_background.r,
                                           gui_system.theme_background.g,
                                           gui_system.theme_background.b,
                                           gui_system.theme_background.a);
+    perf_stage_begin(PERF_STAGE_EFFECTS);
     fb_clear_screen(bg_color);
     
     /* Render neural background effect */
-    fb_neural_matrix_effect(gui_system.last_frame_time);
+    fb_neural_matrix_effect(snapshot ? snapshot->frame_time : gui_system.last_frame_time);
+    particle_engine_render();
+    perf_stage_end(PERF_STAGE_EFFECTS);
     
     /* Render layers in depth order (back to front) */
+    perf_stage_begin(PERF_STAGE_WIDGETS);
     for (int layer = 0; layer < MAX_GUI_LAYERS; layer++) {
         gui_layer_t *current_layer = &gui_system.layers[layer];
+        uint32_t bit = 1u << layer;
+        bool visible = snapshot ? snapshot->layers[layer].visible : current_layer->visible;
+        uint32_t count = snapshot ? snapshot->layers[layer].count : gui_system.widgets[layer].count;
+        vec3_t offset = snapshot ? snapshot->layers[layer].offset : current_layer->offset;
         
-        if (!current_layer->visible) {
+        if (!visible || count == 0) {
+            gui_stale_layers |= dirty_layers & bit;
             continue;
         }
         
-        /* Render widgets in this layer */
-        for (int i = 0; i < gui_system.widget_count[layer]; i++) {
-            gui_widget_t *widget = gui_system.widgets[layer][i];
-            if (widget && widget->visible && widget->render) {
-                widget->render(widget);
-            }
+        /* Repaint cached surface only when its widgets changed */
+        int prepared = gui_prepare_layer_surface(current_layer, fb);
+        if (prepared < 0) {
+            gui_render_layer_widgets(layer, snapshot);
+            continue;
         }
+        
+        if (prepared > 0 || (dirty_layers & bit)) {
+            uint32_t *screen = fb_set_render_target(current_layer->surface);
+            memset(current_layer->surface, 0, fb->width * fb->height * sizeof(uint32_t));
+            gui_render_layer_widgets(layer, snapshot);
+            fb_set_render_target(screen);
+        }
+        
+        /* Camera moves only shift where the surface lands */
+        gui_composite_layer(current_layer, fb, (int32_t)offset.x, (int32_t)offset.y);
     }
     
+    /* Client surfaces land above the GUI; the scene beneath was just redrawn */
+    compositor_render(true);
+    perf_stage_end(PERF_STAGE_WIDGETS);
+    
+    /* Frame profiler overlay sits above all layers */
+    perf_overlay_render();
+    
     /* Render debug information if enabled */
     #ifdef GUI_DEBUG
     gui_render_debug_info();
     #endif
 }
 
+/* Render GUI System directly from live widget state */
+void gui_render(void) {
+    if (!gui_initialized) {
+        return;
+    }
+    
+    gui_render_snapshot(NULL, gui_take_dirty_layers());
+}
+
 /* Create Widget */
 gui_widget_t *gui_create_widget(widget_type_t type, const char *name, rect_t bounds, gui_layer_type_t layer) {
     if (!gui_initialized) {
         return NULL;
     }
     
-    /* Check layer capacity */
-    if (gui_system.widget_count[layer] >= MAX_WIDGETS_PER_LAYER) {
+    if (layer >= MAX_GUI_LAYERS) {
         return NULL;
     }
     
@@ -237,7 +648,8 @@ void gui_destroy_widget(gui_widget_t *widget) {
         return;
     }
     
-    /* Remove from layer */
+    /* Drop it from the animation timeline and its layer */
+    gui_stop_animation(widget);
     gui_remove_widget(widget);
     
     /* Free widget-specific data */
@@ -256,18 +668,26 @@ void gui_add_widget(gui_widget_t *widget) {
     }
     
     int layer = widget->layer;
-    if (layer >= MAX_GUI_LAYERS || gui_system.widget_count[layer] >= MAX_WIDGETS_PER_LAYER) {
+    if (layer >= MAX_GUI_LAYERS || widget->indexed) {
+        return;
+    }
+    
+    /* Append keeps render order (back to front) */
+    gui_widget_list_t *list = &gui_system.widgets[layer];
+    if (gui_list_append(list, widget, GUI_WIDGET_INITIAL_CAPACITY) != 0) {
+        serial_puts("[NEURAL-GUI] Out of memory growing widget layer\n");
         return;
     }
+    widget->layer_index = list->count - 1;
     
-    /* Add to layer */
-    gui_system.widgets[layer][gui_system.widget_count[layer]] = widget;
-    gui_system.widget_count[layer]++;
+    gui_grid_insert(&gui_system.grids[layer], widget);
+    gui_system.layers[layer].dirty = true;
+    gui_system.layout_generation++;
 }
 
 /* Remove Widget from System */
 void gui_remove_widget(gui_widget_t *widget) {
-    if (!widget || !gui_initialized) {
+    if (!widget || !gui_initialized || !widget->indexed) {
         return;
     }
     
@@ -276,73 +696,275 @@ void gui_remove_widget(gui_widget_t *widget) {
         return;
     }
     
-    /* Find and remove widget */
-    for (int i = 0; i < gui_system.widget_count[layer]; i++) {
-        if (gui_system.widgets[layer][i] == widget) {
-            /* Shift remaining widgets */
-            for (int j = i; j < gui_system.widget_count[layer] - 1; j++) {
-                gui_system.widgets[layer][j] = gui_system.widgets[layer][j + 1];
-            }
-            gui_system.widget_count[layer]--;
-            break;
-        }
+    gui_widget_list_t *list = &gui_system.widgets[layer];
+    uint32_t index = widget->layer_index;
+    if (index >= list->count || list->items[index] != widget) {
+        return;
     }
+    
+    gui_grid_remove(&gui_system.grids[layer], widget);
+    
+    /* Close the gap, preserving render order */
+    for (uint32_t j = index; j + 1 < list->count; j++) {
+        list->items[j] = list->items[j + 1];
+        list->items[j]->layer_index = j;
+    }
+    list->count--;
+    
+    if (gui_system.hovered_widget == widget) {
+        gui_system.hovered_widget = NULL;
+    }
+    if (gui_system.focused_widget == widget) {
+        gui_system.focused_widget = NULL;
+    }
+    
+    gui_system.layers[layer].dirty = true;
+    gui_system.layout_generation++;
 }
 
-/* Find Widget by Name */
-gui_widget_t *gui_find_widget(const char *name) {
-    if (!name || !gui_initialized) {
+/* Move/resize a widget and keep the spatial index in sync */
+void gui_set_widget_bounds(gui_widget_t *widget, rect_t bounds) {
+    if (!widget) {
+        return;
+    }
+    
+    widget->bounds = bounds;
+    if (widget->indexed) {
+        gui_reindex_widget(widget);
+    }
+    gui_invalidate_widget(widget);
+}
+
+/* Top-most visible interactive widget under a screen point */
+gui_widget_t *gui_widget_at(point2d_t point) {
+    if (!gui_initialized) {
         return NULL;
     }
     
-    for (int layer = 0; layer < MAX_GUI_LAYERS; layer++) {
-        for (int i = 0; i < gui_system.widget_count[layer]; i++) {
-            gui_widget_t *widget = gui_system.widgets[layer][i];
-            if (widget && strcmp(widget->name, name) == 0) {
-                return widget;
+    for (int layer = MAX_GUI_LAYERS - 1; layer >= 0; layer--) {
+        gui_layer_t *current_layer = &gui_system.layers[layer];
+        if (!current_layer->visible || !current_layer->interactive) {
+            continue;
+        }
+        
+        /* Undo the parallax shift applied at composition */
+        point2d_t local = {point.x - (int32_t)current_layer->offset.x,
+                           point.y - (int32_t)current_layer->offset.y};
+        
+        gui_widget_list_t *cell = gui_grid_cell_at(&gui_system.grids[layer], local);
+        if (!cell) {
+            continue;
+        }
+        
+        gui_widget_t *best = NULL;
+        for (uint32_t i = 0; i < cell->count; i++) {
+            gui_widget_t *widget = cell->items[i];
+            if (!widget->visible || !widget->interactive || !gui_point_in_rect(local, widget->bounds)) {
+                continue;
+            }
+            if (!best || widget->layer_index > best->layer_index) {
+                best = widget;
             }
         }
+        
+        if (best) {
+            return best;
+        }
     }
     
     return NULL;
 }
 
-/* Update Animations */
-void gui_update_animations(uint32_t delta_ms) {
-    for (int layer = 0; layer < MAX_GUI_LAYERS; layer++) {
-        for (int i = 0; i < gui_system.widget_count[layer]; i++) {
-            gui_widget_t *widget = gui_system.widgets[layer][i];
-            if (!widget || !widget->animation.active) {
+/* Collect widgets of a layer overlapping an area (damage lookups) */
+uint32_t gui_query_widgets(gui_layer_type_t layer, rect_t area, gui_widget_t **out, uint32_t max) {
+    if (!gui_initialized || layer >= MAX_GUI_LAYERS || !out || max == 0) {
+        return 0;
+    }
+    
+    gui_spatial_grid_t *grid = &gui_system.grids[layer];
+    uint32_t c0, r0, c1, r1;
+    if (!gui_grid_cell_range(grid, area, &c0, &r0, &c1, &r1)) {
+        return 0;
+    }
+    
+    uint32_t stamp = ++gui_system.query_stamp;
+    uint32_t found = 0;
+    
+    for (uint32_t r = r0; r <= r1; r++) {
+        for (uint32_t c = c0; c <= c1; c++) {
+            gui_widget_list_t *cell = &grid->cells[r * grid->cols + c];
+            for (uint32_t i = 0; i < cell->count; i++) {
+                gui_widget_t *widget = cell->items[i];
+                if (widget->query_stamp == stamp || !gui_rect_overlap(area, widget->bounds)) {
+                    continue;
+                }
+                widget->query_stamp = stamp;
+                out[found++] = widget;
+                if (found == max) {
+                    return found;
+                }
+            }
+        }
+    }
+    
+    return found;
+}
+
+/* Interactive widgets in reading order (top-to-bottom, left-to-right) */
+uint32_t gui_collect_tab_order(gui_widget_t **out, uint32_t max) {
+    if (!gui_initialized || !out) {
+        return 0;
+    }
+    
+    uint32_t found = 0;
+    
+    /* Each widget is owned by the grid row holding its top-left corner */
+    for (uint32_t r = 0; r < gui_system.grids[0].rows && found < max; r++) {
+        uint32_t band_start = found;
+        
+        for (int layer = 0; layer < MAX_GUI_LAYERS; layer++) {
+            gui_spatial_grid_t *grid = &gui_system.grids[layer];
+            if (!gui_system.layers[layer].interactive || !grid->cells) {
                 continue;
             }
             
-            animation_t *anim = &widget->animation;
-            anim->elapsed_ms += delta_ms;
-            
-            /* Calculate progress */
-            if (anim->duration_ms > 0) {
-                anim->progress = (float)anim->elapsed_ms / (float)anim->duration_ms;
-                if (anim->progress > 1.0f) {
-                    anim->progress = 1.0f;
+            for (uint32_t c = 0; c < grid->cols && found < max; c++) {
+                gui_widget_list_t *cell = &grid->cells[r * grid->cols + c];
+                for (uint32_t i = 0; i < cell->count && found < max; i++) {
+                    gui_widget_t *widget = cell->items[i];
+                    uint32_t owner_c, owner_r, last_c, last_r;
+                    if (!widget->visible || !widget->interactive ||
+                        !gui_grid_cell_range(grid, widget->indexed_bounds, &owner_c, &owner_r, &last_c, &last_r) ||
+                        owner_c != c || owner_r != r) {
+                        continue;
+                    }
+                    out[found++] = widget;
                 }
-            } else {
-                anim->progress = 1.0f;
             }
+        }
+        
+        /* Order this band by y then x (bands are small) */
+        for (uint32_t i = band_start + 1; i < found; i++) {
+            gui_widget_t *widget = out[i];
+            uint32_t j = i;
+            while (j > band_start &&
+                   (out[j - 1]->bounds.y > widget->bounds.y ||
+                    (out[j - 1]->bounds.y == widget->bounds.y && out[j - 1]->bounds.x > widget->bounds.x))) {
+                out[j] = out[j - 1];
+                j--;
+            }
+            out[j] = widget;
+        }
+    }
+    
+    return found;
+}
+
+uint32_t gui_get_widget_count(void) {
+    uint32_t total = 0;
+    
+    for (int layer = 0; layer < MAX_GUI_LAYERS; layer++) {
+        total += gui_system.widgets[layer].count;
+    }
+    return total;
+}
+
+uint32_t gui_get_layout_generation(void) {
+    return gui_system.layout_generation;
+}
+
+/* Route mouse hover and clicks to the widget under the pointer */
+void gui_handle_input(void) {
+    if (!gui_initialized) {
+        return;
+    }
+    
+    int32_t mouse_x, mouse_y;
+    input_get_mouse_position(&mouse_x, &mouse_y);
+    bool left_pressed = input_is_mouse_button_pressed(MOUSE_BUTTON_LEFT);
+    
+    point2d_t pos = {mouse_x, mouse_y};
+    bool moved = pos.x != gui_system.mouse_pos.x || pos.y != gui_system.mouse_pos.y;
+    bool clicked = left_pressed && !gui_system.mouse_buttons[0];
+    gui_system.mouse_pos = pos;
+    gui_system.mouse_buttons[0] = left_pressed;
+    
+    if (!moved && !clicked) {
+        return;
+    }
+    
+    gui_widget_t *target = gui_widget_at(pos);
+    
+    /* Hover tracking */
+    if (target != gui_system.hovered_widget) {
+        if (gui_system.hovered_widget && gui_system.hovered_widget->state == WIDGET_STATE_HOVER) {
+            gui_system.hovered_widget->state = WIDGET_STATE_NORMAL;
+            gui_invalidate_widget(gui_system.hovered_widget);
+        }
+        if (target && target->state == WIDGET_STATE_NORMAL) {
+            target->state = WIDGET_STATE_HOVER;
+            gui_invalidate_widget(target);
+        }
+        gui_system.hovered_widget = target;
+    }
+    
+    /* Click dispatch */
+    if (clicked && target) {
+        gui_system.focused_widget = target;
+        if (target->on_click) {
+            target->state = WIDGET_STATE_ACTIVE;
+            target->on_click(target);
+            perf_latency_record(PERF_LATENCY_WIDGET, input_get_pointer_tsc());
             
-            /* Check if animation is complete */
-            if (anim->progress >= 1.0f) {
-                if (anim->loop) {
-                    anim->elapsed_ms = 0;
-                    anim->progress = 0.0f;
-                } else {
-                    anim->active = false;
-                    if (anim->on_complete) {
-                        anim->on_complete(widget);
-                    }
-                }
+            /* Handlers may restyle any widget (labels, alarms) */
+            gui_invalidate_all();
+        }
+    }
+}
+
+/* Mark a layer surface for repaint */
+void gui_invalidate_layer(gui_layer_type_t layer) {
+    if (!gui_initialized || layer >= MAX_GUI_LAYERS) {
+        return;
+    }
+    
+    gui_system.layers[layer].dirty = true;
+}
+
+void gui_invalidate_widget(gui_widget_t *widget) {
+    if (!widget) {
+        return;
+    }
+    
+    gui_invalidate_layer(widget->layer);
+}
+
+void gui_invalidate_all(void) {
+    if (!gui_initialized) {
+        return;
+    }
+    
+    for (int i = 0; i < MAX_GUI_LAYERS; i++) {
+        gui_system.layers[i].dirty = true;
+    }
+}
+
+/* Find Widget by Name */
+gui_widget_t *gui_find_widget(const char *name) {
+    if (!name || !gui_initialized) {
+        return NULL;
+    }
+    
+    for (int layer = 0; layer < MAX_GUI_LAYERS; layer++) {
+        for (uint32_t i = 0; i < gui_system.widgets[layer].count; i++) {
+            gui_widget_t *widget = gui_system.widgets[layer].items[i];
+            if (widget && strcmp(widget->name, name) == 0) {
+                return widget;
             }
         }
     }
+    
+    return NULL;
 }
 
 /* Color Interpolation */
@@ -400,6 +1022,18 @@ void gui_move_camera(vec3_t delta) {
     gui_system.camera_velocity.z += delta.z;
 }
 
+/* Scale all parallax motion (1.0 = full depth, 0.0 = flat) */
+void gui_set_parallax_strength(float strength) {
+    if (strength < 0.0f) strength = 0.0f;
+    if (strength > 1.0f) strength = 1.0f;
+    gui_system.parallax_strength = strength;
+}
+
+/* Advance animations every Nth update step with the accumulated time */
+void gui_set_animation_divisor(uint32_t divisor) {
+    gui_system.animation_divisor = divisor ? divisor : 1;
+}
+
 /* Enable Reduced Motion */
 void gui_enable_reduced_motion(bool enable) {
     if (!gui_initialized) {
@@ -48,6 +48,8 @@ typedef struct {
     gui_widget_t **tab_order;
     uint32_t tab_order_count;
     uint32_t current_tab_index;
+    uint32_t tab_order_generation;  /* GUI layout generation the order was built from */
+    bool tab_order_built;
     
     /* Color and Contrast */
     float contrast_ratio;
@@ -283,6 +285,8 @@ void accessibility_build_tab_order(gui_widget_t **widgets, uint32_t widget_count
     /* Free existing tab order */
     if (accessibility.tab_order) {
         kfree(accessibility.tab_order);
+        accessibility.tab_order = NULL;
+        accessibility.tab_order_count = 0;
     }
     
     /* Count interactive widgets */
@@ -305,7 +309,7 @@ void accessibility_build_tab_order(gui_widget_t **widgets, uint32_t widget_count
         return;
     }
     
-    /* Build tab order (left-to-right, top-to-bottom) */
+    /* Caller supplies widgets in reading order (see gui_collect_tab_order) */
     uint32_t tab_index = 0;
     for (uint32_t i = 0; i < widget_count; i++) {
         gui_widget_t *widget = widgets[i];
@@ -322,8 +326,58 @@ void accessibility_build_tab_order(gui_widget_t **widgets, uint32_t widget_count
     serial_puts(" interactive widgets\n");
 }
 
+/* Rebuild tab order from the GUI spatial index (reading order) */
+void accessibility_rebuild_tab_order(void) {
+    if (!accessibility.initialized) {
+        return;
+    }
+    
+    gui_widget_t *previous_focus = accessibility.focused_widget;
+    uint32_t total = gui_get_widget_count();
+    gui_widget_t **ordered = NULL;
+    uint32_t count = 0;
+    
+    if (total > 0) {
+        ordered = (gui_widget_t **)kmalloc(total * sizeof(gui_widget_t *));
+        if (!ordered) {
+            return;
+        }
+        count = gui_collect_tab_order(ordered, total);
+    }
+    
+    accessibility_build_tab_order(ordered, count);
+    if (ordered) {
+        kfree(ordered);
+    }
+    
+    accessibility.tab_order_generation = gui_get_layout_generation();
+    accessibility.tab_order_built = true;
+    
+    /* Keep focus on the same widget if it survived the layout change */
+    accessibility.focused_widget = NULL;
+    for (uint32_t i = 0; i < accessibility.tab_order_count; i++) {
+        if (accessibility.tab_order[i] == previous_focus) {
+            accessibility.focused_widget = previous_focus;
+            accessibility.current_tab_index = i;
+            break;
+        }
+    }
+}
+
+/* Lazily refresh tab order when widgets were added, removed or moved */
+static void accessibility_sync_tab_order(void) {
+    if (!accessibility.tab_order_built ||
+        accessibility.tab_order_generation != gui_get_layout_generation()) {
+        accessibility_rebuild_tab_order();
+    }
+}
+
 /* Navigate to Next Widget */
 void accessibility_tab_next(void) {
+    if (accessibility.initialized) {
+        accessibility_sync_tab_order();
+    }
+    
     if (!accessibility.initialized || !accessibility.keyboard_navigation_enabled ||
         !accessibility.tab_order || accessibility.tab_order_count == 0) {
         return;
@@ -332,6 +386,7 @@ void accessibility_tab_next(void) {
     /* Remove focus from current widget */
     if (accessibility.focused_widget) {
         accessibility.focused_widget->state = WIDGET_STATE_NORMAL;
+        gui_invalidate_widget(accessibility.focused_widget);
     }
     
     /* Move to next widget */
@@ -341,11 +396,16 @@ void accessibility_tab_next(void) {
     /* Set focus state */
     if (accessibility.focused_widget) {
         accessibility.focused_widget->state = WIDGET_STATE_HOVER; /* Use hover as focus indicator */
+        gui_invalidate_widget(accessibility.focused_widget);
     }
 }
 
 /* Navigate to Previous Widget */
 void accessibility_tab_previous(void) {
+    if (accessibility.initialized) {
+        accessibility_sync_tab_order();
+    }
+    
     if (!accessibility.initialized || !accessibility.keyboard_navigation_enabled ||
         !accessibility.tab_order || accessibility.tab_order_count == 0) {
         return;
@@ -354,6 +414,7 @@ void accessibility_tab_previous(void) {
     /* Remove focus from current widget */
     if (accessibility.focused_widget) {
         accessibility.focused_widget->state = WIDGET_STATE_NORMAL;
+        gui_invalidate_widget(accessibility.focused_widget);
     }
     
     /* Move to previous widget */
@@ -367,6 +428,7 @@ void accessibility_tab_previous(void) {
     /* Set focus state */
     if (accessibility.focused_widget) {
         accessibility.focused_widget->state = WIDGET_STATE_HOVER;
+        gui_invalidate_widget(accessibility.focused_widget);
     }
 }
 
@@ -383,6 +445,9 @@ void accessibility_activate_focused_widget(void) {
         widget->state = WIDGET_STATE_ACTIVE;
         widget->on_click(widget);
         
+        /* Handlers may restyle any widget (labels, alarms) */
+        gui_invalidate_all();
+        
         /* Provide audio feedback if enabled */
         if (accessibility.sound_feedback_enabled) {
             /* Beep sound would go here */
@@ -451,6 +516,7 @@ void accessibility_handle_input_event(input_event_t *event) {
                         /* Clear focus */
                         if (accessibility.focused_widget) {
                             accessibility.focused_widget->state = WIDGET_STATE_NORMAL;
+                            gui_invalidate_widget(accessibility.focused_widget);
                             accessibility.focused_widget = NULL;
                         }
                         break;
@@ -10,6 +10,8 @@
 #include "kernel/gui.h"
 #include "kernel/framebuffer.h"
 #include "kernel/memory.h"
+#include "kernel/effects.h"
+#include "kernel/particles.h"
 
 /* External functions */
 extern void serial_puts(const char *s);
@@ -84,19 +86,125 @@ static float (*get_easing_function(animation_type_t type))(float) {
     }
 }
 
+/* Active Animation - completion time on the timeline clock */
+typedef struct {
+    gui_widget_t *widget;
+    uint64_t end_ms;
+} gui_active_animation_t;
+
+/* Animation Timeline - only running animations, sorted by end time
+ * descending so the next completions pop off the tail.
+ */
+static struct {
+    gui_active_animation_t *entries;
+    uint32_t count;
+    uint32_t capacity;
+    uint64_t now_ms;
+} timeline;
+
+/* Easing curves sampled once per animation type */
+static float easing_tables[ANIM_MATRIX_FLOW + 1][GUI_EASING_STEPS + 1];
+static bool easing_tables_built = false;
+
+static void build_easing_tables(void) {
+    for (int type = 0; type <= ANIM_MATRIX_FLOW; type++) {
+        float (*easing_func)(float) = get_easing_function((animation_type_t)type);
+        for (int i = 0; i <= GUI_EASING_STEPS; i++) {
+            easing_tables[type][i] = easing_func((float)i / GUI_EASING_STEPS);
+        }
+    }
+    easing_tables_built = true;
+}
+
+/* Eased progress from the table, linearly interpolated */
+float gui_ease(animation_type_t type, float t) {
+    if (!easing_tables_built) {
+        build_easing_tables();
+    }
+    if (type > ANIM_MATRIX_FLOW) {
+        type = ANIM_NONE;
+    }
+    if (t <= 0.0f) return easing_tables[type][0];
+    if (t >= 1.0f) return easing_tables[type][GUI_EASING_STEPS];
+    
+    float pos = t * GUI_EASING_STEPS;
+    uint32_t i = (uint32_t)pos;
+    float frac = pos - (float)i;
+    const float *curve = easing_tables[type];
+    return curve[i] + (curve[i + 1] - curve[i]) * frac;
+}
+
+/* Insert keeping end times descending */
+static int timeline_insert(gui_widget_t *widget, uint64_t end_ms) {
+    if (timeline.count == timeline.capacity) {
+        uint32_t capacity = timeline.capacity ? timeline.capacity * 2 : GUI_ANIMATION_INITIAL_CAPACITY;
+        gui_active_animation_t *entries = (gui_active_animation_t *)krealloc(timeline.entries,
+                                                                             capacity * sizeof(gui_active_animation_t));
+        if (!entries) {
+            return -1;
+        }
+        timeline.entries = entries;
+        timeline.capacity = capacity;
+    }
+    
+    /* Binary search for the first entry ending before this one */
+    uint32_t lo = 0;
+    uint32_t hi = timeline.count;
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        if (timeline.entries[mid].end_ms >= end_ms) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    
+    memmove(&timeline.entries[lo + 1], &timeline.entries[lo],
+            (timeline.count - lo) * sizeof(gui_active_animation_t));
+    timeline.entries[lo].widget = widget;
+    timeline.entries[lo].end_ms = end_ms;
+    timeline.count++;
+    return 0;
+}
+
+static void timeline_remove(gui_widget_t *widget) {
+    for (uint32_t i = 0; i < timeline.count; i++) {
+        if (timeline.entries[i].widget == widget) {
+            memmove(&timeline.entries[i], &timeline.entries[i + 1],
+                    (timeline.count - i - 1) * sizeof(gui_active_animation_t));
+            timeline.count--;
+            return;
+        }
+    }
+}
+
 /* Start Animation */
 void gui_start_animation(gui_widget_t *widget, animation_type_t type, uint32_t duration_ms, bool loop) {
     if (!widget) {
         return;
     }
     
+    if (!easing_tables_built) {
+        build_easing_tables();
+    }
+    
+    /* Restarting replaces any running animation */
+    if (widget->animation.active) {
+        timeline_remove(widget);
+    }
+    
     animation_t *anim = &widget->animation;
     anim->type = type;
     anim->duration_ms = duration_ms;
     anim->elapsed_ms = 0;
     anim->progress = 0.0f;
-    anim->active = true;
+    anim->eased = gui_ease(type, 0.0f);
     anim->loop = loop;
+    anim->active = timeline_insert(widget, timeline.now_ms + duration_ms) == 0;
+    
+    if (anim->active) {
+        gui_invalidate_widget(widget);
+    }
 }
 
 /* Stop Animation */
@@ -105,8 +213,65 @@ void gui_stop_animation(gui_widget_t *widget) {
         return;
     }
     
+    if (widget->animation.active) {
+        timeline_remove(widget);
+        gui_invalidate_widget(widget);
+    }
+    
     widget->animation.active = false;
     widget->animation.progress = 0.0f;
+    widget->animation.eased = 0.0f;
+}
+
+/* Advance the timeline - idle UIs return before touching any widget */
+void gui_update_animations(uint32_t delta_ms) {
+    if (timeline.count == 0) {
+        return;
+    }
+    
+    timeline.now_ms += delta_ms;
+    
+    /* Progress and easing for every running animation in one pass */
+    for (uint32_t i = 0; i < timeline.count; i++) {
+        gui_widget_t *widget = timeline.entries[i].widget;
+        animation_t *anim = &widget->animation;
+        uint64_t end_ms = timeline.entries[i].end_ms;
+        
+        if (anim->duration_ms == 0 || end_ms <= timeline.now_ms) {
+            anim->elapsed_ms = anim->duration_ms;
+            anim->progress = 1.0f;
+        } else {
+            anim->elapsed_ms = anim->duration_ms - (uint32_t)(end_ms - timeline.now_ms);
+            anim->progress = (float)anim->elapsed_ms / (float)anim->duration_ms;
+        }
+        anim->eased = gui_ease(anim->type, anim->progress);
+        
+        gui_invalidate_widget(widget);
+    }
+    
+    /* Completions are at the tail */
+    while (timeline.count > 0 && timeline.entries[timeline.count - 1].end_ms <= timeline.now_ms) {
+        gui_active_animation_t done = timeline.entries[--timeline.count];
+        animation_t *anim = &done.widget->animation;
+        
+        if (anim->loop && anim->duration_ms > 0) {
+            /* Keep phase across long frames */
+            uint32_t overshoot = (uint32_t)((timeline.now_ms - done.end_ms) % anim->duration_ms);
+            anim->elapsed_ms = overshoot;
+            anim->progress = (float)overshoot / (float)anim->duration_ms;
+            anim->eased = gui_ease(anim->type, anim->progress);
+            timeline_insert(done.widget, timeline.now_ms + anim->duration_ms - overshoot);
+        } else {
+            anim->active = false;
+            if (anim->on_complete) {
+                anim->on_complete(done.widget);
+            }
+        }
+    }
+}
+
+uint32_t gui_get_active_animation_count(void) {
+    return timeline.count;
 }
 
 /* Apply Animation Effects */
@@ -116,8 +281,7 @@ void gui_apply_animation_effects(gui_widget_t *widget) {
     }
     
     animation_t *anim = &widget->animation;
-    float (*easing_func)(float) = get_easing_function(anim->type);
-    float eased_progress = easing_func(anim->progress);
+    float eased_progress = anim->eased;
     
     framebuffer_device_t *fb = framebuffer_get_device();
     if (!fb) {
@@ -210,140 +374,9 @@ void gui_apply_animation_effects(gui_widget_t *widget) {
     }
 }
 
-/* Neural Particle System */
-typedef struct {
-    float x, y, z;
-    float vx, vy, vz;
-    float life;
-    float max_life;
-    uint32_t color;
-    bool active;
-} neural_particle_t;
-
-#define MAX_PARTICLES 100
-static neural_particle_t particles[MAX_PARTICLES];
-static bool particle_system_initialized = false;
-
-/* Initialize Particle System */
-void neural_particle_system_init(void) {
-    if (particle_system_initialized) {
-        return;
-    }
-    
-    memset(particles, 0, sizeof(particles));
-    particle_system_initialized = true;
-    
-    serial_puts("[NEURAL-ANIM] Particle system initialized\n");
-}
-
-/* Spawn Neural Particle */
-void neural_spawn_particle(float x, float y, float z, uint32_t color) {
-    if (!particle_system_initialized) {
-        neural_particle_system_init();
-    }
-    
-    /* Find inactive particle */
-    for (int i = 0; i < MAX_PARTICLES; i++) {
-        if (!particles[i].active) {
-            neural_particle_t *p = &particles[i];
-            
-            p->x = x;
-            p->y = y;
-            p->z = z;
-            p->vx = ((float)(rand() % 200) - 100.0f) / 100.0f;
-            p->vy = ((float)(rand() % 200) - 100.0f) / 100.0f;
-            p->vz = ((float)(rand() % 100)) / 100.0f;
-            p->life = 2.0f + ((float)(rand() % 100)) / 100.0f;
-            p->max_life = p->life;
-            p->color = color;
-            p->active = true;
-            break;
-        }
-    }
-}
-
-/* Update Particle System */
-void neural_particle_system_update(float delta_time) {
-    if (!particle_system_initialized) {
-        return;
-    }
-    
-    for (int i = 0; i < MAX_PARTICLES; i++) {
-        neural_particle_t *p = &particles[i];
-        
-        if (!p->active) {
-            continue;
-        }
-        
-        /* Update position */
-        p->x += p->vx * delta_time;
-        p->y += p->vy * delta_time;
-        p->z += p->vz * delta_time;
-        
-        /* Update life */
-        p->life -= delta_time;
-        
-        if (p->life <= 0.0f) {
-            p->active = false;
-        }
-    }
-}
-
-/* Render Particle System */
-void neural_particle_system_render(void) {
-    if (!particle_system_initialized) {
-        return;
-    }
-    
-    framebuffer_device_t *fb = framebuffer_get_device();
-    if (!fb) {
-        return;
-    }
-    
-    for (int i = 0; i < MAX_PARTICLES; i++) {
-        neural_particle_t *p = &particles[i];
-        
-        if (!p->active) {
-            continue;
-        }
-        
-        /* Calculate alpha based on life */
-        float life_ratio = p->life / p->max_life;
-        uint8_t alpha = (uint8_t)(255.0f * life_ratio);
-        
-        /* Extract color components */
-        uint8_t r = (p->color >> 16) & 0xFF;
-        uint8_t g = (p->color >> 8) & 0xFF;
-        uint8_t b = p->color & 0xFF;
-        
-        uint32_t particle_color = fb_color_from_rgba(r, g, b, alpha);
-        
-        /* Render particle */
-        int32_t screen_x = (int32_t)p->x;
-        int32_t screen_y = (int32_t)p->y;
-        
-        if (screen_x >= 0 && screen_x < (int32_t)fb->width &&
-            screen_y >= 0 && screen_y < (int32_t)fb->height) {
-            fb_put_pixel(screen_x, screen_y, particle_color);
-        }
-    }
-}
-
 /* Cyberpunk Scanline Effect */
 void cyberpunk_scanlines_effect(uint32_t intensity) {
-    framebuffer_device_t *fb = framebuffer_get_device();
-    if (!fb) {
-        return;
-    }
-    
-    uint32_t scanline_color = fb_color_from_rgba(0x00, 0xFF, 0xFF, intensity);
-    
-    /* Draw horizontal scanlines */
-    for (uint32_t y = 0; y < fb->height; y += 4) {
-        for (uint32_t x = 0; x < fb->width; x++) {
-            fb_put_pixel_alpha(x, y, scanline_color, intensity);
-        }
-    }
+    fb_cyberpunk_scanlines(intensity);
 }
 
 /* Neural Network Visualization */
@@ -353,71 +386,67 @@ void neural_network_effect(int32_t center_x, int32_t center_y, float time) {
         return;
     }
     
-    /* Draw neural nodes */
+    /* Rotation at 1 mrad/ms, pulse at 2 mrad/ms (LUT units) */
+    uint32_t rotation = effect_ms_to_angle((uint32_t)time, 1);
+    uint32_t pulse_phase = effect_ms_to_angle((uint32_t)time, 2);
+    int32_t node_x[8], node_y[8];
+    
+    /* Node positions from the fixed-point tables */
     for (int i = 0; i < 8; i++) {
-        float angle = (i * TWO_PI / 8.0f) + time * 0.001f;
-        int32_t node_x = center_x + (int32_t)(80.0f * cosf(angle));
-        int32_t node_y = center_y + (int32_t)(80.0f * sinf(angle));
-        
-        /* Pulsing node */
-        float pulse = 0.5f + 0.5f * sinf(time * 0.002f + i);
-        uint8_t intensity = (uint8_t)(128.0f + 127.0f * pulse);
+        uint32_t angle = i * (EFFECT_ANGLE_STEPS / 8) + rotation;
+        node_x[i] = center_x + ((80 * effect_cos(angle)) >> EFFECT_FIXED_SHIFT);
+        node_y[i] = center_y + ((80 * effect_sin(angle)) >> EFFECT_FIXED_SHIFT);
+    }
+    
+    uint32_t connection_color = fb_color_from_rgba(0x00, 0x80, 0xFF, 0x60);
+    
+    for (int i = 0; i < 8; i++) {
+        /* Pulsing node, phase offset of one radian per node */
+        int32_t pulse = effect_sin(pulse_phase + i * (EFFECT_ANGLE_STEPS * 1000 / 6283));
+        uint8_t intensity = (uint8_t)(192 + ((63 * pulse) >> EFFECT_FIXED_SHIFT));
         uint32_t node_color = fb_color_from_rgba(0x00, intensity, intensity, 0xFF);
         
-        fb_fill_circle(node_x, node_y, 5, node_color);
+        fb_fill_circle(node_x[i], node_y[i], 5, node_color);
         
         /* Draw connections */
         for (int j = i + 1; j < 8; j++) {
-            float other_angle = (j * TWO_PI / 8.0f) + time * 0.001f;
-            int32_t other_x = center_x + (int32_t)(80.0f * cosf(other_angle));
-            int32_t other_y = center_y + (int32_t)(80.0f * sinf(other_angle));
-            
-            uint32_t connection_color = fb_color_from_rgba(0x00, 0x80, 0xFF, 0x60);
-            fb_draw_line(node_x, node_y, other_x, other_y, connection_color);
+            fb_draw_line(node_x[i], node_y[i], node_x[j], node_y[j], connection_color);
         }
     }
     
     /* Central processing node */
-    float central_pulse = 0.3f + 0.7f * sinf(time * 0.003f);
-    uint8_t central_intensity = (uint8_t)(200.0f * central_pulse);
-    uint32_t central_color = fb_color_from_rgba(0xFF, central_intensity, 0x00, 0xFF);
+    int32_t central = effect_sin(effect_ms_to_angle((uint32_t)time, 3));
+    int32_t central_intensity = 60 + ((140 * central) >> EFFECT_FIXED_SHIFT);
+    if (central_intensity < 0) central_intensity = 0;
+    if (central_intensity > 255) central_intensity = 255;
+    uint32_t central_color = fb_color_from_rgba(0xFF, (uint8_t)central_intensity, 0x00, 0xFF);
     fb_fill_circle(center_x, center_y, 8, central_color);
 }
 
 /* Holographic Border Effect */
 void holographic_border_effect(rect_t bounds, float time) {
     framebuffer_device_t *fb = framebuffer_get_device();
-    if (!fb) {
+    if (!fb || bounds.width <= 0 || bounds.height <= 0) {
         return;
     }
     
-    /* Animated border colors */
-    float hue_shift = time * 0.001f;
+    /* Hue ring advances at 1 mrad/ms; palette is cached by the effect engine */
+    uint32_t hue_shift = effect_ms_to_angle((uint32_t)time, 1) / (EFFECT_ANGLE_STEPS / EFFECT_HUE_STEPS);
+    uint32_t hue_step_x = (EFFECT_HUE_STEPS << 16) / (uint32_t)bounds.width;
+    uint32_t hue_step_y = (EFFECT_HUE_STEPS << 16) / (uint32_t)bounds.height;
     
-    for (int32_t i = 0; i < bounds.width; i++) {
-        float progress = (float)i / (float)bounds.width;
-        float hue = hue_shift + progress * TWO_PI;
-        
-        uint8_t r = (uint8_t)(128.0f + 127.0f * sinf(hue));
-        uint8_t g = (uint8_t)(128.0f + 127.0f * sinf(hue + TWO_PI / 3.0f));
-        uint8_t b = (uint8_t)(128.0f + 127.0f * sinf(hue + 4.0f * TWO_PI / 3.0f));
-        
-        uint32_t color = fb_color_from_rgba(r, g, b, 0xFF);
+    uint32_t hue = 0;
+    for (int32_t i = 0; i < bounds.width; i++, hue += hue_step_x) {
+        uint32_t color = effect_hue_color(hue_shift + (hue >> 16));
         
         /* Top and bottom borders */
         fb_put_pixel(bounds.x + i, bounds.y, color);
         fb_put_pixel(bounds.x + i, bounds.y + bounds.height - 1, color);
     }
     
-    for (int32_t i = 0; i < bounds.height; i++) {
-        float progress = (float)i / (float)bounds.height;
-        float hue = hue_shift + progress * TWO_PI;
-        
-        uint8_t r = (uint8_t)(128.0f + 127.0f * sinf(hue));
-        uint8_t g = (uint8_t)(128.0f + 127.0f * sinf(hue + TWO_PI / 3.0f));
-        uint8_t b = (uint8_t)(128.0f + 127.0f * sinf(hue + 4.0f * TWO_PI / 3.0f));
-        
-        uint32_t color = fb_color_from_rgba(r, g, b, 0xFF);
+    hue = 0;
+    for (int32_t i = 0; i < bounds.height; i++, hue += hue_step_y) {
+        uint32_t color = effect_hue_color(hue_shift + (hue >> 16));
         
         /* Left and right borders */
         fb_put_pixel(bounds.x, bounds.y + i, color);
@@ -0,0 +1,266 @@
+/* gui_pipeline.c - Brandon Media OS Neural GUI Pipeline
+ * Fixed-Rate Simulation Feeding Double-Buffered Render Snapshots
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "kernel/gui_pipeline.h"
+#include "kernel/gui.h"
+#include "kernel/compositor.h"
+#include "kernel/input.h"
+#include "kernel/framebuffer.h"
+#include "kernel/perf.h"
+#include "kernel/quality.h"
+#include "kernel/tsc.h"
+
+/* External functions */
+extern void serial_puts(const char *s);
+extern void print_dec(uint64_t num);
+extern void scada_demo_update(void);
+
+/* Pipeline State
+ * The update stage owns live widgets and writes the back snapshot; the
+ * render stage only reads the published one. `reading` lets the writer
+ * skip a publish instead of overwriting a snapshot still being drawn.
+ */
+typedef struct {
+    gui_snapshot_t snapshots[2];
+    volatile uint32_t published;        /* Index of newest complete snapshot */
+    volatile uint32_t reading;          /* Index held by the renderer */
+    volatile uint32_t pending_dirty;    /* Layers invalidated since last render */
+    uint64_t seq;
+    
+    /* Update stage */
+    uint64_t next_step_us;
+    uint64_t input_tsc;                 /* Oldest input not yet in a snapshot */
+    
+    /* Render stage */
+    uint64_t last_render_us;
+    uint64_t rendered_seq;
+    
+    gui_pipeline_stats_t stats;
+} gui_pipeline_t;
+
+static gui_pipeline_t pipeline;
+static bool pipeline_initialized = false;
+
+/* Initialize pipeline with a first snapshot so the renderer never waits */
+int gui_pipeline_init(void) {
+    if (pipeline_initialized) {
+        return 0;
+    }
+    
+    memset(&pipeline, 0, sizeof(gui_pipeline_t));
+    pipeline.reading = GUI_PIPELINE_NO_READER;
+    
+    if (gui_capture_snapshot(&pipeline.snapshots[0]) != 0) {
+        serial_puts("[NEURAL-PIPE] Failed to capture initial snapshot\n");
+        gui_free_snapshot(&pipeline.snapshots[0]);
+        return -1;
+    }
+    
+    pipeline.seq = 1;
+    pipeline.snapshots[0].seq = pipeline.seq;
+    pipeline.published = 0;
+    pipeline.pending_dirty = gui_take_dirty_layers();
+    pipeline_initialized = true;
+    
+    serial_puts("[NEURAL-PIPE] Update stage at ");
+    print_dec(GUI_PIPELINE_UPDATE_HZ);
+    serial_puts("Hz, render from double-buffered snapshots\n");
+    return 0;
+}
+
+/* Shutdown pipeline */
+void gui_pipeline_shutdown(void) {
+    if (!pipeline_initialized) {
+        return;
+    }
+    
+    pipeline_initialized = false;
+    gui_free_snapshot(&pipeline.snapshots[0]);
+    gui_free_snapshot(&pipeline.snapshots[1]);
+}
+
+bool gui_pipeline_is_initialized(void) {
+    return pipeline_initialized;
+}
+
+/* Capture live state into the back snapshot and make it current */
+static void gui_pipeline_publish(void) {
+    uint32_t target = pipeline.published ^ 1;
+    
+    /* Renderer still drawing the back copy: keep invalidations for next time */
+    if (__atomic_load_n(&pipeline.reading, __ATOMIC_SEQ_CST) == target) {
+        pipeline.stats.snapshots_deferred++;
+        return;
+    }
+    
+    gui_snapshot_t *snapshot = &pipeline.snapshots[target];
+    if (gui_capture_snapshot(snapshot) != 0) {
+        pipeline.stats.snapshots_deferred++;
+        return;
+    }
+    
+    snapshot->seq = ++pipeline.seq;
+    snapshot->input_tsc = pipeline.input_tsc;
+    pipeline.input_tsc = 0;
+    __atomic_store_n(&pipeline.published, target, __ATOMIC_SEQ_CST);
+    
+    /* Hand over dirty layers only once the snapshot holding them is visible */
+    __atomic_fetch_or(&pipeline.pending_dirty, gui_take_dirty_layers(), __ATOMIC_SEQ_CST);
+    pipeline.stats.snapshots_published++;
+}
+
+/* Update Stage - input, GUI and SCADA simulation in fixed steps */
+void gui_pipeline_update_stage(uint64_t now_us) {
+    if (!pipeline_initialized) {
+        return;
+    }
+    
+    if (pipeline.next_step_us == 0) {
+        pipeline.next_step_us = now_us;
+    }
+    
+    uint32_t steps = 0;
+    while (now_us >= pipeline.next_step_us) {
+        if (steps == GUI_PIPELINE_MAX_CATCHUP) {
+            /* Too far behind: drop the backlog rather than spiral */
+            uint64_t behind = (now_us - pipeline.next_step_us) / GUI_PIPELINE_STEP_US + 1;
+            pipeline.stats.dropped_steps += behind;
+            pipeline.next_step_us += behind * GUI_PIPELINE_STEP_US;
+            break;
+        }
+        
+        uint64_t start = rdtsc();
+        perf_stage_begin(PERF_STAGE_UPDATE);
+        input_update();
+        gui_update(GUI_PIPELINE_STEP_US / 1000);
+        scada_demo_update();
+        perf_stage_end(PERF_STAGE_UPDATE);
+        
+        /* Carry input origins until a snapshot picks them up */
+        uint64_t input_tsc = input_take_pending_tsc();
+        if (input_tsc && (!pipeline.input_tsc || input_tsc < pipeline.input_tsc)) {
+            pipeline.input_tsc = input_tsc;
+        }
+        
+        pipeline.stats.last_update_us = (uint32_t)tsc_cycles_to_us(rdtsc() - start);
+        pipeline.stats.update_steps++;
+        pipeline.next_step_us += GUI_PIPELINE_STEP_US;
+        steps++;
+    }
+    
+    /* The renderer only ever wants the newest state */
+    if (steps) {
+        gui_pipeline_publish();
+    }
+}
+
+/* Pin the newest snapshot for reading */
+const gui_snapshot_t *gui_pipeline_acquire(void) {
+    for (;;) {
+        uint32_t index = __atomic_load_n(&pipeline.published, __ATOMIC_SEQ_CST);
+        __atomic_store_n(&pipeline.reading, index, __ATOMIC_SEQ_CST);
+        
+        /* Writer may have flipped before it saw our claim */
+        if (__atomic_load_n(&pipeline.published, __ATOMIC_SEQ_CST) == index) {
+            return &pipeline.snapshots[index];
+        }
+    }
+}
+
+void gui_pipeline_release(void) {
+    __atomic_store_n(&pipeline.reading, GUI_PIPELINE_NO_READER, __ATOMIC_SEQ_CST);
+}
+
+/* Render Stage - draw and present the newest snapshot when a frame is due */
+bool gui_pipeline_render_stage(uint64_t now_us) {
+    if (!pipeline_initialized) {
+        return false;
+    }
+    
+    if (now_us - pipeline.last_render_us < GUI_PIPELINE_RENDER_US) {
+        return false;
+    }
+    pipeline.last_render_us = now_us;
+    
+    uint64_t start = rdtsc();
+    
+    /* Take dirty bits before acquiring: they never outrun the snapshot */
+    uint32_t dirty = __atomic_exchange_n(&pipeline.pending_dirty, 0, __ATOMIC_SEQ_CST);
+    const gui_snapshot_t *snapshot = gui_pipeline_acquire();
+    
+    /* Input reaches the screen the first time its snapshot is presented */
+    uint64_t input_tsc = 0;
+    bool repeated = snapshot->seq == pipeline.rendered_seq && pipeline.stats.frames_rendered > 0;
+    if (repeated) {
+        pipeline.stats.frames_repeated++;
+    } else {
+        input_tsc = snapshot->input_tsc;
+    }
+    pipeline.rendered_seq = snapshot->seq;
+    
+    /* The back buffer persists, so an unchanged scene is left as it is and
+     * only client damage is refreshed on top of it
+     */
+    if (repeated && dirty == 0 && compositor_can_repair()) {
+        compositor_render(false);
+    } else {
+        gui_render_snapshot(snapshot, dirty);
+    }
+    gui_pipeline_release();
+    
+    perf_stage_begin(PERF_STAGE_PRESENT);
+    fb_swap_buffers();
+    perf_stage_end(PERF_STAGE_PRESENT);
+    perf_latency_record(PERF_LATENCY_PHOTON, input_tsc);
+    
+    pipeline.stats.last_render_us = (uint32_t)tsc_cycles_to_us(rdtsc() - start);
+    pipeline.stats.frames_rendered++;
+    
+    /* Render cost drives the detail level */
+    quality_governor_submit(pipeline.stats.last_render_us);
+    return true;
+}
+
+/* Render loop for a CPU dedicated to drawing */
+void gui_pipeline_render_loop(void) {
+    for (;;) {
+        if (!gui_pipeline_render_stage(tsc_get_us())) {
+            asm volatile("pause");
+        }
+    }
+}
+
+/* Drive both stages from one CPU (kernel main loop) */
+void gui_pipeline_poll(void) {
+    if (!pipeline_initialized) {
+        return;
+    }
+    
+    uint64_t now = tsc_get_us();
+    bool render_due = now - pipeline.last_render_us >= GUI_PIPELINE_RENDER_US;
+    
+    if (render_due) {
+        perf_frame_begin();
+    }
+    
+    gui_pipeline_update_stage(now);
+    
+    if (render_due) {
+        gui_pipeline_render_stage(now);
+        perf_frame_end();
+    }
+}
+
+/* Get pipeline statistics */
+void gui_pipeline_get_stats(gui_pipeline_stats_t *stats) {
+    if (!stats) {
+        return;
+    }
+    
+    *stats = pipeline.stats;
+}
@@ -29,6 +29,8 @@ typedef struct {
     bool has_border;
     uint32_t border_color;
     float border_thickness;
+    texture_t *texture;          /* Optional background (not owned) */
+    texture_filter_t filter;
 } panel_data_t;
 
 /* Label Widget Data */
@@ -86,6 +88,7 @@ gui_widget_t *gui_create_button(const char *name, rect_t bounds, const char *tex
     
     /* Set widget properties */
     widget->data = data;
+    widget->data_size = sizeof(*data);
     widget->render = render_button;
     widget->update = update_button;
     widget->on_click = callback;
@@ -118,6 +121,7 @@ gui_widget_t *gui_create_panel(const char *name, rect_t bounds, color_rgba_t bg_
     
     /* Set widget properties */
     widget->data = data;
+    widget->data_size = sizeof(*data);
     widget->render = render_panel;
     widget->bg_color = bg_color;
     widget->interactive = false;
@@ -148,6 +152,7 @@ gui_widget_t *gui_create_label(const char *name, rect_t bounds, const char *text
     
     /* Set widget properties */
     widget->data = data;
+    widget->data_size = sizeof(*data);
     widget->render = render_label;
     widget->color = (color_rgba_t)GUI_COLOR_NEURAL_WHITE;
     widget->interactive = false;
@@ -181,6 +186,7 @@ gui_widget_t *gui_create_scada_gauge(const char *name, rect_t bounds, float min_
     
     /* Set widget properties */
     widget->data = data;
+    widget->data_size = sizeof(*data);
     widget->render = render_scada_gauge;
     widget->update = update_scada_gauge;
     widget->color = (color_rgba_t)GUI_COLOR_NEURAL_CYAN;
@@ -221,6 +227,7 @@ gui_widget_t *gui_create_neural_matrix(const char *name, rect_t bounds, uint32_t
     
     /* Set widget properties */
     widget->data = data;
+    widget->data_size = sizeof(*data);
     widget->render = render_neural_matrix;
     widget->update = update_neural_matrix;
     widget->interactive = false;
@@ -253,6 +260,7 @@ gui_widget_t *gui_create_progress_bar(const char *name, rect_t bounds, const cha
     
     /* Set widget properties */
     widget->data = data;
+    widget->data_size = sizeof(*data);
     widget->render = render_progress_bar;
     widget->update = update_progress_bar;
     widget->interactive = false;
@@ -325,9 +333,14 @@ static void render_panel(gui_widget_t *widget) {
         return;
     }
     
-    /* Draw panel background */
-    uint32_t bg_color = fb_color_from_rgba(widget->bg_color.r, widget->bg_color.g, widget->bg_color.b, widget->bg_color.a);
-    fb_fill_rect(widget->bounds.x, widget->bounds.y, widget->bounds.width, widget->bounds.height, bg_color);
+    /* Draw panel background - textured panels sample the mip level matching their size */
+    if (data->texture) {
+        texture_draw_panel(data->texture, widget->bounds.x, widget->bounds.y,
+                           widget->bounds.width, widget->bounds.height, data->filter);
+    } else {
+        uint32_t bg_color = fb_color_from_rgba(widget->bg_color.r, widget->bg_color.g, widget->bg_color.b, widget->bg_color.a);
+        fb_fill_rect(widget->bounds.x, widget->bounds.y, widget->bounds.width, widget->bounds.height, bg_color);
+    }
     
     /* Draw border if enabled */
     if (data->has_border) {
@@ -491,6 +504,7 @@ static void update_button(gui_widget_t *widget, uint32_t delta_ms) {
             data->pressed = false;
             data->press_time = 0;
             widget->state = WIDGET_STATE_NORMAL;
+            gui_invalidate_widget(widget);
         }
     }
 }
@@ -502,6 +516,7 @@ static void update_scada_gauge(gui_widget_t *widget, uint32_t delta_ms) {
     float diff = data->target_value - data->current_value;
     if (fabsf(diff) > 0.01f) {
         data->current_value += diff * (delta_ms / 1000.0f) * 2.0f; /* 2 units per second */
+        gui_invalidate_widget(widget);
     }
 }
 
@@ -513,6 +528,7 @@ static void update_neural_matrix(gui_widget_t *widget, uint32_t delta_ms) {
     if (data->animation_phase > 360000) {
         data->animation_phase = 0;
     }
+    gui_invalidate_widget(widget);
 }
 
 static void update_progress_bar(gui_widget_t *widget, uint32_t delta_ms) {
@@ -522,6 +538,7 @@ static void update_progress_bar(gui_widget_t *widget, uint32_t delta_ms) {
     float diff = data->target_value - data->value;
     if (fabsf(diff) > 0.001f) {
         data->value += diff * (delta_ms / 1000.0f) * 2.0f; /* 2 units per second */
+        gui_invalidate_widget(widget);
     }
 }
 
@@ -546,7 +563,21 @@ void gui_set_gauge_alarm(gui_widget_t *gauge, bool critical) {
     }
     
     scada_gauge_data_t *data = (scada_gauge_data_t *)gauge->data;
-    data->critical_alarm = critical;
+    if (data->critical_alarm != critical) {
+        data->critical_alarm = critical;
+        gui_invalidate_widget(gauge);
+    }
+}
+
+void gui_set_panel_texture(gui_widget_t *panel, texture_t *texture, texture_filter_t filter) {
+    if (!panel || panel->type != WIDGET_PANEL || !panel->data) {
+        return;
+    }
+    
+    panel_data_t *data = (panel_data_t *)panel->data;
+    data->texture = texture;
+    data->filter = filter;
+    gui_invalidate_widget(panel);
 }
 
 void gui_set_progress_value(gui_widget_t *progress_bar, float value) {
@@ -6,58 +6,19 @@
 #include <stddef.h>
 #include "kernel/memory.h"
 #include "kernel/pci.h"
-
-/* Device Types */
-typedef enum {
-    DEVICE_TYPE_UNKNOWN = 0,
-    DEVICE_TYPE_NETWORK,
-    DEVICE_TYPE_STORAGE,
-    DEVICE_TYPE_DISPLAY,
-    DEVICE_TYPE_USB,
-    DEVICE_TYPE_AUDIO,
-    DEVICE_TYPE_INPUT
-} device_type_t;
-
-/* Device Status */
-typedef enum {
-    DEVICE_STATUS_UNKNOWN = 0,
-    DEVICE_STATUS_DETECTED,
-    DEVICE_STATUS_INITIALIZING,
-    DEVICE_STATUS_ACTIVE,
-    DEVICE_STATUS_ERROR,
-    DEVICE_STATUS_DISABLED
-} device_status_t;
-
-/* Generic Device Structure */
-struct hal_device {
-    uint32_t device_id;
-    device_type_t type;
-    device_status_t status;
-    const char *name;
-    const char *manufacturer;
-    
-    /* PCI device reference (if applicable) */
-    struct pci_device *pci_dev;
-    
-    /* Device-specific data */
-    void *device_data;
-    
-    /* Device operations */
-    int (*init)(struct hal_device *dev);
-    int (*start)(struct hal_device *dev);
-    int (*stop)(struct hal_device *dev);
-    int (*reset)(struct hal_device *dev);
-    void (*cleanup)(struct hal_device *dev);
-    
-    /* Linked list */
-    struct hal_device *next;
-};
+#include "kernel/hal.h"
+#include "kernel/smp.h"
+#include "kernel/tsc.h"
 
 /* Device Registry */
 static struct hal_device *device_registry = NULL;
 static uint32_t next_device_id = 1;
 static int device_count = 0;
 
+/* Probe Batch - wall-clock span of the last hal_initialize_all_devices() */
+static uint64_t probe_batch_start_tsc = 0;
+static uint64_t probe_batch_end_tsc = 0;
+
 /* External functions */
 extern void serial_puts(const char *s);
 extern void print_hex(uint64_t num);
@@ -112,6 +73,14 @@ struct hal_device *hal_create_device(device_type_t type, const char *name, const
     device->stop = NULL;
     device->reset = NULL;
     device->cleanup = NULL;
+    device->poll = NULL;
+    
+    device->dependency_count = 0;
+    device->probe_busy = 0;
+    device->probe_cpu = 0;
+    device->probe_start_tsc = 0;
+    device->probe_ready_tsc = 0;
+    device->probe_cycles = 0;
     
     device->next = NULL;
     
@@ -215,36 +184,156 @@ int hal_find_devices_by_type(device_type_t type, struct hal_device **devices, in
     return count;
 }
 
-/* Initialize a device */
+/* Record the outcome of an init/poll call */
+static void hal_probe_finish(struct hal_device *device, int result) {
+    if (result == HAL_PROBE_PENDING) {
+        if (tsc_cycles_to_us(rdtsc() - device->probe_start_tsc) < HAL_PROBE_TIMEOUT_US) {
+            return;
+        }
+        serial_puts("[NEURAL-HAL] Device probe timed out: ");
+        serial_puts(device->name);
+        serial_puts("\n");
+        result = -1;
+    }
+    
+    device->probe_ready_tsc = rdtsc();
+    device->status = result == 0 ? DEVICE_STATUS_ACTIVE : DEVICE_STATUS_ERROR;
+    
+    serial_puts(result == 0 ? "[NEURAL-HAL] Device ready: " : "[NEURAL-HAL] Device initialization failed: ");
+    serial_puts(device->name);
+    serial_puts(" (");
+    print_dec(tsc_cycles_to_us(device->probe_ready_tsc - device->probe_start_tsc));
+    serial_puts("us)\n");
+}
+
+/* Run one init or poll call on the calling CPU */
+static void hal_probe_call(struct hal_device *device, int (*op)(struct hal_device *dev)) {
+    uint64_t start = rdtsc();
+    int result = op ? op(device) : 0;
+    device->probe_cycles += rdtsc() - start;
+    
+    /* A pending device without a poll hook can never finish */
+    if (result == HAL_PROBE_PENDING && !device->poll) {
+        result = -1;
+    }
+    hal_probe_finish(device, result);
+}
+
+/* 1 = all dependencies active, 0 = still waiting, -1 = one failed */
+static int hal_dependencies_ready(struct hal_device *device) {
+    for (uint8_t i = 0; i < device->dependency_count; i++) {
+        device_status_t status = device->depends_on[i]->status;
+        if (status == DEVICE_STATUS_ERROR || status == DEVICE_STATUS_DISABLED) {
+            return -1;
+        }
+        if (status != DEVICE_STATUS_ACTIVE) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Advance one device if it can move; returns 1 when work was done */
+static int hal_probe_advance(struct hal_device *device) {
+    if (device->status != DEVICE_STATUS_DETECTED && device->status != DEVICE_STATUS_INITIALIZING) {
+        return 0;
+    }
+    
+    /* One CPU at a time per device; others move on to the next one */
+    if (__atomic_exchange_n(&device->probe_busy, 1, __ATOMIC_ACQUIRE)) {
+        return 0;
+    }
+    
+    int worked = 0;
+    if (device->status == DEVICE_STATUS_DETECTED) {
+        int ready = hal_dependencies_ready(device);
+        if (ready < 0) {
+            device->status = DEVICE_STATUS_ERROR;
+            serial_puts("[NEURAL-HAL] Dependency failed, skipping: ");
+            serial_puts(device->name);
+            serial_puts("\n");
+            worked = 1;
+        } else if (ready) {
+            device->status = DEVICE_STATUS_INITIALIZING;
+            device->probe_cpu = smp_get_current_cpu()->cpu_id;
+            device->probe_start_tsc = rdtsc();
+            device->probe_cycles = 0;
+            hal_probe_call(device, device->init);
+            worked = 1;
+        }
+    } else {
+        hal_probe_call(device, device->poll);
+        worked = 1;
+    }
+    
+    __atomic_store_n(&device->probe_busy, 0, __ATOMIC_RELEASE);
+    return worked;
+}
+
+/* Initialize a device, waiting for a split-phase probe to complete */
 int hal_initialize_device(uint32_t device_id) {
     struct hal_device *device = hal_find_device_by_id(device_id);
     if (!device) {
         return -1;
     }
     
-    device->status = DEVICE_STATUS_INITIALIZING;
-    
     serial_puts("[NEURAL-HAL] Initializing device: ");
     serial_puts(device->name);
     serial_puts("\n");
     
-    if (device->init) {
-        int result = device->init(device);
-        if (result == 0) {
-            device->status = DEVICE_STATUS_ACTIVE;
-            serial_puts("[NEURAL-HAL] Device initialization successful\n");
-        } else {
-            device->status = DEVICE_STATUS_ERROR;
-            serial_puts("[NEURAL-HAL] Device initialization failed\n");
+    if (device->status == DEVICE_STATUS_ACTIVE || device->status == DEVICE_STATUS_ERROR) {
+        device->status = DEVICE_STATUS_DETECTED;
+    }
+    
+    while (device->status == DEVICE_STATUS_DETECTED || device->status == DEVICE_STATUS_INITIALIZING) {
+        if (!hal_probe_advance(device)) {
+            if (device->status == DEVICE_STATUS_DETECTED && hal_dependencies_ready(device) == 0) {
+                return -1;  /* Dependencies are nobody's job here */
+            }
+            asm volatile("pause");
         }
-        return result;
     }
     
-    /* No init function, mark as active */
-    device->status = DEVICE_STATUS_ACTIVE;
+    return device->status == DEVICE_STATUS_ACTIVE ? 0 : -1;
+}
+
+/* Declare that `device` must not probe before `dependency` is active */
+int hal_add_dependency(struct hal_device *device, struct hal_device *dependency) {
+    if (!device || !dependency || device == dependency ||
+        device->dependency_count >= HAL_MAX_DEPENDENCIES) {
+        return -1;
+    }
+    
+    device->depends_on[device->dependency_count++] = dependency;
     return 0;
 }
 
+/* One pass over the registry on the calling CPU. Any CPU may call this
+ * concurrently; per-device claims keep each probe on one CPU at a time.
+ * Returns the number of devices still being probed; `progress` (optional)
+ * is set when this pass started or finished any device.
+ */
+int hal_probe_worker_step(bool *progress) {
+    int remaining = 0;
+    bool changed = false;
+    
+    for (struct hal_device *current = device_registry; current; current = current->next) {
+        device_status_t before = current->status;
+        hal_probe_advance(current);
+        if (current->status != before) {
+            changed = true;
+        }
+        if (current->status == DEVICE_STATUS_DETECTED || current->status == DEVICE_STATUS_INITIALIZING) {
+            remaining++;
+        }
+    }
+    
+    if (progress) {
+        *progress = changed;
+    }
+    return remaining;
+}
+
 /* Start a device */
 int hal_start_device(uint32_t device_id) {
     struct hal_device *device = hal_find_device_by_id(device_id);
@@ -424,15 +513,84 @@ int hal_get_device_count(void) {
     return device_count;
 }
 
-/* Initialize all registered devices */
+/* Initialize all registered devices. Independent devices overlap: every
+ * ready device is started, then pending ones are polled round-robin, so
+ * the batch takes about as long as the slowest device.
+ */
 void hal_initialize_all_devices(void) {
     serial_puts("[NEURAL-HAL] Initializing all neural devices...\n");
     
-    struct hal_device *current = device_registry;
-    while (current) {
-        hal_initialize_device(current->device_id);
-        current = current->next;
+    probe_batch_start_tsc = rdtsc();
+    
+    bool progress;
+    int stalled_passes = 0;
+    while (hal_probe_worker_step(&progress) > 0) {
+        if (progress) {
+            stalled_passes = 0;
+            continue;
+        }
+        
+        /* No device moved and none is running: a dependency cycle. The
+         * second pass covers a device another CPU claimed mid-pass.
+         */
+        int running = 0;
+        for (struct hal_device *current = device_registry; current; current = current->next) {
+            if (current->status == DEVICE_STATUS_INITIALIZING) {
+                running++;
+            }
+        }
+        
+        if (running == 0 && ++stalled_passes > 1) {
+            for (struct hal_device *current = device_registry; current; current = current->next) {
+                if (current->status == DEVICE_STATUS_DETECTED) {
+                    current->status = DEVICE_STATUS_ERROR;
+                    serial_puts("[NEURAL-HAL] Dependency cycle, skipping: ");
+                    serial_puts(current->name);
+                    serial_puts("\n");
+                }
+            }
+            break;
+        }
+        
+        asm volatile("pause");
     }
     
+    probe_batch_end_tsc = rdtsc();
+    
+    hal_print_probe_timings();
     serial_puts("[NEURAL-HAL] All device initialization complete\n");
-}
\ No newline at end of file
+}
+
+/* Print per-device probe timing for the last batch */
+void hal_print_probe_timings(void) {
+    uint64_t serial_sum = 0;
+    
+    serial_puts("[NEURAL-HAL] === Device Probe Timing ===\n");
+    for (struct hal_device *current = device_registry; current; current = current->next) {
+        if (!current->probe_start_tsc) {
+            continue;
+        }
+        
+        uint64_t total = current->probe_ready_tsc > current->probe_start_tsc ?
+                         current->probe_ready_tsc - current->probe_start_tsc : 0;
+        serial_sum += total;
+        
+        serial_puts("[PROBE] ");
+        serial_puts(current->name);
+        serial_puts(": start +");
+        print_dec(tsc_cycles_to_us(current->probe_start_tsc - probe_batch_start_tsc));
+        serial_puts("us, ready after ");
+        print_dec(tsc_cycles_to_us(total));
+        serial_puts("us (");
+        print_dec(tsc_cycles_to_us(current->probe_cycles));
+        serial_puts("us busy) on CPU ");
+        print_dec(current->probe_cpu);
+        serial_puts(current->status == DEVICE_STATUS_ACTIVE ? "\n" : " [FAILED]\n");
+    }
+    
+    serial_puts("[PROBE] Batch: ");
+    print_dec(tsc_cycles_to_us(probe_batch_end_tsc - probe_batch_start_tsc));
+    serial_puts("us wall, ");
+    print_dec(tsc_cycles_to_us(serial_sum));
+    serial_puts("us if run back to back\n");
+}
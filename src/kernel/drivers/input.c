@@ -7,8 +7,11 @@
 #include <stddef.h>
 #include <string.h>
 #include "kernel/input.h"
+#include "kernel/input_dev.h"
 #include "kernel/interrupts.h"
 #include "kernel/memory.h"
+#include "kernel/perf.h"
+#include "kernel/tsc.h"
 
 /* External functions */
 extern void serial_puts(const char *s);
@@ -21,10 +24,18 @@ extern uint8_t inb(uint16_t port);
 static input_system_t input_system;
 static bool input_initialized = false;
 
+/* PS/2 devices, cached for their IRQ handlers */
+static input_device_t *ps2_keyboard_device = NULL;
+static input_device_t *ps2_mouse_device = NULL;
+
+static int ps2_init(void);
+
 /* PS/2 Controller Ports */
 #define PS2_DATA_PORT    0x60
 #define PS2_STATUS_PORT  0x64
 #define PS2_COMMAND_PORT 0x64
+#define PS2_KEYBOARD_IRQ 1
+#define PS2_MOUSE_IRQ    12
 
 /* PS/2 Controller Commands */
 #define PS2_CMD_READ_CONFIG     0x20
@@ -71,9 +82,16 @@ int input_init(void) {
     input_system.double_click_time = 300; /* 300ms */
     input_system.double_click_distance = 5; /* 5 pixels */
     
+    /* Devices register against a live system */
+    input_system.initialized = true;
+    input_initialized = true;
+    input_dev_init();
+    
     /* Initialize PS/2 controller */
     if (ps2_init() != 0) {
         serial_puts("[NEURAL-INPUT] Failed to initialize PS/2 controller\n");
+        input_system.initialized = false;
+        input_initialized = false;
         return -1;
     }
     
@@ -91,9 +109,6 @@ int input_init(void) {
         serial_puts("[SUCCESS] PS/2 mouse initialized\n");
     }
     
-    input_system.initialized = true;
-    input_initialized = true;
-    
     serial_puts("[NEURAL-INPUT] Neural Input System initialized\n");
     return 0;
 }
@@ -106,6 +121,9 @@ void input_shutdown(void) {
     
     serial_puts("[NEURAL-INPUT] Shutting down Neural Input System...\n");
     
+    /* Readers hold device pointers */
+    input_dev_shutdown();
+    
     /* Cleanup devices */
     input_device_t *device = input_system.devices;
     while (device) {
@@ -113,10 +131,17 @@ void input_shutdown(void) {
         if (device->cleanup) {
             device->cleanup(device);
         }
+        if (device->ring) {
+            kfree(device->ring);
+        }
         kfree(device);
         device = next;
     }
     
+    input_system.devices = NULL;
+    input_system.device_count = 0;
+    ps2_keyboard_device = NULL;
+    ps2_mouse_device = NULL;
     input_system.initialized = false;
     input_initialized = false;
     
@@ -150,10 +175,19 @@ int input_register_device(input_device_t *device) {
         return -1;
     }
     
+    /* Ring must exist before the device can raise events */
+    if (!device->ring) {
+        device->ring = (input_ring_t *)kcalloc(1, sizeof(input_ring_t));
+        if (!device->ring) {
+            return -1;
+        }
+    }
+    
     /* Add to device list */
     device->next = input_system.devices;
     input_system.devices = device;
     input_system.device_count++;
+    input_dev_attach(device);
     
     /* Initialize device */
     if (device->init) {
@@ -180,48 +214,196 @@ input_device_t *input_find_device(input_device_type_t type) {
     return NULL;
 }
 
-/* Queue Input Event */
+/* Ring Producer - merge motion into a move the consumer hasn't claimed */
+static bool input_ring_coalesce(input_ring_t *ring, const input_event_t *event) {
+    uint32_t head = ring->head;
+    if (head == __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+    
+    input_ring_slot_t *slot = &ring->slots[(head - 1) & INPUT_RING_MASK];
+    if (slot->event.type != INPUT_EVENT_MOUSE_MOVE) {
+        return false;
+    }
+    
+    /* Mark the slot busy first; the consumer claims before it reads */
+    __atomic_add_fetch(&slot->seq, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&ring->tail, __ATOMIC_SEQ_CST) == head) {
+        __atomic_add_fetch(&slot->seq, 1, __ATOMIC_RELEASE);
+        return false;
+    }
+    
+    /* Keep the first timestamp: latency is measured from the oldest motion */
+    slot->event.data.mouse.x = event->data.mouse.x;
+    slot->event.data.mouse.y = event->data.mouse.y;
+    slot->event.data.mouse.delta_x += event->data.mouse.delta_x;
+    slot->event.data.mouse.delta_y += event->data.mouse.delta_y;
+    __atomic_add_fetch(&slot->seq, 1, __ATOMIC_RELEASE);
+    
+    ring->coalesced++;
+    return true;
+}
+
+static bool input_ring_push(input_ring_t *ring, const input_event_t *event) {
+    uint32_t head = ring->head;
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    
+    /* One slot of slack: the consumer reads a slot after releasing it */
+    if (head - tail >= INPUT_RING_SIZE - 1) {
+        ring->dropped++;
+        return false;
+    }
+    
+    input_event_t *slot = &ring->slots[head & INPUT_RING_MASK].event;
+    *slot = *event;
+    if (!slot->tsc) {
+        slot->tsc = rdtsc();
+    }
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+    ring->queued++;
+    return true;
+}
+
+/* Ring Consumer */
+static bool input_ring_pop(input_ring_t *ring, input_event_t *out) {
+    uint32_t tail = ring->tail;
+    if (tail == __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+    
+    input_ring_slot_t *slot = &ring->slots[tail & INPUT_RING_MASK];
+    
+    /* Claim, then wait out a merge that started before the claim */
+    __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_SEQ_CST);
+    while (__atomic_load_n(&slot->seq, __ATOMIC_SEQ_CST) & 1) {
+        asm volatile("pause");
+    }
+    
+    *out = slot->event;
+    ring->delivered++;
+    return true;
+}
+
+/* Queue Event on a Device - safe from that device's IRQ handler */
+int input_device_queue_event(input_device_t *device, const input_event_t *event) {
+    if (!device || !device->ring || !event) {
+        return -1;
+    }
+    
+    if (event->type == INPUT_EVENT_MOUSE_MOVE && input_ring_coalesce(device->ring, event)) {
+        return 0;
+    }
+    
+    return input_ring_push(device->ring, event) ? 0 : -1;
+}
+
+/* Queue Input Event - routed to the first device of the matching kind */
 void input_queue_event(input_event_t *event) {
     if (!input_initialized || !event) {
         return;
     }
     
-    /* Check if queue is full */
-    if (input_system.queue_count >= 256) {
-        /* Drop oldest event */
-        input_system.queue_head = (input_system.queue_head + 1) % 256;
-        input_system.queue_count--;
+    input_device_type_t type;
+    switch (event->type) {
+        case INPUT_EVENT_KEY_PRESS:
+        case INPUT_EVENT_KEY_RELEASE:
+            type = INPUT_DEVICE_KEYBOARD;
+            break;
+        case INPUT_EVENT_TOUCH_START:
+        case INPUT_EVENT_TOUCH_MOVE:
+        case INPUT_EVENT_TOUCH_END:
+            type = INPUT_DEVICE_TOUCHSCREEN;
+            break;
+        default:
+            type = INPUT_DEVICE_MOUSE;
+            break;
     }
     
-    /* Add event to queue */
-    input_system.event_queue[input_system.queue_tail] = *event;
-    input_system.queue_tail = (input_system.queue_tail + 1) % 256;
-    input_system.queue_count++;
+    input_device_queue_event(input_find_device(type), event);
 }
 
-/* Get Next Event */
+/* Get Next Event - oldest pending event across all device rings */
 input_event_t *input_get_next_event(void) {
-    if (!input_initialized || input_system.queue_count == 0) {
+    if (!input_initialized) {
+        return NULL;
+    }
+    
+    input_device_t *oldest = NULL;
+    uint32_t oldest_time = 0;
+    
+    for (input_device_t *device = input_system.devices; device; device = device->next) {
+        input_ring_t *ring = device->ring;
+        if (!ring) {
+            continue;
+        }
+        
+        uint32_t tail = ring->tail;
+        if (tail == __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE)) {
+            continue;
+        }
+        
+        /* Timestamps are never rewritten by coalescing, so peeking is safe */
+        uint32_t time = ring->slots[tail & INPUT_RING_MASK].event.timestamp;
+        if (!oldest || (int32_t)(time - oldest_time) < 0) {
+            oldest = device;
+            oldest_time = time;
+        }
+    }
+    
+    if (!oldest || !input_ring_pop(oldest->ring, &input_system.current_event)) {
         return NULL;
     }
+    input_system.current_device = oldest;
     
-    input_event_t *event = &input_system.event_queue[input_system.queue_head];
-    input_system.queue_head = (input_system.queue_head + 1) % 256;
-    input_system.queue_count--;
+    return &input_system.current_event;
+}
+
+/* Get ring counters summed over all devices */
+void input_get_stats(input_stats_t *stats) {
+    if (!stats) {
+        return;
+    }
+    
+    memset(stats, 0, sizeof(input_stats_t));
     
-    return event;
+    for (input_device_t *device = input_system.devices; device; device = device->next) {
+        input_ring_t *ring = device->ring;
+        if (!ring) {
+            continue;
+        }
+        
+        stats->queued += ring->queued;
+        stats->delivered += ring->delivered;
+        stats->dropped += ring->dropped;
+        stats->coalesced += ring->coalesced;
+        stats->pending += ring->head - ring->tail;
+    }
 }
 
 /* Process Events */
 void input_process_events(void) {
     input_event_t *event;
     while ((event = input_get_next_event()) != NULL) {
+        perf_latency_record(PERF_LATENCY_QUEUE, event->tsc);
+        
+        /* Userland readers see events alongside in-kernel handlers */
+        input_dev_publish(input_system.current_device, event);
+        
         /* Call event handlers */
         for (uint32_t i = 0; i < input_system.handler_count; i++) {
             if (input_system.handlers[i]) {
                 input_system.handlers[i](event);
             }
         }
+        perf_latency_record(PERF_LATENCY_DISPATCH, event->tsc);
+        
+        /* Photon latency is measured from the oldest event a frame reflects */
+        if (!input_system.pending_tsc || event->tsc < input_system.pending_tsc) {
+            input_system.pending_tsc = event->tsc;
+        }
+        if (event->type >= INPUT_EVENT_MOUSE_MOVE && event->type <= INPUT_EVENT_MOUSE_WHEEL) {
+            input_system.pointer_tsc = event->tsc;
+        }
         
         /* Update input state based on event */
         switch (event->type) {
@@ -262,6 +444,18 @@ void input_process_events(void) {
     }
 }
 
+/* Oldest processed event since the last call (0 if none) */
+uint64_t input_take_pending_tsc(void) {
+    uint64_t tsc = input_system.pending_tsc;
+    input_system.pending_tsc = 0;
+    return tsc;
+}
+
+/* Origin of the pointer state gui_handle_input() is looking at */
+uint64_t input_get_pointer_tsc(void) {
+    return input_system.pointer_tsc;
+}
+
 /* Add Event Handler */
 void input_add_event_handler(input_event_handler_t handler) {
     if (!input_initialized || !handler || input_system.handler_count >= 16) {
@@ -341,10 +535,13 @@ int ps2_keyboard_init(void) {
         kfree(kbd_device);
         return -1;
     }
+    ps2_keyboard_device = kbd_device;
     
     /* Register keyboard interrupt handler */
-    extern void register_interrupt_handler(uint8_t irq, void (*handler)(void));
-    register_interrupt_handler(1, keyboard_interrupt_handler);
+    if (irq_register_handler(PS2_KEYBOARD_IRQ, keyboard_interrupt_handler, NULL, "ps2-keyboard") != 0) {
+        return -1;
+    }
+    irq_enable(PS2_KEYBOARD_IRQ);
     
     return 0;
 }
@@ -367,16 +564,22 @@ int ps2_mouse_init(void) {
         kfree(mouse_device);
         return -1;
     }
+    ps2_mouse_device = mouse_device;
     
     /* Register mouse interrupt handler */
-    extern void register_interrupt_handler(uint8_t irq, void (*handler)(void));
-    register_interrupt_handler(12, mouse_interrupt_handler);
+    if (irq_register_handler(PS2_MOUSE_IRQ, mouse_interrupt_handler, NULL, "ps2-mouse") != 0) {
+        return -1;
+    }
+    irq_enable(PS2_MOUSE_IRQ);
     
     return 0;
 }
 
 /* Keyboard Interrupt Handler */
-void keyboard_interrupt_handler(void) {
+int keyboard_interrupt_handler(uint8_t irq, void *data) {
+    (void)irq;
+    (void)data;
+    
     uint8_t scancode = inb(PS2_DATA_PORT);
     
     /* Determine if key press or release */
@@ -388,33 +591,43 @@ void keyboard_interrupt_handler(void) {
     /* Look up key code */
     key_code_t key = scancode_map[scancode];
     if (key == 0) {
-        return; /* Unknown key */
+        return IRQ_HANDLED; /* Unknown key */
     }
     
     /* Create input event */
     input_event_t event;
     event.type = key_released ? INPUT_EVENT_KEY_RELEASE : INPUT_EVENT_KEY_PRESS;
     event.timestamp = get_time_ms();
+    event.tsc = rdtsc();
     event.data.key.key = key;
     event.data.key.ctrl = input_system.keyboard.ctrl;
     event.data.key.alt = input_system.keyboard.alt;
     event.data.key.shift = input_system.keyboard.shift;
     
     /* Queue event */
-    input_queue_event(&event);
+    input_device_queue_event(ps2_keyboard_device, &event);
+    return IRQ_HANDLED;
 }
 
-/* Mouse Interrupt Handler */
-void mouse_interrupt_handler(void) {
+/* Mouse Interrupt Handler - position and buttons are producer-side state,
+ * the consumer only ever sees them through queued events
+ */
+int mouse_interrupt_handler(uint8_t irq, void *data) {
+    (void)irq;
+    (void)data;
+    
     static uint8_t mouse_packet[3];
     static int packet_index = 0;
+    static int32_t mouse_x = 0;
+    static int32_t mouse_y = 0;
+    static uint8_t mouse_buttons = 0;
     
-    uint8_t data = inb(PS2_DATA_PORT);
-    mouse_packet[packet_index++] = data;
+    uint8_t byte = inb(PS2_DATA_PORT);
+    mouse_packet[packet_index++] = byte;
     
     /* Wait for complete packet (3 bytes) */
     if (packet_index < 3) {
-        return;
+        return IRQ_HANDLED;
     }
     
     packet_index = 0;
@@ -429,40 +642,48 @@ void mouse_interrupt_handler(void) {
     delta_y = (int8_t)(delta_y * input_system.mouse_sensitivity);
     
     /* Update mouse position */
-    input_system.mouse.x += delta_x;
-    input_system.mouse.y -= delta_y; /* Invert Y axis */
+    mouse_x += delta_x;
+    mouse_y -= delta_y; /* Invert Y axis */
     
     /* Clamp to screen bounds */
-    if (input_system.mouse.x < 0) input_system.mouse.x = 0;
-    if (input_system.mouse.y < 0) input_system.mouse.y = 0;
-    
-    /* Create move event */
-    input_event_t move_event;
-    move_event.type = INPUT_EVENT_MOUSE_MOVE;
-    move_event.timestamp = get_time_ms();
-    move_event.data.mouse.x = input_system.mouse.x;
-    move_event.data.mouse.y = input_system.mouse.y;
-    move_event.data.mouse.delta_x = delta_x;
-    move_event.data.mouse.delta_y = delta_y;
-    
-    input_queue_event(&move_event);
+    if (mouse_x < 0) mouse_x = 0;
+    if (mouse_y < 0) mouse_y = 0;
+    
+    /* Create move event (merged into a pending move if one is queued) */
+    if (delta_x || delta_y) {
+        input_event_t move_event;
+        memset(&move_event, 0, sizeof(input_event_t));
+        move_event.type = INPUT_EVENT_MOUSE_MOVE;
+        move_event.timestamp = get_time_ms();
+        move_event.tsc = rdtsc();
+        move_event.data.mouse.x = mouse_x;
+        move_event.data.mouse.y = mouse_y;
+        move_event.data.mouse.delta_x = delta_x;
+        move_event.data.mouse.delta_y = delta_y;
+        
+        input_device_queue_event(ps2_mouse_device, &move_event);
+    }
     
     /* Handle button events */
     for (int i = 0; i < 3; i++) {
         bool button_pressed = (flags & (1 << i)) != 0;
-        bool was_pressed = input_system.mouse.buttons[i];
+        bool was_pressed = (mouse_buttons & (1 << i)) != 0;
         
         if (button_pressed != was_pressed) {
             input_event_t button_event;
+            memset(&button_event, 0, sizeof(input_event_t));
             button_event.type = button_pressed ? INPUT_EVENT_MOUSE_PRESS : INPUT_EVENT_MOUSE_RELEASE;
             button_event.timestamp = get_time_ms();
-            button_event.data.mouse.x = input_system.mouse.x;
-            button_event.data.mouse.y = input_system.mouse.y;
+            button_event.tsc = rdtsc();
+            button_event.data.mouse.x = mouse_x;
+            button_event.data.mouse.y = mouse_y;
             button_event.data.mouse.button = (mouse_button_t)i;
             
-            input_queue_event(&button_event);
+            input_device_queue_event(ps2_mouse_device, &button_event);
         }
     }
+    mouse_buttons = flags & 0x07;
+    return IRQ_HANDLED;
 }
 
 /* Get Current Time (placeholder) */
@@ -0,0 +1,474 @@
+/* input_dev.c - Brandon Media OS Neural Input Device Nodes
+ * Per-Reader Shared Event Rings Behind /dev/input/eventN
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "kernel/input_dev.h"
+#include "kernel/input.h"
+#include "kernel/fs.h"
+#include "kernel/memory.h"
+#include "kernel/process.h"
+#include "kernel/interrupts.h"
+
+/* Ring page flags */
+#define INPUT_DEV_KERNEL_FLAGS  (PAGE_PRESENT | PAGE_WRITABLE | PAGE_NO_EXECUTE)
+#define INPUT_DEV_USER_FLAGS    (PAGE_PRESENT | PAGE_WRITABLE | PAGE_USER | PAGE_NO_EXECUTE)
+
+/* External functions */
+extern void serial_puts(const char *s);
+extern void print_dec(uint64_t num);
+extern int snprintf(char *buffer, size_t size, const char *format, ...);
+
+/* One /dev/input/eventN node */
+typedef struct {
+    bool used;
+    uint32_t index;
+    input_device_t *device;
+    struct vfs_node *node;
+} input_dev_node_t;
+
+/* One reader's ring - a process opening a node twice shares it */
+typedef struct {
+    bool used;
+    uint32_t owner_pid;
+    uint32_t opens;
+    input_dev_node_t *dev;
+    
+    /* Backing store: contiguous frames mapped twice (kernel + reader) */
+    uint64_t phys;
+    size_t pages;
+    input_dev_shared_t *shared;
+    uint64_t user_addr;
+    pml4_t *owner_space;
+    
+    struct process *waiter;         /* Sleeping in INPUT_IOCTL_WAIT */
+} input_dev_client_t;
+
+/* Device Node State */
+typedef struct {
+    input_dev_node_t nodes[INPUT_DEV_MAX_NODES];
+    input_dev_client_t clients[INPUT_DEV_MAX_CLIENTS];
+    input_dev_stats_t stats;
+} input_dev_system_t;
+
+static input_dev_system_t input_dev;
+static bool input_dev_initialized = false;
+
+static int64_t input_dev_open(struct vfs_node *node, uint32_t flags);
+static int64_t input_dev_close(struct vfs_node *node);
+static int64_t input_dev_read(struct vfs_node *node, void *buffer, uint64_t size, uint64_t offset);
+static int64_t input_dev_ioctl(struct vfs_node *node, uint32_t cmd, void *arg);
+
+static struct file_operations input_dev_ops = {
+    .open = input_dev_open,
+    .close = input_dev_close,
+    .read = input_dev_read,
+    .ioctl = input_dev_ioctl,
+};
+
+/* Initialize device nodes; devices attach as they register */
+int input_dev_init(void) {
+    if (input_dev_initialized) {
+        return 0;
+    }
+    
+    memset(&input_dev, 0, sizeof(input_dev_system_t));
+    input_dev_initialized = true;
+    
+    serial_puts("[NEURAL-INPUT] Device nodes under " INPUT_DEV_DIR "\n");
+    return 0;
+}
+
+/* Unmap and free one reader ring */
+static void input_dev_client_destroy(input_dev_client_t *client) {
+    if (client->owner_space) {
+        for (size_t i = 0; i < client->pages; i++) {
+            paging_unmap_page(client->owner_space, client->user_addr + i * PAGE_SIZE);
+        }
+    }
+    vmm_unmap(client->shared, client->pages * PAGE_SIZE);
+    pmm_free_frames(client->phys, client->pages);
+    
+    memset(client, 0, sizeof(input_dev_client_t));
+    input_dev.stats.clients--;
+}
+
+/* Shutdown - drop every reader and node before the devices go away */
+void input_dev_shutdown(void) {
+    if (!input_dev_initialized) {
+        return;
+    }
+    
+    for (uint32_t i = 0; i < INPUT_DEV_MAX_CLIENTS; i++) {
+        if (input_dev.clients[i].used) {
+            input_dev_client_destroy(&input_dev.clients[i]);
+        }
+    }
+    
+    for (uint32_t i = 0; i < INPUT_DEV_MAX_NODES; i++) {
+        if (input_dev.nodes[i].used) {
+            vfs_node_destroy(input_dev.nodes[i].node);
+        }
+    }
+    
+    input_dev_initialized = false;
+}
+
+/* Create /dev/input/eventN for a registered device */
+int input_dev_attach(input_device_t *device) {
+    if (!input_dev_initialized || !device) {
+        return -1;
+    }
+    
+    uint32_t slot = INPUT_DEV_MAX_NODES;
+    for (uint32_t i = 0; i < INPUT_DEV_MAX_NODES; i++) {
+        if (input_dev.nodes[i].used && input_dev.nodes[i].device == device) {
+            return 0;
+        }
+        if (!input_dev.nodes[i].used && slot == INPUT_DEV_MAX_NODES) {
+            slot = i;
+        }
+    }
+    if (slot == INPUT_DEV_MAX_NODES) {
+        serial_puts("[NEURAL-INPUT] No free device node slots\n");
+        return -1;
+    }
+    
+    input_dev_node_t *dev = &input_dev.nodes[slot];
+    char name[16];
+    snprintf(name, sizeof(name), "event%u", slot);
+    
+    dev->node = vfs_create_device(INPUT_DEV_DIR, name, &input_dev_ops, dev);
+    if (!dev->node) {
+        serial_puts("[NEURAL-INPUT] Failed to create device node\n");
+        return -1;
+    }
+    
+    dev->node->permissions = FS_PERM_READ | FS_PERM_WRITE;
+    dev->used = true;
+    dev->index = slot;
+    dev->device = device;
+    input_dev.stats.nodes++;
+    
+    serial_puts("[NEURAL-INPUT] " INPUT_DEV_DIR "/");
+    serial_puts(name);
+    serial_puts(" -> ");
+    serial_puts(device->name);
+    serial_puts("\n");
+    return 0;
+}
+
+static input_dev_client_t *input_dev_find_client(input_dev_node_t *dev, uint32_t owner_pid) {
+    for (uint32_t i = 0; i < INPUT_DEV_MAX_CLIENTS; i++) {
+        input_dev_client_t *client = &input_dev.clients[i];
+        if (client->used && client->dev == dev && client->owner_pid == owner_pid) {
+            return client;
+        }
+    }
+    return NULL;
+}
+
+static input_dev_client_t *input_dev_current_client(struct vfs_node *node) {
+    struct process *current = process_get_current();
+    return input_dev_find_client((input_dev_node_t *)node->fs_data, current ? current->pid : 0);
+}
+
+/* Open - give the reader its own ring, mapped into its address space */
+static int64_t input_dev_open(struct vfs_node *node, uint32_t flags) {
+    (void)flags;
+    
+    input_dev_node_t *dev = (input_dev_node_t *)node->fs_data;
+    if (!input_dev_initialized || !dev || !dev->used) {
+        return -1;
+    }
+    
+    struct process *owner = process_get_current();
+    uint32_t owner_pid = owner ? owner->pid : 0;
+    
+    input_dev_client_t *client = input_dev_find_client(dev, owner_pid);
+    if (client) {
+        client->opens++;
+        return 0;
+    }
+    
+    uint32_t slot = INPUT_DEV_MAX_CLIENTS;
+    for (uint32_t i = 0; i < INPUT_DEV_MAX_CLIENTS; i++) {
+        if (!input_dev.clients[i].used) {
+            slot = i;
+            break;
+        }
+    }
+    if (slot == INPUT_DEV_MAX_CLIENTS) {
+        serial_puts("[NEURAL-INPUT] No free reader slots\n");
+        return -1;
+    }
+    
+    size_t pages = PAGE_ALIGN_UP(sizeof(input_dev_shared_t)) / PAGE_SIZE;
+    uint64_t phys = pmm_alloc_frames(pages);
+    if (!phys) {
+        return -1;
+    }
+    
+    input_dev_shared_t *shared = (input_dev_shared_t *)vmm_map(phys, pages * PAGE_SIZE, INPUT_DEV_KERNEL_FLAGS);
+    if (!shared) {
+        pmm_free_frames(phys, pages);
+        return -1;
+    }
+    memset(shared, 0, pages * PAGE_SIZE);
+    
+    shared->magic = INPUT_DEV_MAGIC;
+    shared->device_type = dev->device->type;
+    shared->ring_size = INPUT_DEV_RING_SIZE;
+    shared->event_size = sizeof(input_dev_event_t);
+    strncpy(shared->name, dev->device->name, sizeof(shared->name) - 1);
+    
+    client = &input_dev.clients[slot];
+    memset(client, 0, sizeof(input_dev_client_t));
+    client->owner_pid = owner_pid;
+    client->opens = 1;
+    client->dev = dev;
+    client->phys = phys;
+    client->pages = pages;
+    client->shared = shared;
+    
+    /* Map the same frames into the reader - events arrive without a syscall */
+    if (owner && owner->page_directory) {
+        uint64_t base = INPUT_DEV_USER_BASE + (uint64_t)slot * INPUT_DEV_USER_SPAN;
+        
+        for (size_t i = 0; i < pages; i++) {
+            if (paging_map_page(owner->page_directory, base + i * PAGE_SIZE,
+                                phys + i * PAGE_SIZE, INPUT_DEV_USER_FLAGS) != 0) {
+                for (size_t j = 0; j < i; j++) {
+                    paging_unmap_page(owner->page_directory, base + j * PAGE_SIZE);
+                }
+                vmm_unmap(shared, pages * PAGE_SIZE);
+                pmm_free_frames(phys, pages);
+                memset(client, 0, sizeof(input_dev_client_t));
+                return -1;
+            }
+        }
+        client->owner_space = owner->page_directory;
+        client->user_addr = base;
+    } else {
+        /* Kernel-side reader */
+        client->user_addr = (uint64_t)shared;
+    }
+    
+    client->used = true;
+    input_dev.stats.clients++;
+    return 0;
+}
+
+static int64_t input_dev_close(struct vfs_node *node) {
+    input_dev_client_t *client = input_dev_current_client(node);
+    if (!client) {
+        return -1;
+    }
+    
+    if (--client->opens == 0) {
+        input_dev_client_destroy(client);
+    }
+    return 0;
+}
+
+/* Read - copying fallback for readers that don't map the ring */
+static int64_t input_dev_read(struct vfs_node *node, void *buffer, uint64_t size, uint64_t offset) {
+    (void)offset;
+    
+    input_dev_client_t *client = input_dev_current_client(node);
+    if (!client) {
+        return -1;
+    }
+    
+    input_dev_shared_t *shared = client->shared;
+    input_dev_event_t *out = (input_dev_event_t *)buffer;
+    uint64_t max = size / sizeof(input_dev_event_t);
+    uint64_t count = 0;
+    
+    uint32_t tail = shared->tail;
+    uint32_t head = __atomic_load_n(&shared->head, __ATOMIC_ACQUIRE);
+    while (count < max && tail != head) {
+        out[count++] = shared->events[tail & INPUT_DEV_RING_MASK];
+        tail++;
+    }
+    __atomic_store_n(&shared->tail, tail, __ATOMIC_RELEASE);
+    
+    return (int64_t)(count * sizeof(input_dev_event_t));
+}
+
+static bool input_dev_ready(const input_dev_shared_t *shared) {
+    return __atomic_load_n(&shared->head, __ATOMIC_ACQUIRE) != __atomic_load_n(&shared->tail, __ATOMIC_ACQUIRE);
+}
+
+static int64_t input_dev_ioctl(struct vfs_node *node, uint32_t cmd, void *arg) {
+    input_dev_client_t *client = input_dev_current_client(node);
+    if (!client) {
+        return -1;
+    }
+    
+    switch (cmd) {
+        case INPUT_IOCTL_MAP_RING:
+            return (int64_t)client->user_addr;
+        
+        case INPUT_IOCTL_GET_INFO: {
+            input_dev_info_t *info = (input_dev_info_t *)arg;
+            if (!info) {
+                return -1;
+            }
+            memset(info, 0, sizeof(input_dev_info_t));
+            info->index = client->dev->index;
+            info->type = client->dev->device->type;
+            strncpy(info->name, client->dev->device->name, sizeof(info->name) - 1);
+            return 0;
+        }
+        
+        case INPUT_IOCTL_WAIT: {
+            uint32_t timeout_ms = (uint32_t)(uintptr_t)arg;
+            if (input_dev_ready(client->shared) || timeout_ms == 0) {
+                client->shared->waiting = 0;
+                return input_dev_ready(client->shared) ? 1 : 0;
+            }
+            
+            /* Asleep before announcing and rechecking: a publish after the
+             * recheck finds us sleeping and its wake makes the yield return */
+            process_prepare_sleep(timeout_ms);
+            client->waiter = process_get_current();
+            __atomic_store_n(&client->shared->waiting, 1, __ATOMIC_SEQ_CST);
+            if (input_dev_ready(client->shared)) {
+                client->shared->waiting = 0;
+                client->waiter = NULL;
+                process_cancel_sleep();
+                return 1;
+            }
+            
+            scheduler_yield();
+            client->waiter = NULL;
+            client->shared->waiting = 0;
+            return input_dev_ready(client->shared) ? 1 : 0;
+        }
+        
+        default:
+            return -1;
+    }
+}
+
+/* Wake a reader and queue it, as the timer tick does on timeout. A reader
+ * that has not yielded yet is still current; it only needs its state back.
+ */
+static void input_dev_wake(struct process *waiter) {
+    interrupts_disable();
+    if (waiter->state == PROCESS_SLEEPING) {
+        if (waiter == process_get_current()) {
+            waiter->state = PROCESS_RUNNING;
+        } else {
+            process_wake(waiter);
+            scheduler_add_process(waiter);
+        }
+    }
+    interrupts_enable();
+}
+
+/* Flatten an event into the fixed wire layout */
+static void input_dev_encode(const input_event_t *event, input_dev_event_t *out) {
+    memset(out, 0, sizeof(input_dev_event_t));
+    out->tsc = event->tsc;
+    out->timestamp = event->timestamp;
+    out->type = (uint16_t)event->type;
+    
+    switch (event->type) {
+        case INPUT_EVENT_KEY_PRESS:
+        case INPUT_EVENT_KEY_RELEASE:
+            out->code = (uint16_t)event->data.key.key;
+            out->value = (event->data.key.ctrl ? INPUT_DEV_MOD_CTRL : 0) |
+                         (event->data.key.alt ? INPUT_DEV_MOD_ALT : 0) |
+                         (event->data.key.shift ? INPUT_DEV_MOD_SHIFT : 0);
+            break;
+        
+        case INPUT_EVENT_MOUSE_MOVE:
+        case INPUT_EVENT_MOUSE_PRESS:
+        case INPUT_EVENT_MOUSE_RELEASE:
+        case INPUT_EVENT_MOUSE_WHEEL:
+            out->code = (uint16_t)event->data.mouse.button;
+            out->value = event->data.mouse.wheel_delta;
+            out->x = event->data.mouse.x;
+            out->y = event->data.mouse.y;
+            out->dx = event->data.mouse.delta_x;
+            out->dy = event->data.mouse.delta_y;
+            break;
+        
+        case INPUT_EVENT_TOUCH_START:
+        case INPUT_EVENT_TOUCH_MOVE:
+        case INPUT_EVENT_TOUCH_END:
+            out->code = (uint16_t)event->data.touch.touch_id;
+            out->value = (int32_t)(event->data.touch.pressure * 1000.0f);
+            out->x = event->data.touch.x;
+            out->y = event->data.touch.y;
+            break;
+    }
+}
+
+/* Fan one event out to every reader of its device (input_process_events) */
+void input_dev_publish(input_device_t *device, const input_event_t *event) {
+    if (!input_dev_initialized || !device || !event || input_dev.stats.clients == 0) {
+        return;
+    }
+    
+    input_dev_event_t wire;
+    bool encoded = false;
+    
+    for (uint32_t i = 0; i < INPUT_DEV_MAX_CLIENTS; i++) {
+        input_dev_client_t *client = &input_dev.clients[i];
+        if (!client->used || client->dev->device != device) {
+            continue;
+        }
+        
+        if (!encoded) {
+            input_dev_encode(event, &wire);
+            encoded = true;
+        }
+        
+        input_dev_shared_t *shared = client->shared;
+        uint32_t head = shared->head;
+        if (head - __atomic_load_n(&shared->tail, __ATOMIC_ACQUIRE) >= INPUT_DEV_RING_SIZE) {
+            shared->dropped++;
+            input_dev.stats.dropped++;
+            continue;
+        }
+        
+        shared->events[head & INPUT_DEV_RING_MASK] = wire;
+        __atomic_store_n(&shared->head, head + 1, __ATOMIC_RELEASE);
+        input_dev.stats.published++;
+        
+        /* Readiness: wake a reader that announced it is about to sleep */
+        if (__atomic_exchange_n(&shared->waiting, 0, __ATOMIC_SEQ_CST) && client->waiter) {
+            input_dev_wake(client->waiter);
+            input_dev.stats.wakeups++;
+        }
+    }
+}
+
+/* Drop every ring of an exiting process */
+void input_dev_release_process(uint32_t owner_pid) {
+    if (!input_dev_initialized) {
+        return;
+    }
+    
+    for (uint32_t i = 0; i < INPUT_DEV_MAX_CLIENTS; i++) {
+        input_dev_client_t *client = &input_dev.clients[i];
+        if (client->used && client->owner_pid == owner_pid) {
+            input_dev_client_destroy(client);
+        }
+    }
+}
+
+/* Get device node statistics */
+void input_dev_get_stats(input_dev_stats_t *stats) {
+    if (!stats) {
+        return;
+    }
+    
+    *stats = input_dev.stats;
+}
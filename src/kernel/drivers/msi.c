@@ -0,0 +1,236 @@
+/* msi.c - Brandon Media OS Message Signalled Interrupts
+ * MSI/MSI-X Vector Programming Targeted at Individual CPUs
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "kernel/msi.h"
+#include "kernel/memory.h"
+#include "kernel/smp.h"
+
+/* Vector table page flags */
+#define MSIX_TABLE_FLAGS    (PAGE_PRESENT | PAGE_WRITABLE | PAGE_CACHE_DISABLED | PAGE_NO_EXECUTE)
+
+/* External functions */
+extern void serial_puts(const char *s);
+extern void print_hex(uint64_t num);
+extern void print_dec(uint64_t num);
+
+/* Address selects the destination APIC; data carries the vector (fixed, edge) */
+static uint32_t msi_address(uint8_t cpu_id) {
+    return MSI_ADDRESS_BASE | (smp_get_apic_id(cpu_id) << MSI_ADDRESS_DEST_SHIFT);
+}
+
+static uint16_t msi_read_word(struct pci_device *device, uint16_t offset) {
+    return pci_config_read_word(device->bus, device->device, device->function, offset);
+}
+
+static void msi_write_word(struct pci_device *device, uint16_t offset, uint16_t value) {
+    pci_config_write_word(device->bus, device->device, device->function, offset, value);
+}
+
+static void msi_write_dword(struct pci_device *device, uint16_t offset, uint32_t value) {
+    pci_config_write_dword(device->bus, device->device, device->function, offset, value);
+}
+
+/* Message interrupts need bus mastering; INTx must stay quiet */
+static void msi_prepare_device(struct pci_device *device) {
+    uint16_t command = msi_read_word(device, PCI_COMMAND);
+    command |= PCI_COMMAND_MEMORY | PCI_COMMAND_MASTER | PCI_COMMAND_INTX_DISABLE;
+    msi_write_word(device, PCI_COMMAND, command);
+}
+
+/* Spread queues round-robin over the CPUs that run kernel code. APs are
+ * only reported online today, so every queue stays on the BSP until they run.
+ */
+uint8_t pci_msi_queue_cpu(uint32_t queue) {
+    uint32_t cpus = smp_get_running_cpu_count();
+    if (cpus <= 1) {
+        return 0;
+    }
+    
+    uint32_t slot = queue % cpus;
+    for (uint32_t cpu_id = 0; cpu_id < smp_get_cpu_count(); cpu_id++) {
+        if (smp_cpu_is_running((uint8_t)cpu_id) && slot-- == 0) {
+            return (uint8_t)cpu_id;
+        }
+    }
+    return 0;
+}
+
+/* Map the vector table, mask every entry and turn MSI-X on */
+int pci_msix_init(pci_msix_t *msix, struct pci_device *device) {
+    if (!msix || !device || !device->msix_cap) {
+        return -1;
+    }
+    
+    uint8_t cap = device->msix_cap;
+    uint16_t flags = msi_read_word(device, cap + PCI_MSIX_FLAGS);
+    uint32_t table = pci_config_read_dword(device->bus, device->device, device->function, cap + PCI_MSIX_TABLE);
+    
+    uint64_t bar = pci_get_bar_address(device, table & PCI_MSIX_BIR_MASK);
+    if (!bar || (device->bar[table & PCI_MSIX_BIR_MASK] & 0x1)) {
+        serial_puts("[NEURAL-MSI] MSI-X table not in a memory BAR\n");
+        return -1;
+    }
+    
+    uint16_t entries = (flags & PCI_MSIX_FLAGS_QSIZE) + 1;
+    uint64_t phys = bar + (table & ~(uint32_t)PCI_MSIX_BIR_MASK);
+    uint64_t offset = phys & PAGE_MASK;
+    size_t size = (size_t)entries * PCI_MSIX_ENTRY_SIZE;
+    
+    volatile uint8_t *mapped = (volatile uint8_t *)vmm_map(phys - offset, offset + size, MSIX_TABLE_FLAGS);
+    if (!mapped) {
+        return -1;
+    }
+    
+    msix->pci_dev = device;
+    msix->table = mapped + offset;
+    msix->table_size = entries > MSIX_MAX_ENTRIES ? MSIX_MAX_ENTRIES : entries;
+    for (int i = 0; i < MSIX_MAX_ENTRIES; i++) {
+        msix->vectors[i] = 0;
+    }
+    
+    msi_prepare_device(device);
+    
+    /* Function mask holds everything off while entries are masked one by one */
+    msi_write_word(device, cap + PCI_MSIX_FLAGS, flags | PCI_MSIX_FLAGS_ENABLE | PCI_MSIX_FLAGS_MASKALL);
+    for (uint16_t i = 0; i < entries; i++) {
+        *(volatile uint32_t *)(msix->table + i * PCI_MSIX_ENTRY_SIZE + PCI_MSIX_ENTRY_CTRL) = PCI_MSIX_ENTRY_CTRL_MASK;
+    }
+    msi_write_word(device, cap + PCI_MSIX_FLAGS, (flags | PCI_MSIX_FLAGS_ENABLE) & ~PCI_MSIX_FLAGS_MASKALL);
+    
+    serial_puts("[NEURAL-MSI] MSI-X enabled, ");
+    print_dec(entries);
+    serial_puts(" table entries\n");
+    return 0;
+}
+
+/* Give an entry its own vector on `cpu_id` and unmask it; returns the vector */
+int pci_msix_assign(pci_msix_t *msix, uint16_t entry, irq_vector_handler_t handler, void *data, uint8_t cpu_id) {
+    if (!msix || !msix->table || entry >= msix->table_size) {
+        return -1;
+    }
+    
+    if (msix->vectors[entry]) {
+        pci_msix_mask(msix, entry, true);
+        irq_vector_free(msix->vectors[entry], 1);
+        msix->vectors[entry] = 0;
+    }
+    
+    int vector = irq_vector_alloc(1, handler, data, cpu_id);
+    if (vector < 0) {
+        return -1;
+    }
+    
+    volatile uint8_t *slot = msix->table + entry * PCI_MSIX_ENTRY_SIZE;
+    *(volatile uint32_t *)(slot + PCI_MSIX_ENTRY_ADDR_LO) = msi_address(cpu_id);
+    *(volatile uint32_t *)(slot + PCI_MSIX_ENTRY_ADDR_HI) = 0;
+    *(volatile uint32_t *)(slot + PCI_MSIX_ENTRY_DATA) = (uint32_t)vector;
+    msix->vectors[entry] = (uint8_t)vector;
+    pci_msix_mask(msix, entry, false);
+    
+    serial_puts("[NEURAL-MSI] Entry ");
+    print_dec(entry);
+    serial_puts(" -> vector ");
+    print_hex(vector);
+    serial_puts(" on CPU ");
+    print_dec(cpu_id);
+    serial_puts("\n");
+    return vector;
+}
+
+void pci_msix_mask(pci_msix_t *msix, uint16_t entry, bool masked) {
+    if (!msix || !msix->table || entry >= msix->table_size) {
+        return;
+    }
+    
+    volatile uint32_t *control = (volatile uint32_t *)(msix->table + entry * PCI_MSIX_ENTRY_SIZE + PCI_MSIX_ENTRY_CTRL);
+    *control = masked ? (*control | PCI_MSIX_ENTRY_CTRL_MASK) : (*control & ~PCI_MSIX_ENTRY_CTRL_MASK);
+}
+
+/* Disable MSI-X and return every vector it held */
+void pci_msix_release(pci_msix_t *msix) {
+    if (!msix || !msix->pci_dev) {
+        return;
+    }
+    
+    struct pci_device *device = msix->pci_dev;
+    uint16_t flags = msi_read_word(device, device->msix_cap + PCI_MSIX_FLAGS);
+    msi_write_word(device, device->msix_cap + PCI_MSIX_FLAGS, flags & ~PCI_MSIX_FLAGS_ENABLE);
+    
+    for (uint16_t i = 0; i < msix->table_size; i++) {
+        if (msix->vectors[i]) {
+            irq_vector_free(msix->vectors[i], 1);
+            msix->vectors[i] = 0;
+        }
+    }
+    
+    msix->table = NULL;
+    msix->pci_dev = NULL;
+}
+
+/* Enable plain MSI with a block of `count` vectors; returns the first one.
+ * The device ORs the message number into the low data bits, hence the
+ * power-of-two aligned block.
+ */
+int pci_msi_enable(struct pci_device *device, uint32_t count, irq_vector_handler_t handler, void *data, uint8_t cpu_id) {
+    if (!device || !device->msi_cap || count == 0) {
+        return -1;
+    }
+    
+    uint8_t cap = device->msi_cap;
+    uint16_t flags = msi_read_word(device, cap + PCI_MSI_FLAGS);
+    
+    /* Clamp to what the device can generate */
+    uint32_t log2 = 0;
+    uint32_t capable = (flags & PCI_MSI_FLAGS_QMASK) >> 1;
+    while ((1U << (log2 + 1)) <= count && log2 < capable) {
+        log2++;
+    }
+    
+    int vector = irq_vector_alloc(1U << log2, handler, data, cpu_id);
+    if (vector < 0) {
+        return -1;
+    }
+    
+    msi_prepare_device(device);
+    
+    msi_write_dword(device, cap + PCI_MSI_ADDRESS_LO, msi_address(cpu_id));
+    if (flags & PCI_MSI_FLAGS_64BIT) {
+        msi_write_dword(device, cap + PCI_MSI_ADDRESS_HI, 0);
+        msi_write_word(device, cap + PCI_MSI_DATA_64, (uint16_t)vector);
+    } else {
+        msi_write_word(device, cap + PCI_MSI_DATA_32, (uint16_t)vector);
+    }
+    
+    flags = (flags & ~PCI_MSI_FLAGS_QSIZE) | (uint16_t)(log2 << 4) | PCI_MSI_FLAGS_ENABLE;
+    msi_write_word(device, cap + PCI_MSI_FLAGS, flags);
+    
+    serial_puts("[NEURAL-MSI] MSI enabled, ");
+    print_dec(1U << log2);
+    serial_puts(" vectors from ");
+    print_hex(vector);
+    serial_puts(" on CPU ");
+    print_dec(cpu_id);
+    serial_puts("\n");
+    return vector;
+}
+
+void pci_msi_disable(struct pci_device *device) {
+    if (!device || !device->msi_cap) {
+        return;
+    }
+    
+    uint8_t cap = device->msi_cap;
+    uint16_t flags = msi_read_word(device, cap + PCI_MSI_FLAGS);
+    if (!(flags & PCI_MSI_FLAGS_ENABLE)) {
+        return;
+    }
+    
+    msi_write_word(device, cap + PCI_MSI_FLAGS, flags & ~PCI_MSI_FLAGS_ENABLE);
+    
+    uint16_t vector = msi_read_word(device, cap + ((flags & PCI_MSI_FLAGS_64BIT) ? PCI_MSI_DATA_64 : PCI_MSI_DATA_32));
+    irq_vector_free((uint8_t)vector, 1U << ((flags & PCI_MSI_FLAGS_QSIZE) >> 4));
+}
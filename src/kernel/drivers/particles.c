@@ -0,0 +1,297 @@
+/* particles.c - Brandon Media OS Neural Particle Engine Implementation
+ * SoA Layout, Vectorized Integration and Additive-Blend Splats
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "kernel/particles.h"
+#include "kernel/framebuffer.h"
+#include "kernel/memory.h"
+
+/* External functions */
+extern void serial_puts(const char *s);
+extern void print_dec(uint64_t num);
+
+/* 4-wide float vector (SSE register) */
+typedef float v4sf __attribute__((vector_size(16)));
+
+/* Number of float/uint32 arrays in the pool */
+#define PARTICLE_STREAMS    9
+
+static particle_pool_t pool;
+static bool particle_engine_initialized = false;
+
+/* Fast xorshift RNG - one call feeds several fields */
+static inline uint32_t particle_rand(void) {
+    uint32_t x = pool.rng_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    pool.rng_state = x;
+    return x;
+}
+
+/* Initialize Particle Engine */
+int particle_engine_init(uint32_t capacity) {
+    if (particle_engine_initialized) {
+        return 0;
+    }
+
+    if (capacity == 0 || capacity > PARTICLE_MAX) {
+        capacity = PARTICLE_MAX;
+    }
+    capacity = (capacity + PARTICLE_LANES - 1) & ~(PARTICLE_LANES - 1);
+
+    /* One allocation, each stream 16-byte aligned for vector loads */
+    size_t stream_bytes = capacity * sizeof(float);
+    uint8_t *storage = (uint8_t *)kmalloc(stream_bytes * PARTICLE_STREAMS + 15);
+    if (!storage) {
+        serial_puts("[NEURAL-ANIM] Failed to allocate particle pool\n");
+        return -1;
+    }
+
+    memset(&pool, 0, sizeof(particle_pool_t));
+    pool.storage = storage;
+
+    uint8_t *base = (uint8_t *)(((uintptr_t)storage + 15) & ~(uintptr_t)15);
+    pool.x = (float *)(base + stream_bytes * 0);
+    pool.y = (float *)(base + stream_bytes * 1);
+    pool.z = (float *)(base + stream_bytes * 2);
+    pool.vx = (float *)(base + stream_bytes * 3);
+    pool.vy = (float *)(base + stream_bytes * 4);
+    pool.vz = (float *)(base + stream_bytes * 5);
+    pool.life = (float *)(base + stream_bytes * 6);
+    pool.inv_max_life = (float *)(base + stream_bytes * 7);
+    pool.color = (uint32_t *)(base + stream_bytes * 8);
+    memset(base, 0, stream_bytes * PARTICLE_STREAMS);
+
+    pool.capacity = capacity;
+    pool.budget = capacity;
+    pool.rng_state = 0x2545F491;
+
+    particle_engine_initialized = true;
+
+    serial_puts("[NEURAL-ANIM] Particle engine initialized (");
+    print_dec(capacity);
+    serial_puts(" particles)\n");
+    return 0;
+}
+
+/* Shutdown Particle Engine */
+void particle_engine_shutdown(void) {
+    if (!particle_engine_initialized) {
+        return;
+    }
+
+    kfree(pool.storage);
+    memset(&pool, 0, sizeof(particle_pool_t));
+    particle_engine_initialized = false;
+}
+
+/* Emit a single particle - O(1) append to the packed range */
+bool particle_emit(float x, float y, float z, uint32_t color) {
+    if (!particle_engine_initialized && particle_engine_init(PARTICLE_MAX) != 0) {
+        return false;
+    }
+
+    if (pool.count >= pool.budget) {
+        pool.dropped++;
+        return false;
+    }
+
+    uint32_t i = pool.count++;
+    uint32_t r0 = particle_rand();
+    uint32_t r1 = particle_rand();
+
+    pool.x[i] = x;
+    pool.y[i] = y;
+    pool.z[i] = z;
+
+    /* vx, vy in [-1, 1), vz in [0, 1), life in [2, 3) seconds */
+    pool.vx[i] = (float)(r0 & 0xFFFF) * (2.0f / 65536.0f) - 1.0f;
+    pool.vy[i] = (float)(r0 >> 16) * (2.0f / 65536.0f) - 1.0f;
+    pool.vz[i] = (float)(r1 & 0xFFFF) * (1.0f / 65536.0f);
+
+    float life = 2.0f + (float)(r1 >> 16) * (1.0f / 65536.0f);
+    pool.life[i] = life;
+    pool.inv_max_life[i] = 1.0f / life;
+    pool.color[i] = color;
+
+    return true;
+}
+
+/* Emit a burst, returns number of particles actually spawned */
+uint32_t particle_emit_burst(float x, float y, float z, uint32_t count, uint32_t color) {
+    uint32_t spawned = 0;
+
+    while (spawned < count && particle_emit(x, y, z, color)) {
+        spawned++;
+    }
+    return spawned;
+}
+
+/* Integrate a lane-aligned slice [start, end) - safe to run on disjoint
+ * slices from several cores before a single serial compaction pass */
+void particle_engine_update_range(uint32_t start, uint32_t end, float delta_time) {
+    if (!particle_engine_initialized) {
+        return;
+    }
+
+    start &= ~(PARTICLE_LANES - 1);
+    end = (end + PARTICLE_LANES - 1) & ~(PARTICLE_LANES - 1);
+    if (end > pool.capacity) {
+        end = pool.capacity;
+    }
+
+    const v4sf dt = {delta_time, delta_time, delta_time, delta_time};
+
+    for (uint32_t i = start; i < end; i += PARTICLE_LANES) {
+        *(v4sf *)&pool.x[i] += *(v4sf *)&pool.vx[i] * dt;
+        *(v4sf *)&pool.y[i] += *(v4sf *)&pool.vy[i] * dt;
+        *(v4sf *)&pool.z[i] += *(v4sf *)&pool.vz[i] * dt;
+        *(v4sf *)&pool.life[i] -= dt;
+    }
+}
+
+static inline void particle_move(uint32_t dst, uint32_t src) {
+    pool.x[dst] = pool.x[src];
+    pool.y[dst] = pool.y[src];
+    pool.z[dst] = pool.z[src];
+    pool.vx[dst] = pool.vx[src];
+    pool.vy[dst] = pool.vy[src];
+    pool.vz[dst] = pool.vz[src];
+    pool.life[dst] = pool.life[src];
+    pool.inv_max_life[dst] = pool.inv_max_life[src];
+    pool.color[dst] = pool.color[src];
+}
+
+/* Remove dead particles by swapping in the last live one */
+void particle_engine_compact(void) {
+    uint32_t i = 0;
+
+    while (i < pool.count) {
+        if (pool.life[i] <= 0.0f) {
+            pool.count--;
+            if (i != pool.count) {
+                particle_move(i, pool.count);
+            }
+        } else {
+            i++;
+        }
+    }
+}
+
+/* Update Particle Engine */
+void particle_engine_update(float delta_time) {
+    if (!particle_engine_initialized || pool.count == 0) {
+        return;
+    }
+
+    particle_engine_update_range(0, pool.count, delta_time);
+    particle_engine_compact();
+}
+
+/* Per-channel saturating add of two XRGB pixels */
+static inline uint32_t particle_add_saturate(uint32_t dst, uint32_t src) {
+    uint32_t rb = (dst & 0x00FF00FF) + (src & 0x00FF00FF);
+    uint32_t g = (dst & 0x0000FF00) + (src & 0x0000FF00);
+    uint32_t rb_over = rb & 0x01000100;
+    uint32_t g_over = g & 0x00010000;
+
+    rb = (rb | (rb_over - (rb_over >> 8))) & 0x00FF00FF;
+    g = (g | (g_over - (g_over >> 8))) & 0x0000FF00;
+
+    return (dst & 0xFF000000) | rb | g;
+}
+
+/* Render all live particles as additive splats straight into the framebuffer */
+void particle_engine_render(void) {
+    if (!particle_engine_initialized || pool.count == 0) {
+        return;
+    }
+
+    framebuffer_device_t *fb = framebuffer_get_device();
+    if (!fb || !fb->framebuffer) {
+        return;
+    }
+
+    uint32_t *pixels = fb->framebuffer;
+    int32_t width = (int32_t)fb->width;
+    int32_t height = (int32_t)fb->height;
+    int32_t max_x = width - PARTICLE_SPLAT_SIZE;
+    int32_t max_y = height - PARTICLE_SPLAT_SIZE;
+
+    for (uint32_t i = 0; i < pool.count; i++) {
+        int32_t sx = (int32_t)pool.x[i];
+        int32_t sy = (int32_t)pool.y[i];
+
+        if (sx < 0 || sy < 0 || sx > max_x || sy > max_y) {
+            continue;
+        }
+
+        /* Fade with remaining life, 8.8 fixed point */
+        uint32_t fade = (uint32_t)(pool.life[i] * pool.inv_max_life[i] * 256.0f);
+        if (fade > 256) fade = 256;
+
+        uint32_t c = pool.color[i];
+        uint32_t rb = (((c & 0x00FF00FF) * fade) >> 8) & 0x00FF00FF;
+        uint32_t g = (((c & 0x0000FF00) * fade) >> 8) & 0x0000FF00;
+        uint32_t splat = rb | g;
+
+        uint32_t *row = pixels + sy * width + sx;
+        for (int32_t dy = 0; dy < PARTICLE_SPLAT_SIZE; dy++) {
+            for (int32_t dx = 0; dx < PARTICLE_SPLAT_SIZE; dx++) {
+                row[dx] = particle_add_saturate(row[dx], splat);
+            }
+            row += width;
+        }
+    }
+}
+
+uint32_t particle_engine_count(void) {
+    return pool.count;
+}
+
+void particle_engine_clear(void) {
+    pool.count = 0;
+}
+
+/* Reseed the spawn RNG (benchmarks replay identical storms) */
+void particle_engine_seed(uint32_t seed) {
+    pool.rng_state = seed ? seed : 0x2545F491;
+}
+
+/* Cap live particles; the newest beyond the cap are dropped immediately */
+void particle_engine_set_budget(uint32_t budget) {
+    if (!particle_engine_initialized) {
+        return;
+    }
+
+    if (budget > pool.capacity) {
+        budget = pool.capacity;
+    }
+    pool.budget = budget;
+
+    if (pool.count > budget) {
+        pool.count = budget;
+    }
+}
+
+/* Legacy Neural Particle API */
+void neural_particle_system_init(void) {
+    particle_engine_init(PARTICLE_MAX);
+}
+
+void neural_spawn_particle(float x, float y, float z, uint32_t color) {
+    particle_emit(x, y, z, color);
+}
+
+void neural_particle_system_update(float delta_time) {
+    particle_engine_update(delta_time);
+}
+
+void neural_particle_system_render(void) {
+    particle_engine_render();
+}
@@ -5,64 +5,39 @@
 #include <stdint.h>
 #include <stddef.h>
 #include "kernel/memory.h"
+#include "kernel/pci.h"
+#include "kernel/acpi.h"
+#include "kernel/boot_profile.h"
 
 /* PCI Configuration Space Access */
 #define PCI_CONFIG_ADDRESS 0xCF8
 #define PCI_CONFIG_DATA    0xCFC
 
-/* PCI Configuration Registers */
-#define PCI_VENDOR_ID      0x00
-#define PCI_DEVICE_ID      0x02
-#define PCI_COMMAND        0x04
-#define PCI_STATUS         0x06
-#define PCI_REVISION_ID    0x08
-#define PCI_PROG_IF        0x09
-#define PCI_SUBCLASS       0x0A
-#define PCI_CLASS          0x0B
-#define PCI_CACHE_LINE     0x0C
-#define PCI_LATENCY_TIMER  0x0D
-#define PCI_HEADER_TYPE    0x0E
-#define PCI_BIST           0x0F
-#define PCI_BAR0           0x10
-#define PCI_BAR1           0x14
-#define PCI_BAR2           0x18
-#define PCI_BAR3           0x1C
-#define PCI_BAR4           0x20
-#define PCI_BAR5           0x24
-
-/* PCI Device Classes */
-#define PCI_CLASS_NETWORK  0x02
-#define PCI_CLASS_DISPLAY  0x03
-#define PCI_CLASS_STORAGE  0x01
-#define PCI_CLASS_BRIDGE   0x06
-#define PCI_CLASS_SERIAL   0x0C
+/* ECAM: 4KB per function, 1MB per bus */
+#define PCI_ECAM_BUS_SHIFT      20
+#define PCI_ECAM_DEVICE_SHIFT   15
+#define PCI_ECAM_FUNCTION_SHIFT 12
+#define PCI_ECAM_BUS_SIZE       (1UL << PCI_ECAM_BUS_SHIFT)
+#define PCI_ECAM_FLAGS          (PAGE_PRESENT | PAGE_WRITABLE | PAGE_CACHE_DISABLED | PAGE_NO_EXECUTE)
 
 /* Maximum PCI devices we can track */
 #define MAX_PCI_DEVICES 256
 
-/* PCI Device Structure */
-struct pci_device {
-    uint8_t bus;
-    uint8_t device;
-    uint8_t function;
-    uint16_t vendor_id;
-    uint16_t device_id;
-    uint8_t class_code;
-    uint8_t subclass;
-    uint8_t prog_if;
-    uint8_t header_type;
-    uint32_t bar[6];
-    uint8_t irq_line;
-    uint8_t irq_pin;
-    const char *device_name;
-    const char *vendor_name;
-    struct pci_device *next;
-};
-
 /* Global PCI device list */
 static struct pci_device *pci_device_list = NULL;
 static int pci_device_count = 0;
 
+/* ECAM window from ACPI MCFG (segment 0); each bus is mapped on first touch */
+static struct {
+    uint64_t base;
+    uint8_t start_bus;
+    uint8_t end_bus;
+    volatile uint8_t *bus_window[256];
+} pci_ecam;
+
+static uint8_t pci_bus_scanned[256 / 8];
+static uint64_t pci_config_reads = 0;
+
 /* External functions for output */
 extern void serial_puts(const char *s);
 extern void print_hex(uint64_t num);
@@ -79,43 +54,114 @@ static inline uint32_t inl(uint16_t port) {
     return ret;
 }
 
-static inline void outw(uint16_t port, uint16_t val) {
-    asm volatile ("outw %0, %1" : : "a"(val), "Nd"(port));
+/* Locate ECAM from the MCFG table */
+static void pci_ecam_init(void) {
+    const acpi_mcfg_allocation_t *allocations;
+    int count = acpi_get_mcfg_allocations(&allocations);
+    
+    for (int i = 0; i < count; i++) {
+        if (allocations[i].segment != 0) {
+            continue;
+        }
+        
+        pci_ecam.base = allocations[i].base_address;
+        pci_ecam.start_bus = allocations[i].start_bus;
+        pci_ecam.end_bus = allocations[i].end_bus;
+        
+        serial_puts("[NEURAL-PCI] ECAM at ");
+        print_hex(pci_ecam.base);
+        serial_puts(", buses ");
+        print_dec(pci_ecam.start_bus);
+        serial_puts("-");
+        print_dec(pci_ecam.end_bus);
+        serial_puts("\n");
+        return;
+    }
+    
+    serial_puts("[NEURAL-PCI] No MCFG, using legacy port I/O configuration access\n");
 }
 
-static inline uint16_t inw(uint16_t port) {
-    uint16_t ret;
-    asm volatile ("inw %1, %0" : "=a"(ret) : "Nd"(port));
-    return ret;
+/* Memory-mapped config address, or NULL when the bus isn't behind ECAM */
+static volatile uint8_t *pci_ecam_address(uint8_t bus, uint8_t device, uint8_t function, uint16_t offset) {
+    if (!pci_ecam.base || bus < pci_ecam.start_bus || bus > pci_ecam.end_bus) {
+        return NULL;
+    }
+    
+    if (!pci_ecam.bus_window[bus]) {
+        uint64_t phys = pci_ecam.base + ((uint64_t)(bus - pci_ecam.start_bus) << PCI_ECAM_BUS_SHIFT);
+        pci_ecam.bus_window[bus] = (volatile uint8_t *)vmm_map(phys, PCI_ECAM_BUS_SIZE, PCI_ECAM_FLAGS);
+        if (!pci_ecam.bus_window[bus]) {
+            return NULL;
+        }
+    }
+    
+    return pci_ecam.bus_window[bus] + ((uint32_t)device << PCI_ECAM_DEVICE_SHIFT) +
+           ((uint32_t)function << PCI_ECAM_FUNCTION_SHIFT) + (offset & 0xFFC);
 }
 
-/* PCI Configuration Space Access */
-static uint32_t pci_config_read_dword(uint8_t bus, uint8_t device, uint8_t function, uint8_t offset) {
-    uint32_t address = (1 << 31) | ((uint32_t)bus << 16) | ((uint32_t)device << 11) | 
+/* PCI Configuration Space Access - ECAM when available, else 0xCF8/0xCFC */
+uint32_t pci_config_read_dword(uint8_t bus, uint8_t device, uint8_t function, uint16_t offset) {
+    pci_config_reads++;
+    
+    volatile uint8_t *ecam = pci_ecam_address(bus, device, function, offset);
+    if (ecam) {
+        return *(volatile uint32_t *)ecam;
+    }
+    
+    /* Legacy mechanism only reaches the first 256 bytes */
+    if (offset >= PCI_CONFIG_SPACE_SIZE) {
+        return 0xFFFFFFFF;
+    }
+    
+    uint32_t address = (1U << 31) | ((uint32_t)bus << 16) | ((uint32_t)device << 11) | 
                        ((uint32_t)function << 8) | (offset & 0xFC);
     
     outl(PCI_CONFIG_ADDRESS, address);
     return inl(PCI_CONFIG_DATA);
 }
 
-static uint16_t pci_config_read_word(uint8_t bus, uint8_t device, uint8_t function, uint8_t offset) {
+uint16_t pci_config_read_word(uint8_t bus, uint8_t device, uint8_t function, uint16_t offset) {
     uint32_t dword = pci_config_read_dword(bus, device, function, offset);
     return (uint16_t)(dword >> ((offset & 2) * 8));
 }
 
-static uint8_t pci_config_read_byte(uint8_t bus, uint8_t device, uint8_t function, uint8_t offset) {
+uint8_t pci_config_read_byte(uint8_t bus, uint8_t device, uint8_t function, uint16_t offset) {
     uint32_t dword = pci_config_read_dword(bus, device, function, offset);
     return (uint8_t)(dword >> ((offset & 3) * 8));
 }
 
-static void pci_config_write_dword(uint8_t bus, uint8_t device, uint8_t function, uint8_t offset, uint32_t value) {
-    uint32_t address = (1 << 31) | ((uint32_t)bus << 16) | ((uint32_t)device << 11) | 
+void pci_config_write_dword(uint8_t bus, uint8_t device, uint8_t function, uint16_t offset, uint32_t value) {
+    volatile uint8_t *ecam = pci_ecam_address(bus, device, function, offset);
+    if (ecam) {
+        *(volatile uint32_t *)ecam = value;
+        return;
+    }
+    
+    if (offset >= PCI_CONFIG_SPACE_SIZE) {
+        return;
+    }
+    
+    uint32_t address = (1U << 31) | ((uint32_t)bus << 16) | ((uint32_t)device << 11) | 
                        ((uint32_t)function << 8) | (offset & 0xFC);
     
     outl(PCI_CONFIG_ADDRESS, address);
     outl(PCI_CONFIG_DATA, value);
 }
 
+void pci_config_write_word(uint8_t bus, uint8_t device, uint8_t function, uint16_t offset, uint16_t value) {
+    uint32_t dword = pci_config_read_dword(bus, device, function, offset);
+    uint32_t shift = (offset & 2) * 8;
+    
+    dword = (dword & ~(0xFFFFU << shift)) | ((uint32_t)value << shift);
+    pci_config_write_dword(bus, device, function, offset, dword);
+}
+
+/* Whether offsets past 256 are reachable for this device */
+int pci_has_extended_config(struct pci_device *device) {
+    return device && pci_ecam.base &&
+           device->bus >= pci_ecam.start_bus && device->bus <= pci_ecam.end_bus;
+}
+
 /* Get vendor name string */
 static const char *pci_get_vendor_name(uint16_t vendor_id) {
     switch (vendor_id) {
@@ -185,12 +231,6 @@ static const char *pci_get_class_name(uint8_t class_code, uint8_t subclass) {
     }
 }
 
-/* Check if device exists */
-static int pci_device_exists(uint8_t bus, uint8_t device, uint8_t function) {
-    uint16_t vendor_id = pci_config_read_word(bus, device, function, PCI_VENDOR_ID);
-    return (vendor_id != 0xFFFF);
-}
-
 /* Read BAR (Base Address Register) */
 static uint32_t pci_read_bar(uint8_t bus, uint8_t device, uint8_t function, uint8_t bar_num) {
     uint8_t bar_offset = PCI_BAR0 + (bar_num * 4);
@@ -198,31 +238,47 @@ static uint32_t pci_read_bar(uint8_t bus, uint8_t device, uint8_t function, uint
 }
 
 /* Create a new PCI device structure */
-static struct pci_device *pci_create_device(uint8_t bus, uint8_t device, uint8_t function) {
+static struct pci_device *pci_create_device(uint8_t bus, uint8_t device, uint8_t function, uint16_t vendor_id) {
     struct pci_device *pci_dev = (struct pci_device *)kmalloc(sizeof(struct pci_device));
     if (!pci_dev) {
         return NULL;
     }
-
+    
+    /* Identity and class come from two dwords */
+    uint32_t id = pci_config_read_dword(bus, device, function, PCI_VENDOR_ID);
+    uint32_t class_rev = pci_config_read_dword(bus, device, function, PCI_REVISION_ID);
+    uint32_t header = pci_config_read_dword(bus, device, function, PCI_CACHE_LINE);
+    
     pci_dev->bus = bus;
     pci_dev->device = device;
     pci_dev->function = function;
-    pci_dev->vendor_id = pci_config_read_word(bus, device, function, PCI_VENDOR_ID);
-    pci_dev->device_id = pci_config_read_word(bus, device, function, PCI_DEVICE_ID);
-    pci_dev->class_code = pci_config_read_byte(bus, device, function, PCI_CLASS);
-    pci_dev->subclass = pci_config_read_byte(bus, device, function, PCI_SUBCLASS);
-    pci_dev->prog_if = pci_config_read_byte(bus, device, function, PCI_PROG_IF);
-    pci_dev->header_type = pci_config_read_byte(bus, device, function, PCI_HEADER_TYPE);
-
-    /* Read BARs */
+    pci_dev->vendor_id = vendor_id;
+    pci_dev->device_id = (uint16_t)(id >> 16);
+    pci_dev->class_code = (uint8_t)(class_rev >> 24);
+    pci_dev->subclass = (uint8_t)(class_rev >> 16);
+    pci_dev->prog_if = (uint8_t)(class_rev >> 8);
+    pci_dev->header_type = (uint8_t)(header >> 16);
+    pci_dev->secondary_bus = 0;
+    pci_dev->dma_mask = ~0ULL;      /* Drivers narrow this with dma_set_mask() */
+    
+    /* Type 0 headers have six BARs, bridges two (the rest are bus numbers) */
+    int bar_count = (pci_dev->header_type & PCI_HEADER_TYPE_MASK) == PCI_HEADER_TYPE_BRIDGE ? 2 : 6;
     for (int i = 0; i < 6; i++) {
-        pci_dev->bar[i] = pci_read_bar(bus, device, function, i);
+        pci_dev->bar[i] = i < bar_count ? pci_read_bar(bus, device, function, i) : 0;
     }
-
+    
+    uint32_t irq = pci_config_read_dword(bus, device, function, PCI_INTERRUPT_LINE);
+    pci_dev->irq_line = (uint8_t)irq;
+    pci_dev->irq_pin = (uint8_t)(irq >> 8);
+    
     pci_dev->vendor_name = pci_get_vendor_name(pci_dev->vendor_id);
     pci_dev->device_name = pci_get_class_name(pci_dev->class_code, pci_dev->subclass);
     pci_dev->next = NULL;
-
+    
+    pci_dev->pcie_cap = pci_find_capability(pci_dev, PCI_CAP_ID_EXP);
+    pci_dev->msi_cap = pci_find_capability(pci_dev, PCI_CAP_ID_MSI);
+    pci_dev->msix_cap = pci_find_capability(pci_dev, PCI_CAP_ID_MSIX);
+    
     return pci_dev;
 }
 
@@ -240,46 +296,169 @@ static void pci_add_device(struct pci_device *device) {
     pci_device_count++;
 }
 
-/* Enumerate all PCI devices */
+static void pci_scan_bus(uint8_t bus);
+
+/* Record one function; follow PCI-to-PCI bridges to the bus behind them */
+static void pci_scan_function(uint8_t bus, uint8_t device, uint8_t function, uint16_t vendor_id) {
+    if (pci_device_count >= MAX_PCI_DEVICES) {
+        return;
+    }
+    
+    struct pci_device *pci_dev = pci_create_device(bus, device, function, vendor_id);
+    if (!pci_dev) {
+        return;
+    }
+    pci_add_device(pci_dev);
+    
+    serial_puts("[NEURAL-PCI] Device detected: ");
+    print_hex(bus);
+    serial_puts(":");
+    print_hex(device);
+    serial_puts(":");
+    print_hex(function);
+    serial_puts(" - ");
+    serial_puts(pci_dev->vendor_name);
+    serial_puts(" (");
+    serial_puts(pci_dev->device_name);
+    serial_puts(")\n");
+    
+    if ((pci_dev->header_type & PCI_HEADER_TYPE_MASK) == PCI_HEADER_TYPE_BRIDGE) {
+        pci_dev->secondary_bus = pci_config_read_byte(bus, device, function, PCI_SECONDARY_BUS);
+        
+        /* A secondary bus at or below ours is unconfigured or a loop */
+        if (pci_dev->secondary_bus > bus) {
+            pci_scan_bus(pci_dev->secondary_bus);
+        }
+    }
+}
+
+static void pci_scan_device(uint8_t bus, uint8_t device) {
+    uint16_t vendor_id = pci_config_read_word(bus, device, 0, PCI_VENDOR_ID);
+    if (vendor_id == 0xFFFF) {
+        return;
+    }
+    
+    pci_scan_function(bus, device, 0, vendor_id);
+    
+    /* If not a multi-function device, don't check other functions */
+    uint8_t header_type = pci_config_read_byte(bus, device, 0, PCI_HEADER_TYPE);
+    if ((header_type & PCI_HEADER_TYPE_MULTIFUNCTION) == 0) {
+        return;
+    }
+    
+    for (uint8_t function = 1; function < 8; function++) {
+        vendor_id = pci_config_read_word(bus, device, function, PCI_VENDOR_ID);
+        if (vendor_id != 0xFFFF) {
+            pci_scan_function(bus, device, function, vendor_id);
+        }
+    }
+}
+
+static void pci_scan_bus(uint8_t bus) {
+    if (pci_bus_scanned[bus / 8] & (1 << (bus % 8))) {
+        return;
+    }
+    pci_bus_scanned[bus / 8] |= (uint8_t)(1 << (bus % 8));
+    
+    for (uint8_t device = 0; device < 32; device++) {
+        pci_scan_device(bus, device);
+    }
+}
+
+/* Enumerate PCI devices - only buses reachable from the host bridges */
 void pci_enumerate_devices(void) {
     serial_puts("[NEURAL-PCI] Initiating hardware matrix scan...\n");
     
-    for (uint16_t bus = 0; bus < 256; bus++) {
-        for (uint8_t device = 0; device < 32; device++) {
-            for (uint8_t function = 0; function < 8; function++) {
-                if (pci_device_exists(bus, device, function)) {
-                    struct pci_device *pci_dev = pci_create_device(bus, device, function);
-                    if (pci_dev) {
-                        pci_add_device(pci_dev);
-                        
-                        serial_puts("[NEURAL-PCI] Device detected: ");
-                        print_hex(bus);
-                        serial_puts(":");
-                        print_hex(device);
-                        serial_puts(":");
-                        print_hex(function);
-                        serial_puts(" - ");
-                        serial_puts(pci_dev->vendor_name);
-                        serial_puts(" (");
-                        serial_puts(pci_dev->device_name);
-                        serial_puts(")\n");
-                    }
-                    
-                    /* If not a multi-function device, don't check other functions */
-                    if (function == 0) {
-                        uint8_t header_type = pci_config_read_byte(bus, device, function, PCI_HEADER_TYPE);
-                        if ((header_type & 0x80) == 0) {
-                            break;
-                        }
-                    }
-                }
+    pci_config_reads = 0;
+    for (int i = 0; i < (int)sizeof(pci_bus_scanned); i++) {
+        pci_bus_scanned[i] = 0;
+    }
+    
+    /* A multi-function host bridge has one root bus per function */
+    boot_profile_begin("pci: bus scan");
+    uint8_t header_type = pci_config_read_byte(0, 0, 0, PCI_HEADER_TYPE);
+    if ((header_type & PCI_HEADER_TYPE_MULTIFUNCTION) == 0) {
+        pci_scan_bus(0);
+    } else {
+        for (uint8_t function = 0; function < 8; function++) {
+            if (pci_config_read_word(0, 0, function, PCI_VENDOR_ID) != 0xFFFF) {
+                pci_scan_bus(function);
             }
         }
     }
+    boot_profile_end();
     
     serial_puts("[NEURAL-PCI] Hardware matrix scan complete - ");
     print_dec(pci_device_count);
-    serial_puts(" neural devices detected\n");
+    serial_puts(" neural devices detected, ");
+    print_dec(pci_config_reads);
+    serial_puts(pci_ecam.base ? " ECAM config reads\n" : " port I/O config reads\n");
+}
+
+/* Physical address of a memory BAR, joining the upper half of 64-bit BARs */
+uint64_t pci_get_bar_address(struct pci_device *device, uint8_t bar_num) {
+    if (!device || bar_num >= 6) {
+        return 0;
+    }
+    
+    uint32_t bar = device->bar[bar_num];
+    if (bar & 0x1) {
+        return bar & ~0x3U;
+    }
+    
+    uint64_t address = bar & ~0xFU;
+    if ((bar & 0x6) == 0x4 && bar_num < 5) {
+        address |= (uint64_t)device->bar[bar_num + 1] << 32;
+    }
+    return address;
+}
+
+/* Walk the standard capability list; returns the capability's offset or 0 */
+uint8_t pci_find_capability(struct pci_device *device, uint8_t cap_id) {
+    if (!device) {
+        return 0;
+    }
+    
+    uint16_t status = pci_config_read_word(device->bus, device->device, device->function, PCI_STATUS);
+    if (!(status & PCI_STATUS_CAP_LIST)) {
+        return 0;
+    }
+    
+    uint8_t offset = (uint8_t)(device->header_type & PCI_HEADER_TYPE_MASK) == PCI_HEADER_TYPE_CARDBUS ?
+                     PCI_CAPABILITY_LIST_CARDBUS : PCI_CAPABILITY_LIST;
+    uint8_t pointer = pci_config_read_byte(device->bus, device->device, device->function, offset) & 0xFC;
+    
+    /* Bounded walk: a broken list must not hang the scan */
+    for (int guard = 0; pointer >= 0x40 && guard < 48; guard++) {
+        uint16_t header = pci_config_read_word(device->bus, device->device, device->function, pointer);
+        if ((header & 0xFF) == cap_id) {
+            return pointer;
+        }
+        pointer = (uint8_t)(header >> 8) & 0xFC;
+    }
+    
+    return 0;
+}
+
+/* Walk the extended capability list (offset 0x100+, ECAM only) */
+uint16_t pci_find_ext_capability(struct pci_device *device, uint16_t cap_id) {
+    if (!pci_has_extended_config(device)) {
+        return 0;
+    }
+    
+    uint16_t offset = PCI_CONFIG_SPACE_SIZE;
+    for (int guard = 0; offset >= PCI_CONFIG_SPACE_SIZE && guard < 480; guard++) {
+        uint32_t header = pci_config_read_dword(device->bus, device->device, device->function, offset);
+        if (header == 0 || header == 0xFFFFFFFF) {
+            return 0;
+        }
+        if ((header & 0xFFFF) == cap_id) {
+            return offset;
+        }
+        offset = (uint16_t)((header >> 20) & 0xFFC);
+    }
+    
+    return 0;
 }
 
 /* Find device by class and subclass */
@@ -366,6 +545,17 @@ void pci_print_device_info(struct pci_device *device) {
         }
     }
     
+    if (device->msix_cap || device->msi_cap) {
+        serial_puts(device->msix_cap ? "[INFO] Message signalled interrupts: MSI-X\n" :
+                                       "[INFO] Message signalled interrupts: MSI\n");
+    }
+    
+    if (device->pcie_cap) {
+        serial_puts("[INFO] PCI Express capability at ");
+        print_hex(device->pcie_cap);
+        serial_puts(pci_has_extended_config(device) ? " (extended config space)\n" : "\n");
+    }
+    
     serial_puts("[NEURAL-PCI] === End Neural Profile ===\n");
 }
 
@@ -392,6 +582,10 @@ void pci_init(void) {
     pci_device_list = NULL;
     pci_device_count = 0;
     
+    /* ECAM replaces port I/O when firmware describes it */
+    BOOT_PROFILE_STEP(acpi_init());
+    BOOT_PROFILE_STEP(pci_ecam_init());
+    
     /* Enumerate all PCI devices */
     pci_enumerate_devices();
     
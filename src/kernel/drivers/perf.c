@@ -0,0 +1,494 @@
+/* perf.c - Brandon Media OS Neural Frame Profiler Implementation
+ * Per-Stage TSC Timing with Rolling Percentiles and HUD Overlay
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "kernel/perf.h"
+#include "kernel/tsc.h"
+#include "kernel/framebuffer.h"
+#include "kernel/input.h"
+
+/* Overlay Layout */
+#define PERF_OVERLAY_WIDTH      280
+#define PERF_OVERLAY_LINE       12
+#define PERF_BAR_WIDTH          200     /* Pixels representing one frame budget */
+#define PERF_BAR_HEIGHT         10
+#define PERF_GRAPH_HEIGHT       40
+#define PERF_SUMMARY_INTERVAL   30      /* Recompute percentiles every N frames */
+
+/* External functions */
+extern void serial_puts(const char *s);
+extern void print_dec(uint64_t num);
+extern int snprintf(char *str, size_t size, const char *format, ...);
+
+/* Rolling Sample Window */
+typedef struct {
+    uint32_t samples[PERF_WINDOW_FRAMES];
+    uint32_t count;
+    uint64_t start_tsc;
+    uint32_t last_us;
+    perf_stage_stats_t summary;
+} perf_track_t;
+
+/* Profiler State */
+typedef struct {
+    perf_track_t stages[PERF_STAGE_COUNT];
+    perf_track_t frame;
+    uint32_t head;                  /* Write index shared by all tracks */
+    uint64_t frame_count;
+    bool overlay_enabled;
+    bool headless;
+} perf_system_t;
+
+/* Input latency survives perf_reset(); only perf_latency_reset() clears it */
+static perf_histogram_t perf_latency[PERF_LATENCY_COUNT];
+
+static const char *perf_latency_names[PERF_LATENCY_COUNT] = {
+    "queue", "dispatch", "widget", "photon"
+};
+
+static perf_system_t perf_system;
+static bool perf_initialized = false;
+
+/* Stage colors for the overlay bar */
+static const uint32_t perf_stage_colors[PERF_STAGE_COUNT] = {
+    NEURAL_CYAN,        /* update */
+    NEURAL_PURPLE,      /* effects */
+    NEURAL_LIGHT_BLUE,  /* widgets */
+    NEURAL_GREEN,       /* 3d */
+    NEURAL_GOLD         /* present */
+};
+
+static const char *perf_stage_names[PERF_STAGE_COUNT] = {
+    "update", "effects", "widgets", "3d", "present"
+};
+
+static void perf_input_handler(input_event_t *event);
+
+/* Initialize Frame Profiler */
+int perf_init(void) {
+    if (perf_initialized) {
+        return 0;
+    }
+
+    memset(&perf_system, 0, sizeof(perf_system_t));
+    perf_initialized = true;
+
+    /* F3 toggles the overlay */
+    input_add_event_handler(perf_input_handler);
+
+    serial_puts("[PERF] Neural frame profiler online (F3 toggles overlay)\n");
+    return 0;
+}
+
+const char *perf_stage_name(perf_stage_t stage) {
+    if (stage >= PERF_STAGE_COUNT) {
+        return "unknown";
+    }
+    return perf_stage_names[stage];
+}
+
+/* Reset all collected samples */
+void perf_reset(void) {
+    bool overlay = perf_system.overlay_enabled;
+    bool headless = perf_system.headless;
+
+    memset(&perf_system, 0, sizeof(perf_system_t));
+    perf_system.overlay_enabled = overlay;
+    perf_system.headless = headless;
+}
+
+/* Sort helper for percentile extraction (window is small) */
+static void perf_sort(uint32_t *values, uint32_t count) {
+    for (uint32_t i = 1; i < count; i++) {
+        uint32_t v = values[i];
+        uint32_t j = i;
+        while (j > 0 && values[j - 1] > v) {
+            values[j] = values[j - 1];
+            j--;
+        }
+        values[j] = v;
+    }
+}
+
+static void perf_track_summarize(perf_track_t *track) {
+    uint32_t sorted[PERF_WINDOW_FRAMES];
+    uint32_t n = track->count;
+
+    track->summary.last_us = track->last_us;
+    if (n == 0) {
+        track->summary.p50_us = track->summary.p95_us = 0;
+        track->summary.p99_us = track->summary.max_us = 0;
+        return;
+    }
+
+    memcpy(sorted, track->samples, n * sizeof(uint32_t));
+    perf_sort(sorted, n);
+
+    track->summary.p50_us = sorted[(n * 50) / 100];
+    track->summary.p95_us = sorted[(n * 95) / 100];
+    track->summary.p99_us = sorted[(n * 99) / 100];
+    track->summary.max_us = sorted[n - 1];
+}
+
+static void perf_summarize_all(void) {
+    for (int i = 0; i < PERF_STAGE_COUNT; i++) {
+        perf_track_summarize(&perf_system.stages[i]);
+    }
+    perf_track_summarize(&perf_system.frame);
+}
+
+/* Frame Boundaries */
+void perf_frame_begin(void) {
+    if (!perf_initialized) {
+        return;
+    }
+
+    /* Stages that do not run this frame record zero */
+    for (int i = 0; i < PERF_STAGE_COUNT; i++) {
+        perf_system.stages[i].last_us = 0;
+        perf_system.stages[i].start_tsc = 0;
+    }
+    perf_system.frame.start_tsc = rdtsc();
+}
+
+void perf_frame_end(void) {
+    if (!perf_initialized || perf_system.frame.start_tsc == 0) {
+        return;
+    }
+
+    uint32_t head = perf_system.head;
+    perf_system.frame.last_us = (uint32_t)tsc_cycles_to_us(rdtsc() - perf_system.frame.start_tsc);
+    perf_system.frame.start_tsc = 0;
+
+    /* Commit this frame's samples to the rolling window */
+    perf_system.frame.samples[head] = perf_system.frame.last_us;
+    if (perf_system.frame.count < PERF_WINDOW_FRAMES) {
+        perf_system.frame.count++;
+    }
+    for (int i = 0; i < PERF_STAGE_COUNT; i++) {
+        perf_track_t *track = &perf_system.stages[i];
+        track->samples[head] = track->last_us;
+        if (track->count < PERF_WINDOW_FRAMES) {
+            track->count++;
+        }
+    }
+
+    perf_system.head = (head + 1) % PERF_WINDOW_FRAMES;
+    perf_system.frame_count++;
+
+    fb_update_frame_stats(perf_system.frame.last_us);
+
+    if ((perf_system.frame_count % PERF_SUMMARY_INTERVAL) == 0) {
+        perf_summarize_all();
+    }
+
+    if (perf_system.headless && (perf_system.frame_count % PERF_DUMP_INTERVAL) == 0) {
+        perf_dump_serial();
+    }
+}
+
+/* Stage Boundaries - stages may be entered several times per frame */
+void perf_stage_begin(perf_stage_t stage) {
+    if (!perf_initialized || stage >= PERF_STAGE_COUNT) {
+        return;
+    }
+    perf_system.stages[stage].start_tsc = rdtsc();
+}
+
+void perf_stage_end(perf_stage_t stage) {
+    if (!perf_initialized || stage >= PERF_STAGE_COUNT) {
+        return;
+    }
+
+    perf_track_t *track = &perf_system.stages[stage];
+    if (track->start_tsc == 0) {
+        return;
+    }
+
+    track->last_us += (uint32_t)tsc_cycles_to_us(rdtsc() - track->start_tsc);
+    track->start_tsc = 0;
+}
+
+void perf_get_stage_stats(perf_stage_t stage, perf_stage_stats_t *stats) {
+    if (!stats || stage >= PERF_STAGE_COUNT) {
+        return;
+    }
+    perf_track_summarize(&perf_system.stages[stage]);
+    *stats = perf_system.stages[stage].summary;
+}
+
+void perf_get_frame_stats(perf_stage_stats_t *stats) {
+    if (!stats) {
+        return;
+    }
+    perf_track_summarize(&perf_system.frame);
+    *stats = perf_system.frame.summary;
+}
+
+/* Overlay Control */
+void perf_overlay_enable(bool enable) {
+    perf_system.overlay_enabled = enable;
+}
+
+void perf_overlay_toggle(void) {
+    perf_system.overlay_enabled = !perf_system.overlay_enabled;
+    serial_puts(perf_system.overlay_enabled ? "[PERF] Overlay enabled\n" : "[PERF] Overlay disabled\n");
+}
+
+bool perf_overlay_enabled(void) {
+    return perf_system.overlay_enabled;
+}
+
+static void perf_input_handler(input_event_t *event) {
+    if (event->type == INPUT_EVENT_KEY_PRESS && event->data.key.key == KEY_F3) {
+        perf_overlay_toggle();
+    }
+}
+
+static uint32_t perf_us_to_pixels(uint32_t us) {
+    return (us * PERF_BAR_WIDTH) / PERF_FRAME_BUDGET_US;
+}
+
+/* Render HUD overlay: per-stage text, stacked bar and frame history graph */
+void perf_overlay_render(void) {
+    if (!perf_initialized || !perf_system.overlay_enabled) {
+        return;
+    }
+
+    framebuffer_device_t *fb = framebuffer_get_device();
+    if (!fb || fb->width < PERF_OVERLAY_WIDTH + 8) {
+        return;
+    }
+
+    uint32_t height = (PERF_STAGE_COUNT + 3) * PERF_OVERLAY_LINE + PERF_BAR_HEIGHT + PERF_GRAPH_HEIGHT + 24;
+    uint32_t x = fb->width - PERF_OVERLAY_WIDTH - 8;
+    uint32_t y = 8;
+    char line[64];
+
+    fb_fill_rect(x, y, PERF_OVERLAY_WIDTH, height, NEURAL_DARK_BLUE);
+    fb_draw_rect(x, y, PERF_OVERLAY_WIDTH, height, NEURAL_CYAN, 1);
+
+    uint32_t ty = y + 4;
+    perf_stage_stats_t *frame = &perf_system.frame.summary;
+    uint32_t fps = perf_system.frame.last_us ? 1000000 / perf_system.frame.last_us : 0;
+    snprintf(line, sizeof(line), "FRAME %uus %ufps p99 %uus",
+             perf_system.frame.last_us, fps, frame->p99_us);
+    fb_draw_string(x + 4, ty, line, NEURAL_WHITE, NEURAL_DARK_BLUE);
+    ty += PERF_OVERLAY_LINE;
+
+    for (int i = 0; i < PERF_STAGE_COUNT; i++) {
+        perf_track_t *track = &perf_system.stages[i];
+        snprintf(line, sizeof(line), "%-8s %6u p95 %6u max %6u",
+                 perf_stage_names[i], track->last_us, track->summary.p95_us, track->summary.max_us);
+        fb_draw_string(x + 4, ty, line, perf_stage_colors[i], NEURAL_DARK_BLUE);
+        ty += PERF_OVERLAY_LINE;
+    }
+
+    /* Input-to-photon */
+    perf_histogram_t *photon = &perf_latency[PERF_LATENCY_PHOTON];
+    snprintf(line, sizeof(line), "INPUT>PHOTON p50 %u p95 %u max %u",
+             perf_hist_percentile(photon, 50), perf_hist_percentile(photon, 95), photon->max_us);
+    fb_draw_string(x + 4, ty, line, NEURAL_WHITE, NEURAL_DARK_BLUE);
+    ty += PERF_OVERLAY_LINE;
+
+    /* Stacked stage bar for the current frame */
+    ty += 4;
+    uint32_t bx = x + 4;
+    uint32_t bar_limit = PERF_OVERLAY_WIDTH - 8;
+    for (int i = 0; i < PERF_STAGE_COUNT; i++) {
+        uint32_t w = perf_us_to_pixels(perf_system.stages[i].last_us);
+        if (bx + w > x + 4 + bar_limit) {
+            w = (x + 4 + bar_limit) - bx;
+        }
+        if (w > 0) {
+            fb_fill_rect(bx, ty, w, PERF_BAR_HEIGHT, perf_stage_colors[i]);
+            bx += w;
+        }
+    }
+    /* 16.6ms budget marker */
+    fb_fill_rect(x + 4 + PERF_BAR_WIDTH, ty - 2, 1, PERF_BAR_HEIGHT + 4, NEURAL_RED);
+    ty += PERF_BAR_HEIGHT + 6;
+
+    /* Frame time history, newest on the right */
+    uint32_t columns = PERF_OVERLAY_WIDTH - 8;
+    if (columns > perf_system.frame.count) {
+        columns = perf_system.frame.count;
+    }
+    uint32_t graph_base = ty + PERF_GRAPH_HEIGHT;
+    for (uint32_t c = 0; c < columns; c++) {
+        uint32_t idx = (perf_system.head + PERF_WINDOW_FRAMES - columns + c) % PERF_WINDOW_FRAMES;
+        uint32_t us = perf_system.frame.samples[idx];
+        uint32_t h = (us * (PERF_GRAPH_HEIGHT / 2)) / PERF_FRAME_BUDGET_US;
+        if (h > PERF_GRAPH_HEIGHT) h = PERF_GRAPH_HEIGHT;
+        if (h == 0) continue;
+        uint32_t color = us > PERF_FRAME_BUDGET_US ? NEURAL_RED : NEURAL_GREEN;
+        fb_fill_rect(x + 4 + (PERF_OVERLAY_WIDTH - 8 - columns) + c, graph_base - h, 1, h, color);
+    }
+    /* Budget line sits at half graph height */
+    fb_fill_rect(x + 4, graph_base - PERF_GRAPH_HEIGHT / 2, PERF_OVERLAY_WIDTH - 8, 1, NEURAL_RED);
+}
+
+/* Headless Mode: periodic parsable serial output */
+void perf_set_headless(bool headless) {
+    perf_system.headless = headless;
+}
+
+static void perf_dump_track(const char *name, perf_track_t *track) {
+    perf_track_summarize(track);
+    serial_puts("[PERF] stage=");
+    serial_puts(name);
+    serial_puts(" last=");
+    print_dec(track->summary.last_us);
+    serial_puts(" p50=");
+    print_dec(track->summary.p50_us);
+    serial_puts(" p95=");
+    print_dec(track->summary.p95_us);
+    serial_puts(" p99=");
+    print_dec(track->summary.p99_us);
+    serial_puts(" max=");
+    print_dec(track->summary.max_us);
+    serial_puts(" us\n");
+}
+
+void perf_dump_serial(void) {
+    if (!perf_initialized) {
+        return;
+    }
+
+    serial_puts("[PERF] frames=");
+    print_dec(perf_system.frame_count);
+    serial_puts(" window=");
+    print_dec(perf_system.frame.count);
+    serial_puts(" budget=");
+    print_dec(PERF_FRAME_BUDGET_US);
+    serial_puts(" us\n");
+
+    perf_dump_track("frame", &perf_system.frame);
+    for (int i = 0; i < PERF_STAGE_COUNT; i++) {
+        perf_dump_track(perf_stage_names[i], &perf_system.stages[i]);
+    }
+    perf_latency_dump();
+}
+
+/* Input Latency Tracing */
+void perf_latency_record(perf_latency_stage_t stage, uint64_t start_tsc) {
+    if (stage >= PERF_LATENCY_COUNT || start_tsc == 0) {
+        return;
+    }
+
+    uint64_t now = rdtsc();
+    uint64_t us = now > start_tsc ? tsc_cycles_to_us(now - start_tsc) : 0;
+    perf_hist_add(&perf_latency[stage], us > 0xFFFFFFFF ? 0xFFFFFFFF : (uint32_t)us);
+}
+
+void perf_latency_get(perf_latency_stage_t stage, perf_histogram_t *hist) {
+    if (stage >= PERF_LATENCY_COUNT || !hist) {
+        return;
+    }
+    *hist = perf_latency[stage];
+}
+
+const char *perf_latency_name(perf_latency_stage_t stage) {
+    if (stage >= PERF_LATENCY_COUNT) {
+        return "unknown";
+    }
+    return perf_latency_names[stage];
+}
+
+void perf_latency_reset(void) {
+    memset(perf_latency, 0, sizeof(perf_latency));
+}
+
+void perf_latency_dump(void) {
+    char tag[32];
+
+    for (int i = 0; i < PERF_LATENCY_COUNT; i++) {
+        if (perf_latency[i].count == 0) {
+            continue;
+        }
+        snprintf(tag, sizeof(tag), "[PERF] latency=%s", perf_latency_names[i]);
+        perf_hist_print(tag, &perf_latency[i]);
+    }
+}
+
+/* Log2 Histogram Helpers */
+void perf_hist_reset(perf_histogram_t *hist) {
+    if (hist) {
+        memset(hist, 0, sizeof(perf_histogram_t));
+    }
+}
+
+void perf_hist_add(perf_histogram_t *hist, uint32_t value_us) {
+    if (!hist) {
+        return;
+    }
+
+    /* Bucket b holds values in [2^(b-1), 2^b) with bucket 0 for 0us */
+    uint32_t bucket = 0;
+    uint32_t v = value_us;
+    while (v && bucket < PERF_HIST_BUCKETS - 1) {
+        v >>= 1;
+        bucket++;
+    }
+
+    hist->buckets[bucket]++;
+    hist->count++;
+    hist->sum_us += value_us;
+    if (value_us > hist->max_us) {
+        hist->max_us = value_us;
+    }
+}
+
+/* Returns the upper bound of the bucket containing the percentile */
+uint32_t perf_hist_percentile(const perf_histogram_t *hist, uint32_t percent) {
+    if (!hist || hist->count == 0) {
+        return 0;
+    }
+
+    uint64_t target = (hist->count * percent + 99) / 100;
+    uint64_t seen = 0;
+
+    for (uint32_t b = 0; b < PERF_HIST_BUCKETS; b++) {
+        seen += hist->buckets[b];
+        if (seen >= target) {
+            uint32_t bound = b == 0 ? 0 : (1u << b) - 1;
+            return bound < hist->max_us ? bound : hist->max_us;
+        }
+    }
+    return hist->max_us;
+}
+
+void perf_hist_print(const char *tag, const perf_histogram_t *hist) {
+    if (!hist) {
+        return;
+    }
+
+    serial_puts(tag);
+    serial_puts(" count=");
+    print_dec(hist->count);
+    serial_puts(" avg=");
+    print_dec(hist->count ? hist->sum_us / hist->count : 0);
+    serial_puts(" p50=");
+    print_dec(perf_hist_percentile(hist, 50));
+    serial_puts(" p99=");
+    print_dec(perf_hist_percentile(hist, 99));
+    serial_puts(" max=");
+    print_dec(hist->max_us);
+    serial_puts(" us\n");
+
+    for (uint32_t b = 0; b < PERF_HIST_BUCKETS; b++) {
+        if (hist->buckets[b] == 0) {
+            continue;
+        }
+        serial_puts(tag);
+        serial_puts("   <");
+        print_dec(b == 0 ? 1 : (1u << b));
+        serial_puts("us: ");
+        print_dec(hist->buckets[b]);
+        serial_puts("\n");
+    }
+}
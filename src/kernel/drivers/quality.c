@@ -0,0 +1,185 @@
+/* quality.c - Brandon Media OS Neural Quality Governor
+ * Sheds and Restores Rendering Detail to Hold the Frame Budget
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "kernel/quality.h"
+#include "kernel/particles.h"
+#include "kernel/effects.h"
+#include "kernel/gui.h"
+#include "kernel/perf.h"
+
+/* External functions */
+extern void serial_puts(const char *s);
+extern void print_dec(uint64_t num);
+
+/* Detail levels - each step sheds one more thing, cheapest losses first */
+static const quality_level_t quality_levels[QUALITY_LEVELS] = {
+    /* name        particles     fx  scanlines  parallax  anim */
+    { "full",      PARTICLE_MAX, 0,  true,      1.0f,     1 },
+    { "high",      1024,         0,  true,      1.0f,     1 },
+    { "medium",    1024,         1,  true,      1.0f,     1 },
+    { "low",       256,          1,  false,     1.0f,     1 },
+    { "minimal",   256,          2,  false,     0.0f,     1 },
+    { "survival",  0,            2,  false,     0.0f,     2 },
+};
+
+/* Governor State */
+typedef struct {
+    bool enabled;
+    uint32_t level;
+    uint32_t budget_us;
+    uint32_t average_us;            /* EWMA, frame microseconds */
+    uint32_t over_budget;           /* Consecutive smoothed frames over budget */
+    uint32_t headroom;              /* Consecutive smoothed frames with headroom */
+    uint32_t settle;                /* Samples left to ignore after a change */
+    uint64_t frames;
+    uint64_t sheds;
+    uint64_t restores;
+} quality_governor_t;
+
+static quality_governor_t governor;
+static bool governor_initialized = false;
+
+/* Push a level's settings into the subsystems that honour them */
+static void quality_apply(uint32_t level) {
+    const quality_level_t *q = &quality_levels[level];
+    
+    particle_engine_set_budget(q->particle_budget);
+    effects_set_detail(q->effect_detail_shift, q->scanlines);
+    gui_set_parallax_strength(q->parallax_strength);
+    gui_set_animation_divisor(q->animation_divisor);
+    
+    governor.level = level;
+    governor.over_budget = 0;
+    governor.headroom = 0;
+    governor.settle = QUALITY_SETTLE_FRAMES;
+}
+
+static void quality_log_change(const char *what) {
+    serial_puts("[NEURAL-QOS] ");
+    serial_puts(what);
+    serial_puts(" to ");
+    serial_puts(quality_levels[governor.level].name);
+    serial_puts(" (avg ");
+    print_dec(governor.average_us);
+    serial_puts("us, budget ");
+    print_dec(governor.budget_us);
+    serial_puts("us)\n");
+}
+
+/* Initialize governor at full detail */
+int quality_governor_init(uint32_t budget_us) {
+    if (governor_initialized) {
+        return 0;
+    }
+    
+    memset(&governor, 0, sizeof(quality_governor_t));
+    governor.budget_us = budget_us ? budget_us : PERF_FRAME_BUDGET_US;
+    governor.enabled = true;
+    quality_apply(0);
+    governor_initialized = true;
+    
+    serial_puts("[NEURAL-QOS] Quality governor online, budget ");
+    print_dec(governor.budget_us);
+    serial_puts("us\n");
+    return 0;
+}
+
+void quality_governor_enable(bool enable) {
+    governor.enabled = enable;
+    governor.over_budget = 0;
+    governor.headroom = 0;
+}
+
+void quality_governor_set_budget(uint32_t budget_us) {
+    if (budget_us) {
+        governor.budget_us = budget_us;
+    }
+}
+
+/* Feed one frame's render time; sheds fast, restores slowly */
+void quality_governor_submit(uint32_t frame_us) {
+    if (!governor_initialized) {
+        return;
+    }
+    
+    governor.frames++;
+    
+    /* Fixed-point EWMA: avg += (sample - avg) / 8 */
+    if (governor.average_us == 0) {
+        governor.average_us = frame_us;
+    } else {
+        int32_t diff = (int32_t)frame_us - (int32_t)governor.average_us;
+        governor.average_us = (uint32_t)((int32_t)governor.average_us + (diff >> QUALITY_EWMA_SHIFT));
+    }
+    
+    if (!governor.enabled) {
+        return;
+    }
+    
+    /* Let the new level show up in the average before judging it */
+    if (governor.settle) {
+        governor.settle--;
+        return;
+    }
+    
+    if (governor.average_us > governor.budget_us) {
+        governor.headroom = 0;
+        if (++governor.over_budget >= QUALITY_SHED_FRAMES && governor.level + 1 < QUALITY_LEVELS) {
+            quality_apply(governor.level + 1);
+            governor.sheds++;
+            quality_log_change("Shedding load");
+        }
+    } else if (governor.average_us * 100 < governor.budget_us * QUALITY_HEADROOM_PERCENT) {
+        governor.over_budget = 0;
+        if (++governor.headroom >= QUALITY_RESTORE_FRAMES && governor.level > 0) {
+            quality_apply(governor.level - 1);
+            governor.restores++;
+            quality_log_change("Restoring quality");
+        }
+    } else {
+        /* Inside the band: hold the current level */
+        governor.over_budget = 0;
+        governor.headroom = 0;
+    }
+}
+
+/* Force a level */
+int quality_set_level(uint32_t level) {
+    if (!governor_initialized || level >= QUALITY_LEVELS) {
+        return -1;
+    }
+    
+    quality_apply(level);
+    return 0;
+}
+
+uint32_t quality_get_level(void) {
+    return governor.level;
+}
+
+const quality_level_t *quality_get_level_info(uint32_t level) {
+    if (level >= QUALITY_LEVELS) {
+        return NULL;
+    }
+    return &quality_levels[level];
+}
+
+/* Get governor statistics */
+void quality_get_stats(quality_stats_t *stats) {
+    if (!stats) {
+        return;
+    }
+    
+    stats->enabled = governor.enabled;
+    stats->level = governor.level;
+    stats->budget_us = governor.budget_us;
+    stats->average_us = governor.average_us;
+    stats->frames = governor.frames;
+    stats->sheds = governor.sheds;
+    stats->restores = governor.restores;
+}
@@ -0,0 +1,469 @@
+/* render_bench.c - Brandon Media OS Neural Render Benchmark
+ * Replays Fixed Scenes Off-Screen and Reports Timing and Frame Checksums
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "kernel/render_bench.h"
+#include "kernel/framebuffer.h"
+#include "kernel/graphics_3d.h"
+#include "kernel/gui.h"
+#include "kernel/particles.h"
+#include "kernel/effects.h"
+#include "kernel/quality.h"
+#include "kernel/memory.h"
+#include "kernel/perf.h"
+#include "kernel/tsc.h"
+
+#define RENDER_BENCH_MAX_WIDGETS    16
+#define RENDER_BENCH_GRID_CELLS     24      /* Neural grid quads per side */
+#define RENDER_BENCH_TEXT_LINES     20      /* Lines per text panel */
+#define RENDER_BENCH_LINE_HEIGHT    11
+
+/* FNV-1a, one 32-bit pixel per step */
+#define RENDER_BENCH_FNV_OFFSET     0x811C9DC5u
+#define RENDER_BENCH_FNV_PRIME      0x01000193u
+
+/* External functions */
+extern void serial_puts(const char *s);
+extern void print_dec(uint64_t num);
+extern void print_hex(uint64_t num);
+extern int snprintf(char *str, size_t size, const char *format, ...);
+
+/* Scene Callbacks - setup returns -1 when the scene can't run here */
+typedef struct {
+    const char *name;
+    int (*setup)(void);
+    void (*frame)(uint32_t frame, uint32_t time_ms);
+    void (*teardown)(void);
+} render_bench_scene_ops_t;
+
+/* Benchmark State */
+typedef struct {
+    fb_target_t target;
+    
+    /* Widgets owned by the running scene (never added to a layer) */
+    gui_widget_t *widgets[RENDER_BENCH_MAX_WIDGETS];
+    uint32_t widget_count;
+    
+    /* Neural grid scene */
+    mesh_3d_t *grid;
+    vec3_t *projected;
+    fb_target_t renderer_target;        /* 3D target to restore */
+    bool renderer_owned;                /* We brought the 3D engine up */
+} render_bench_t;
+
+static render_bench_t bench;
+
+/* Widget Helpers */
+static gui_widget_t *bench_keep(gui_widget_t *widget) {
+    if (widget && bench.widget_count < RENDER_BENCH_MAX_WIDGETS) {
+        bench.widgets[bench.widget_count++] = widget;
+        return widget;
+    }
+    
+    gui_destroy_widget(widget);
+    return NULL;
+}
+
+static void bench_render_widgets(void) {
+    for (uint32_t i = 0; i < bench.widget_count; i++) {
+        gui_widget_t *widget = bench.widgets[i];
+        if (widget->visible && widget->render) {
+            widget->render(widget);
+        }
+    }
+}
+
+static void bench_release_widgets(void) {
+    for (uint32_t i = 0; i < bench.widget_count; i++) {
+        gui_destroy_widget(bench.widgets[i]);
+    }
+    bench.widget_count = 0;
+}
+
+/* SCADA Dashboard - six gauges and three progress bars on a panel */
+static int scada_setup(void) {
+    static const char *units[6] = { "kPa", "C", "RPM", "V", "A", "%" };
+    
+    if (!bench_keep(gui_create_panel("bench_dash", (rect_t){8, 8, RENDER_BENCH_WIDTH - 16, RENDER_BENCH_HEIGHT - 16},
+                                     (color_rgba_t)GUI_COLOR_DARK_BLUE))) {
+        return -1;
+    }
+    
+    for (uint32_t i = 0; i < 6; i++) {
+        rect_t bounds = { 24 + (int32_t)(i % 3) * 200, 24 + (int32_t)(i / 3) * 170, 180, 150 };
+        if (!bench_keep(gui_create_scada_gauge("bench_gauge", bounds, 0.0f, 100.0f, units[i]))) {
+            return -1;
+        }
+    }
+    
+    for (uint32_t i = 0; i < 3; i++) {
+        rect_t bounds = { 24, 372 + (int32_t)i * 30, RENDER_BENCH_WIDTH - 48, 22 };
+        if (!bench_keep(gui_create_progress_bar("bench_bar", bounds, "LOAD"))) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void scada_frame(uint32_t frame, uint32_t time_ms) {
+    (void)time_ms;
+    
+    fb_clear_screen(NEURAL_BLACK);
+    
+    for (uint32_t i = 1; i < bench.widget_count; i++) {
+        gui_widget_t *widget = bench.widgets[i];
+        
+        if (widget->type == WIDGET_SCADA_GAUGE) {
+            float value = (float)((frame * (7 + i * 3)) % 100);
+            gui_update_gauge_value(widget, value);
+            gui_set_gauge_alarm(widget, value > 90.0f);
+        } else if (widget->type == WIDGET_PROGRESS_BAR) {
+            gui_set_progress_value(widget, (float)((frame * (3 + i)) % 101) / 100.0f);
+        }
+        
+        if (widget->update) {
+            widget->update(widget, RENDER_BENCH_FRAME_MS);
+        }
+    }
+    
+    bench_render_widgets();
+}
+
+/* Neural Grid 3D - rotating wireframe grid over the matrix effect */
+static int grid_setup(void) {
+    renderer_3d_t *r = graphics_3d_get_renderer();
+    
+    if (r) {
+        bench.renderer_target.pixels = r->framebuffer;
+        bench.renderer_target.width = r->width;
+        bench.renderer_target.height = r->height;
+        bench.renderer_owned = false;
+        if (graphics_3d_set_target(bench.target.pixels, bench.target.width, bench.target.height) != 0) {
+            return -1;
+        }
+    } else {
+        if (graphics_3d_init(bench.target.width, bench.target.height, bench.target.pixels) != 0) {
+            return -1;
+        }
+        bench.renderer_owned = true;
+    }
+    
+    bench.grid = mesh_create_neural_grid(RENDER_BENCH_GRID_CELLS, RENDER_BENCH_GRID_CELLS);
+    if (!bench.grid) {
+        return -1;
+    }
+    
+    bench.projected = (vec3_t *)kmalloc(bench.grid->vertex_count * sizeof(vec3_t));
+    return bench.projected ? 0 : -1;
+}
+
+static void grid_frame(uint32_t frame, uint32_t time_ms) {
+    renderer_3d_t *r = graphics_3d_get_renderer();
+    const uint32_t stride = RENDER_BENCH_GRID_CELLS + 1;
+    
+    graphics_3d_clear(COLOR_DARK_BLUE);
+    graphics_3d_set_render_mode(RENDER_MODE_NEURAL_MATRIX);
+    neural_matrix_effect(r, (float)time_ms);
+    
+    /* Grid sits below the eye, 30 units out, turning about Y */
+    matrix4_t model = matrix4_multiply(matrix4_translate((vec3_t){0.0f, -4.0f, -30.0f}),
+                                       matrix4_rotate_y((float)frame * 0.02f));
+    matrix4_t mvp = matrix4_multiply(r->projection_matrix, model);
+    
+    float half_w = (float)r->width * 0.5f;
+    float half_h = (float)r->height * 0.5f;
+    for (uint32_t i = 0; i < bench.grid->vertex_count; i++) {
+        vec3_t ndc = matrix4_transform_point(mvp, bench.grid->vertices[i].position);
+        bench.projected[i].x = (ndc.x + 1.0f) * half_w;
+        bench.projected[i].y = (1.0f - ndc.y) * half_h;
+        bench.projected[i].z = ndc.z * 0.5f + 0.5f;
+    }
+    
+    for (uint32_t i = 0; i < bench.grid->vertex_count; i++) {
+        uint32_t color = bench.grid->vertices[i].color;
+        if ((i % stride) + 1 < stride) {
+            rasterize_line(bench.projected[i], bench.projected[i + 1], color, r);
+        }
+        if (i + stride < bench.grid->vertex_count) {
+            rasterize_line(bench.projected[i], bench.projected[i + stride], color, r);
+        }
+    }
+    
+    graphics_3d_set_render_mode(RENDER_MODE_SOLID);
+    graphics_3d_present();
+}
+
+static void grid_teardown(void) {
+    if (bench.projected) {
+        kfree(bench.projected);
+        bench.projected = NULL;
+    }
+    if (bench.grid) {
+        mesh_destroy(bench.grid);
+        bench.grid = NULL;
+    }
+    
+    if (bench.renderer_owned) {
+        graphics_3d_shutdown();
+    } else if (bench.renderer_target.pixels) {
+        graphics_3d_set_target(bench.renderer_target.pixels, bench.renderer_target.width,
+                               bench.renderer_target.height);
+    }
+    bench.renderer_target.pixels = NULL;
+    bench.renderer_owned = false;
+}
+
+/* Particle Storm - four orbiting emitters at full budget */
+static int storm_setup(void) {
+    if (particle_engine_init(PARTICLE_MAX) != 0) {
+        return -1;
+    }
+    
+    particle_engine_clear();
+    particle_engine_seed(RENDER_BENCH_SEED);
+    return 0;
+}
+
+static void storm_frame(uint32_t frame, uint32_t time_ms) {
+    static const uint32_t colors[4] = { NEURAL_CYAN, NEURAL_PURPLE, NEURAL_GREEN, NEURAL_GOLD };
+    
+    fb_clear_screen(NEURAL_BLACK);
+    
+    for (uint32_t e = 0; e < 4; e++) {
+        uint32_t angle = effect_ms_to_angle(time_ms + e * 1571, 1500);
+        float x = RENDER_BENCH_WIDTH / 2 + (float)(effect_cos(angle) * 200) / EFFECT_FIXED_ONE;
+        float y = RENDER_BENCH_HEIGHT / 2 + (float)(effect_sin(angle) * 150) / EFFECT_FIXED_ONE;
+        particle_emit_burst(x, y, 0.0f, 48 + (frame & 15), colors[e]);
+    }
+    
+    particle_engine_update(RENDER_BENCH_FRAME_MS / 1000.0f);
+    particle_engine_render();
+}
+
+static void storm_teardown(void) {
+    particle_engine_clear();
+}
+
+/* Text Panels - four bordered panels of dense telemetry text */
+static int text_setup(void) {
+    static const char *titles[4] = { "PLC BUS A", "PLC BUS B", "NEURAL LINK", "ALARM LOG" };
+    
+    for (uint32_t i = 0; i < 4; i++) {
+        rect_t bounds = { 8 + (int32_t)(i % 2) * 316, 8 + (int32_t)(i / 2) * 236, 308, 228 };
+        gui_widget_t *panel = bench_keep(gui_create_panel("bench_text", bounds, (color_rgba_t)GUI_COLOR_DARK_BLUE));
+        if (!panel) {
+            return -1;
+        }
+        
+        rect_t title = { bounds.x + 8, bounds.y + bounds.height - 14, bounds.width - 16, 12 };
+        if (!bench_keep(gui_create_label("bench_title", title, titles[i]))) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void text_frame(uint32_t frame, uint32_t time_ms) {
+    char line[48];
+    
+    (void)time_ms;
+    fb_clear_screen(NEURAL_BLACK);
+    bench_render_widgets();
+    
+    for (uint32_t p = 0; p < 4; p++) {
+        int32_t x = 16 + (int32_t)(p % 2) * 316;
+        int32_t y = 24 + (int32_t)(p / 2) * 236;
+        
+        for (uint32_t l = 0; l < RENDER_BENCH_TEXT_LINES; l++) {
+            uint32_t value = (frame * 131 + p * 977 + l * 53) % 100000;
+            snprintf(line, sizeof(line), "TAG %02u.%02u  %05u.%u kPa  %s",
+                     p, l, value / 10, value % 10, (value % 7) ? "OK" : "HI");
+            fb_draw_string(x, y + (int32_t)(l * RENDER_BENCH_LINE_HEIGHT), line,
+                           (value % 7) ? NEURAL_CYAN : NEURAL_RED, NEURAL_DARK_BLUE);
+        }
+    }
+}
+
+static const render_bench_scene_ops_t bench_scenes[RENDER_BENCH_SCENE_COUNT] = {
+    { "scada",          scada_setup,    scada_frame,    bench_release_widgets },
+    { "neural_grid",    grid_setup,     grid_frame,     grid_teardown },
+    { "particle_storm", storm_setup,    storm_frame,    storm_teardown },
+    { "text_panels",    text_setup,     text_frame,     bench_release_widgets },
+};
+
+const char *render_bench_scene_name(render_bench_scene_t scene) {
+    if (scene >= RENDER_BENCH_SCENE_COUNT) {
+        return "unknown";
+    }
+    return bench_scenes[scene].name;
+}
+
+/* Frame checksum over XRGB8888 pixels */
+uint32_t render_bench_checksum(const uint32_t *pixels, uint32_t count) {
+    uint32_t hash = RENDER_BENCH_FNV_OFFSET;
+    
+    for (uint32_t i = 0; i < count; i++) {
+        hash ^= pixels[i];
+        hash *= RENDER_BENCH_FNV_PRIME;
+    }
+    return hash;
+}
+
+/* Off-screen target shared by all scenes; creates a headless device if needed */
+static int render_bench_prepare(void) {
+    if (fb_init_headless(RENDER_BENCH_WIDTH, RENDER_BENCH_HEIGHT) != 0) {
+        return -1;
+    }
+    
+    if (!bench.target.pixels) {
+        bench.target.pixels = (uint32_t *)kcalloc(RENDER_BENCH_WIDTH * RENDER_BENCH_HEIGHT, sizeof(uint32_t));
+        if (!bench.target.pixels) {
+            return -1;
+        }
+        bench.target.width = RENDER_BENCH_WIDTH;
+        bench.target.height = RENDER_BENCH_HEIGHT;
+    }
+    
+    if (!effects_is_initialized()) {
+        effects_init();
+    }
+    
+    /* The GUI initcall may have been skipped (headless); the scenes need widgets */
+    return gui_init();
+}
+
+static void render_bench_report(const render_bench_result_t *result) {
+    serial_puts("[NEURAL-BENCH] scene=");
+    serial_puts(result->name);
+    if (result->skipped) {
+        serial_puts(" skipped\n");
+        return;
+    }
+    
+    serial_puts(" frames=");
+    print_dec(result->frames);
+    serial_puts(" avg=");
+    print_dec(result->timing.count ? result->timing.sum_us / result->timing.count : 0);
+    serial_puts(" p50=");
+    print_dec(perf_hist_percentile(&result->timing, 50));
+    serial_puts(" p95=");
+    print_dec(perf_hist_percentile(&result->timing, 95));
+    serial_puts(" p99=");
+    print_dec(perf_hist_percentile(&result->timing, 99));
+    serial_puts(" min=");
+    print_dec(result->min_us);
+    serial_puts(" max=");
+    print_dec(result->max_us);
+    serial_puts(" us checksum=");
+    print_hex(result->checksum);
+    serial_puts(" last=");
+    print_hex(result->last_checksum);
+    serial_puts("\n");
+}
+
+/* Run one scene for a number of frames */
+int render_bench_run(render_bench_scene_t scene, uint32_t frames, bool per_frame,
+                     render_bench_result_t *result) {
+    if (scene >= RENDER_BENCH_SCENE_COUNT || !result) {
+        return -1;
+    }
+    
+    const render_bench_scene_ops_t *ops = &bench_scenes[scene];
+    memset(result, 0, sizeof(render_bench_result_t));
+    result->name = ops->name;
+    result->min_us = 0xFFFFFFFF;
+    result->checksum = RENDER_BENCH_FNV_OFFSET;
+    
+    if (render_bench_prepare() != 0) {
+        return -1;
+    }
+    
+    fb_target_t screen;
+    fb_bind_target(&bench.target, &screen);
+    
+    if (ops->setup() != 0) {
+        ops->teardown();
+        fb_bind_target(&screen, NULL);
+        result->skipped = true;
+        result->min_us = 0;
+        render_bench_report(result);
+        return -1;
+    }
+    
+    const uint32_t pixel_count = bench.target.width * bench.target.height;
+    for (uint32_t f = 0; f < frames; f++) {
+        uint64_t start = rdtsc();
+        ops->frame(f, f * RENDER_BENCH_FRAME_MS);
+        uint32_t us = (uint32_t)tsc_cycles_to_us(rdtsc() - start);
+        
+        /* Checksum outside the timed region */
+        uint32_t sum = render_bench_checksum(bench.target.pixels, pixel_count);
+        result->checksum = (result->checksum ^ sum) * RENDER_BENCH_FNV_PRIME;
+        result->last_checksum = sum;
+        
+        perf_hist_add(&result->timing, us);
+        if (us < result->min_us) result->min_us = us;
+        if (us > result->max_us) result->max_us = us;
+        result->frames++;
+        
+        if (per_frame) {
+            serial_puts("[NEURAL-BENCH] ");
+            serial_puts(ops->name);
+            serial_puts(" frame=");
+            print_dec(f);
+            serial_puts(" us=");
+            print_dec(us);
+            serial_puts(" checksum=");
+            print_hex(sum);
+            serial_puts("\n");
+        }
+    }
+    
+    ops->teardown();
+    fb_bind_target(&screen, NULL);
+    
+    if (result->frames == 0) {
+        result->min_us = 0;
+    }
+    render_bench_report(result);
+    return 0;
+}
+
+/* Run every scene at full detail; the live quality level is restored after */
+int render_bench_run_all(uint32_t frames, bool per_frame) {
+    render_bench_result_t result;
+    quality_stats_t quality;
+    int failures = 0;
+    
+    if (frames == 0) {
+        frames = RENDER_BENCH_DEFAULT_FRAMES;
+    }
+    
+    quality_get_stats(&quality);
+    quality_governor_enable(false);
+    quality_set_level(0);
+    
+    serial_puts("[NEURAL-BENCH] Headless render benchmark, ");
+    print_dec(RENDER_BENCH_WIDTH);
+    serial_puts("x");
+    print_dec(RENDER_BENCH_HEIGHT);
+    serial_puts(", ");
+    print_dec(frames);
+    serial_puts(" frames per scene\n");
+    
+    for (uint32_t s = 0; s < RENDER_BENCH_SCENE_COUNT; s++) {
+        if (render_bench_run((render_bench_scene_t)s, frames, per_frame, &result) != 0) {
+            failures++;
+        }
+    }
+    
+    quality_set_level(quality.level);
+    quality_governor_enable(quality.enabled);
+    
+    serial_puts("[NEURAL-BENCH] Benchmark complete\n");
+    return failures ? -1 : 0;
+}
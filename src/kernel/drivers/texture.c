@@ -0,0 +1,330 @@
+/* texture.c - Brandon Media OS Neural Texture Engine Implementation
+ * Tiled Storage, Box-Filtered Mipmaps and Packed-Channel Bilinear Sampling
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "kernel/texture.h"
+#include "kernel/framebuffer.h"
+#include "kernel/memory.h"
+#include "kernel/smp.h"
+
+/* Packed channel masks: two 8-bit channels per 32-bit word, 16-bit lanes */
+#define TEXEL_RB_MASK   0x00FF00FF
+#define TEXEL_AG_MASK   0xFF00FF00
+
+/* External functions */
+extern void serial_puts(const char *s);
+extern void print_dec(uint64_t num);
+
+/* Bit spread for 3-bit tile coordinates: abc -> a0b0c */
+static const uint8_t morton_spread[TEXTURE_TILE_SIZE] = {0, 1, 4, 5, 16, 17, 20, 21};
+
+/* Tile caches, one per rasterizer thread (CPU) */
+static texture_cache_t texture_caches[TEXTURE_CACHE_THREADS];
+static uint32_t next_texture_id = 1;
+
+static bool is_power_of_two(uint32_t v) {
+    return v && !(v & (v - 1));
+}
+
+/* Offset of texel (x, y) within a level's tiled storage */
+static inline uint32_t texel_offset(const texture_t *texture, uint32_t level, uint32_t x, uint32_t y) {
+    uint32_t tile = (y >> TEXTURE_TILE_SHIFT) * texture->level_tiles_x[level] + (x >> TEXTURE_TILE_SHIFT);
+    return (tile << (2 * TEXTURE_TILE_SHIFT)) |
+           morton_spread[x & (TEXTURE_TILE_SIZE - 1)] |
+           (morton_spread[y & (TEXTURE_TILE_SIZE - 1)] << 1);
+}
+
+/* Blend two texels by f/256 - rb and ag lanes in parallel */
+static inline uint32_t texel_lerp(uint32_t a, uint32_t b, uint32_t f) {
+    uint32_t inv = 256 - f;
+    uint32_t rb = (((a & TEXEL_RB_MASK) * inv + (b & TEXEL_RB_MASK) * f) >> 8) & TEXEL_RB_MASK;
+    uint32_t ag = (((a >> 8) & TEXEL_RB_MASK) * inv + ((b >> 8) & TEXEL_RB_MASK) * f) & TEXEL_AG_MASK;
+    return rb | ag;
+}
+
+/* Average four texels (box filter) */
+static inline uint32_t texel_average4(uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
+    uint32_t rb = (a & TEXEL_RB_MASK) + (b & TEXEL_RB_MASK) + (c & TEXEL_RB_MASK) + (d & TEXEL_RB_MASK);
+    uint32_t ag = ((a >> 8) & TEXEL_RB_MASK) + ((b >> 8) & TEXEL_RB_MASK) +
+                  ((c >> 8) & TEXEL_RB_MASK) + ((d >> 8) & TEXEL_RB_MASK);
+    rb = ((rb + 0x00020002) >> 2) & TEXEL_RB_MASK;
+    ag = (((ag + 0x00020002) >> 2) & TEXEL_RB_MASK) << 8;
+    return rb | ag;
+}
+
+/* Drop every cached tile of a texture on all threads */
+static void texture_cache_evict(const texture_t *texture) {
+    for (uint32_t t = 0; t < TEXTURE_CACHE_THREADS; t++) {
+        for (uint32_t i = 0; i < TEXTURE_CACHE_ENTRIES; i++) {
+            if (texture_caches[t].entries[i].texture == texture) {
+                texture_caches[t].entries[i].texture = NULL;
+            }
+        }
+    }
+}
+
+/* Create Texture (dimensions must be powers of two) */
+texture_t *texture_create(uint32_t width, uint32_t height) {
+    if (!is_power_of_two(width) || !is_power_of_two(height) ||
+        width > TEXTURE_MAX_SIZE || height > TEXTURE_MAX_SIZE) {
+        serial_puts("[NEURAL-TEX] Texture dimensions must be powers of two\n");
+        return NULL;
+    }
+    
+    texture_t *texture = (texture_t *)kmalloc(sizeof(texture_t));
+    if (!texture) {
+        return NULL;
+    }
+    memset(texture, 0, sizeof(texture_t));
+    
+    /* Lay out the full mip chain, each level padded to whole tiles */
+    uint32_t offsets[TEXTURE_MAX_LEVELS];
+    uint32_t total = 0;
+    uint32_t w = width;
+    uint32_t h = height;
+    uint32_t levels = 0;
+    
+    while (levels < TEXTURE_MAX_LEVELS) {
+        uint32_t tiles_x = (w + TEXTURE_TILE_SIZE - 1) >> TEXTURE_TILE_SHIFT;
+        uint32_t tiles_y = (h + TEXTURE_TILE_SIZE - 1) >> TEXTURE_TILE_SHIFT;
+        
+        texture->level_width[levels] = w;
+        texture->level_height[levels] = h;
+        texture->level_tiles_x[levels] = tiles_x;
+        offsets[levels] = total;
+        total += tiles_x * tiles_y * TEXTURE_TILE_TEXELS;
+        levels++;
+        
+        if (w == 1 && h == 1) {
+            break;
+        }
+        w = w > 1 ? w >> 1 : 1;
+        h = h > 1 ? h >> 1 : 1;
+    }
+    
+    texture->storage = (uint32_t *)kmalloc(total * sizeof(uint32_t));
+    if (!texture->storage) {
+        kfree(texture);
+        return NULL;
+    }
+    memset(texture->storage, 0, total * sizeof(uint32_t));
+    
+    for (uint32_t l = 0; l < levels; l++) {
+        texture->level_data[l] = texture->storage + offsets[l];
+    }
+    
+    texture->id = next_texture_id++;
+    texture->width = width;
+    texture->height = height;
+    texture->levels = levels;
+    return texture;
+}
+
+void texture_destroy(texture_t *texture) {
+    if (!texture) {
+        return;
+    }
+    
+    texture_cache_evict(texture);
+    
+    kfree(texture->storage);
+    kfree(texture);
+}
+
+/* Upload linear pixels into level 0 and rebuild the mip chain */
+int texture_upload(texture_t *texture, const uint32_t *pixels, uint32_t pitch_pixels) {
+    if (!texture || !pixels || pitch_pixels < texture->width) {
+        return -1;
+    }
+    
+    uint32_t *dst = texture->level_data[0];
+    for (uint32_t y = 0; y < texture->height; y++) {
+        const uint32_t *row = pixels + y * pitch_pixels;
+        for (uint32_t x = 0; x < texture->width; x++) {
+            dst[texel_offset(texture, 0, x, y)] = row[x];
+        }
+    }
+    
+    texture_generate_mipmaps(texture);
+    return 0;
+}
+
+/* Box-filter each level from the one above */
+void texture_generate_mipmaps(texture_t *texture) {
+    if (!texture) {
+        return;
+    }
+    
+    for (uint32_t l = 1; l < texture->levels; l++) {
+        const uint32_t *src = texture->level_data[l - 1];
+        uint32_t *dst = texture->level_data[l];
+        uint32_t src_w = texture->level_width[l - 1];
+        uint32_t src_h = texture->level_height[l - 1];
+        
+        for (uint32_t y = 0; y < texture->level_height[l]; y++) {
+            uint32_t y0 = (y << 1) & (src_h - 1);
+            uint32_t y1 = ((y << 1) + 1) & (src_h - 1);
+            
+            for (uint32_t x = 0; x < texture->level_width[l]; x++) {
+                uint32_t x0 = (x << 1) & (src_w - 1);
+                uint32_t x1 = ((x << 1) + 1) & (src_w - 1);
+                
+                dst[texel_offset(texture, l, x, y)] = texel_average4(
+                    src[texel_offset(texture, l - 1, x0, y0)],
+                    src[texel_offset(texture, l - 1, x1, y0)],
+                    src[texel_offset(texture, l - 1, x0, y1)],
+                    src[texel_offset(texture, l - 1, x1, y1)]);
+            }
+        }
+    }
+    
+    /* Cached tiles are stale now */
+    texture_cache_evict(texture);
+}
+
+/* Tile cache of the calling CPU - look it up once per span, not per texel */
+texture_cache_t *texture_cache_get(void) {
+    struct neural_cpu *cpu = smp_get_current_cpu();
+    uint32_t index = cpu ? cpu->cpu_id : 0;
+    
+    return &texture_caches[index % TEXTURE_CACHE_THREADS];
+}
+
+/* Fetch one texel through the tile cache (wrap addressing) */
+uint32_t texture_fetch(texture_cache_t *cache, const texture_t *texture, uint32_t level, int32_t x, int32_t y) {
+    uint32_t ux = (uint32_t)x & (texture->level_width[level] - 1);
+    uint32_t uy = (uint32_t)y & (texture->level_height[level] - 1);
+    uint32_t tile = (uy >> TEXTURE_TILE_SHIFT) * texture->level_tiles_x[level] + (ux >> TEXTURE_TILE_SHIFT);
+    uint32_t inner = morton_spread[ux & (TEXTURE_TILE_SIZE - 1)] |
+                     (morton_spread[uy & (TEXTURE_TILE_SIZE - 1)] << 1);
+    
+    if (!cache) {
+        return texture->level_data[level][(tile << (2 * TEXTURE_TILE_SHIFT)) | inner];
+    }
+    
+    uint32_t slot = (tile * 7 + level * 31 + texture->id * 13) & (TEXTURE_CACHE_ENTRIES - 1);
+    texture_cache_entry_t *entry = &cache->entries[slot];
+    
+    if (entry->texture != texture || entry->level != level || entry->tile != tile) {
+        memcpy(entry->texels, texture->level_data[level] + (tile << (2 * TEXTURE_TILE_SHIFT)),
+               sizeof(entry->texels));
+        entry->texture = texture;
+        entry->level = level;
+        entry->tile = tile;
+        cache->misses++;
+    } else {
+        cache->hits++;
+    }
+    
+    return entry->texels[inner];
+}
+
+/* Sample at level-0 texel coordinates (16.16) on the given mip level */
+uint32_t texture_sample(texture_cache_t *cache, const texture_t *texture, uint32_t level,
+                        int32_t s, int32_t t, texture_filter_t filter) {
+    if (level >= texture->levels) {
+        level = texture->levels - 1;
+    }
+    
+    s >>= level;
+    t >>= level;
+    
+    if (filter == TEXTURE_FILTER_NEAREST) {
+        return texture_fetch(cache, texture, level, s >> TEXTURE_FIXED_SHIFT, t >> TEXTURE_FIXED_SHIFT);
+    }
+    
+    /* Bilinear: sample centers sit at half-texel offsets */
+    s -= TEXTURE_FIXED_ONE / 2;
+    t -= TEXTURE_FIXED_ONE / 2;
+    
+    int32_t x0 = s >> TEXTURE_FIXED_SHIFT;
+    int32_t y0 = t >> TEXTURE_FIXED_SHIFT;
+    uint32_t fx = (s >> (TEXTURE_FIXED_SHIFT - 8)) & 0xFF;
+    uint32_t fy = (t >> (TEXTURE_FIXED_SHIFT - 8)) & 0xFF;
+    
+    uint32_t top = texel_lerp(texture_fetch(cache, texture, level, x0, y0),
+                              texture_fetch(cache, texture, level, x0 + 1, y0), fx);
+    uint32_t bottom = texel_lerp(texture_fetch(cache, texture, level, x0, y0 + 1),
+                                 texture_fetch(cache, texture, level, x0 + 1, y0 + 1), fx);
+    return texel_lerp(top, bottom, fy);
+}
+
+/* Sample a run of pixels stepping (ds, dt) per pixel */
+void texture_sample_span(texture_cache_t *cache, const texture_t *texture, uint32_t level,
+                         int32_t s, int32_t t, int32_t ds, int32_t dt,
+                         uint32_t count, texture_filter_t filter, uint32_t *out) {
+    if (!texture || !out) {
+        return;
+    }
+    
+    for (uint32_t i = 0; i < count; i++) {
+        out[i] = texture_sample(cache, texture, level, s, t, filter);
+        s += ds;
+        t += dt;
+    }
+}
+
+/* Pick the mip level whose texel footprint matches one screen pixel */
+uint32_t texture_select_level(const texture_t *texture, int32_t ds, int32_t dt) {
+    uint32_t step_s = (uint32_t)(ds < 0 ? -ds : ds);
+    uint32_t step_t = (uint32_t)(dt < 0 ? -dt : dt);
+    uint32_t footprint = (step_s > step_t ? step_s : step_t) >> TEXTURE_FIXED_SHIFT;
+    uint32_t level = 0;
+    
+    while (footprint > 1 && level + 1 < texture->levels) {
+        footprint >>= 1;
+        level++;
+    }
+    return level;
+}
+
+/* Draw a texture stretched over a screen rectangle (textured GUI panels) */
+void texture_draw_panel(const texture_t *texture, int32_t x, int32_t y,
+                        uint32_t width, uint32_t height, texture_filter_t filter) {
+    framebuffer_device_t *fb = framebuffer_get_device();
+    if (!texture || !fb || !fb->framebuffer || width == 0 || height == 0) {
+        return;
+    }
+    
+    int32_t ds = (int32_t)(((uint64_t)texture->width << TEXTURE_FIXED_SHIFT) / width);
+    int32_t dt = (int32_t)(((uint64_t)texture->height << TEXTURE_FIXED_SHIFT) / height);
+    uint32_t level = texture_select_level(texture, ds, dt);
+    texture_cache_t *cache = texture_cache_get();
+    
+    /* Clip against the screen, advancing texture coordinates to match */
+    int32_t x0 = x < 0 ? 0 : x;
+    int32_t y0 = y < 0 ? 0 : y;
+    int32_t x1 = x + (int32_t)width;
+    int32_t y1 = y + (int32_t)height;
+    if (x1 > (int32_t)fb->width) x1 = fb->width;
+    if (y1 > (int32_t)fb->height) y1 = fb->height;
+    if (x0 >= x1 || y0 >= y1) {
+        return;
+    }
+    
+    /* Sample at pixel centers */
+    int32_t s_start = (x0 - x) * ds + ds / 2;
+    int32_t t = (y0 - y) * dt + dt / 2;
+    
+    for (int32_t row = y0; row < y1; row++, t += dt) {
+        uint32_t *dst = fb->framebuffer + row * fb->width + x0;
+        texture_sample_span(cache, texture, level, s_start, t, ds, 0, x1 - x0, filter, dst);
+    }
+}
+
+void texture_get_cache_stats(uint64_t *hits, uint64_t *misses) {
+    uint64_t total_hits = 0;
+    uint64_t total_misses = 0;
+    
+    for (uint32_t t = 0; t < TEXTURE_CACHE_THREADS; t++) {
+        total_hits += texture_caches[t].hits;
+        total_misses += texture_caches[t].misses;
+    }
+    
+    if (hits) *hits = total_hits;
+    if (misses) *misses = total_misses;
+}
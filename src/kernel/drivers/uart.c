@@ -0,0 +1,430 @@
+/* uart.c - Brandon Media OS 16550 UART Console
+ * Interrupt-Driven Serial Output with Transmit and Receive Rings
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "kernel/uart.h"
+#include "kernel/interrupts.h"
+
+/* 16550 Registers (offsets from the base port) */
+#define UART_RBR            0       /* Receive buffer (read) */
+#define UART_THR            0       /* Transmit holding (write) */
+#define UART_DLL            0       /* Divisor low (DLAB=1) */
+#define UART_IER            1       /* Interrupt enable */
+#define UART_DLM            1       /* Divisor high (DLAB=1) */
+#define UART_IIR            2       /* Interrupt identification (read) */
+#define UART_FCR            2       /* FIFO control (write) */
+#define UART_LCR            3       /* Line control */
+#define UART_MCR            4       /* Modem control */
+#define UART_LSR            5       /* Line status */
+#define UART_MSR            6       /* Modem status */
+
+#define UART_IER_RDA        0x01    /* Received data available */
+#define UART_IER_THRE       0x02    /* Transmit holding register empty */
+#define UART_IER_RLS        0x04    /* Receiver line status */
+
+#define UART_IIR_NONE       0x01    /* No interrupt pending */
+#define UART_IIR_ID(iir)    (((iir) >> 1) & 0x07)
+#define UART_IIR_MSR        0x00
+#define UART_IIR_THRE       0x01
+#define UART_IIR_RDA        0x02
+#define UART_IIR_RLS        0x03
+#define UART_IIR_TIMEOUT    0x06    /* Characters waiting below the trigger level */
+#define UART_IIR_FIFO       0xC0    /* Both bits set: working 16550A FIFO */
+#define UART_IIR_FIFO64     0x20    /* 16750 64-byte FIFO */
+
+#define UART_FCR_ENABLE     0xE7    /* Enable, clear both, 64-byte mode, 14-byte trigger */
+
+#define UART_LCR_8N1        0x03
+#define UART_LCR_DLAB       0x80
+
+#define UART_MCR_DTR        0x01
+#define UART_MCR_RTS        0x02
+#define UART_MCR_OUT2       0x08    /* Gates the IRQ line to the PIC */
+#define UART_MCR_LOOPBACK   0x10
+
+#define UART_LSR_DR         0x01    /* Data ready */
+#define UART_LSR_ERRORS     0x1E    /* Overrun, parity, framing, break */
+#define UART_LSR_THRE       0x20    /* Transmit holding register empty */
+#define UART_LSR_TEMT       0x40    /* Transmitter completely idle */
+
+/* Bounded polls so a missing or wedged UART cannot hang the kernel */
+#define UART_POLL_LIMIT     100000
+#define UART_IRQ_LOOP_LIMIT 16
+
+/* I/O port functions */
+static inline void outb(uint16_t port, uint8_t val) {
+    asm volatile ("outb %0, %1" : : "a"(val), "Nd"(port));
+}
+
+static inline uint8_t inb(uint16_t port) {
+    uint8_t ret;
+    asm volatile ("inb %1, %0" : "=a"(ret) : "Nd"(port));
+    return ret;
+}
+
+/* External functions */
+extern void print_dec(uint64_t num);
+
+/* UART State */
+typedef struct {
+    uint32_t baud;
+    uint32_t fifo_size;             /* Bytes the THR accepts per empty interrupt */
+    uint8_t ier;
+    bool tx_active;                 /* THRE interrupt armed */
+    
+    char tx_buffer[UART_TX_BUFFER_SIZE];
+    uint32_t tx_head;               /* Free-running; masked on access */
+    uint32_t tx_tail;
+    
+    char rx_buffer[UART_RX_BUFFER_SIZE];
+    uint32_t rx_head;
+    uint32_t rx_tail;
+    
+    uart_stats_t stats;
+} uart_state_t;
+
+static uart_state_t uart;
+static bool uart_initialized = false;
+static bool uart_buffered = false;      /* Off until uart_init(), and again after uart_panic() */
+
+/* The rings are shared with the IRQ handler: keep it out while we touch them */
+static inline uint64_t uart_lock(void) {
+    uint64_t flags;
+    asm volatile ("pushfq; popq %0; cli" : "=r"(flags) : : "memory");
+    return flags;
+}
+
+static inline void uart_unlock(uint64_t flags) {
+    if (flags & 0x200) {
+        asm volatile ("sti" : : : "memory");
+    }
+}
+
+static bool uart_wait_lsr(uint8_t bits) {
+    for (uint32_t i = 0; i < UART_POLL_LIMIT; i++) {
+        if (inb(UART_COM1_BASE + UART_LSR) & bits) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void uart_putc_sync(char c) {
+    uart_wait_lsr(UART_LSR_THRE);
+    outb(UART_COM1_BASE + UART_THR, (uint8_t)c);
+}
+
+/* Load the transmit FIFO from the ring if the THR is empty; lock held */
+static void uart_fill_fifo(void) {
+    if (!(inb(UART_COM1_BASE + UART_LSR) & UART_LSR_THRE)) {
+        return;
+    }
+    
+    for (uint32_t i = 0; i < uart.fifo_size && uart.tx_tail != uart.tx_head; i++) {
+        outb(UART_COM1_BASE + UART_THR, (uint8_t)uart.tx_buffer[uart.tx_tail & (UART_TX_BUFFER_SIZE - 1)]);
+        uart.tx_tail++;
+        uart.stats.tx_bytes++;
+    }
+}
+
+/* Push the ring out by polling; lock held */
+static void uart_drain_sync(void) {
+    while (uart.tx_tail != uart.tx_head) {
+        if (!uart_wait_lsr(UART_LSR_THRE)) {
+            uart.tx_tail = uart.tx_head;    /* Transmitter wedged: give up */
+            break;
+        }
+        uart_fill_fifo();
+    }
+}
+
+/* Start transmission if the THRE interrupt is idle; lock held */
+static void uart_kick(void) {
+    if (uart.tx_active) {
+        return;
+    }
+    
+    uart_fill_fifo();
+    if (uart.tx_tail != uart.tx_head) {
+        uart.tx_active = true;
+        uart.ier |= UART_IER_THRE;
+        outb(UART_COM1_BASE + UART_IER, uart.ier);
+    }
+}
+
+/* Queue bytes for transmission; returns once they are in the ring */
+size_t uart_write(const char *data, size_t length) {
+    if (!uart_buffered) {
+        for (size_t i = 0; i < length; i++) {
+            uart_putc_sync(data[i]);
+        }
+        return length;
+    }
+    
+    uint64_t flags = uart_lock();
+    bool stalled = false;
+    
+    for (size_t i = 0; i < length; i++) {
+        /* Ring full (interrupts off for too long, or a huge burst) */
+        if (uart.tx_head - uart.tx_tail >= UART_TX_BUFFER_SIZE) {
+            if (!stalled) {
+                uart.stats.tx_stalls++;
+                stalled = true;
+            }
+            uart_wait_lsr(UART_LSR_THRE);
+            uart_fill_fifo();
+            if (uart.tx_head - uart.tx_tail >= UART_TX_BUFFER_SIZE) {
+                uart.tx_tail++;             /* Wedged: drop the oldest byte */
+            }
+        }
+        
+        uart.tx_buffer[uart.tx_head & (UART_TX_BUFFER_SIZE - 1)] = data[i];
+        uart.tx_head++;
+    }
+    
+    uint32_t queued = uart.tx_head - uart.tx_tail;
+    if (queued > uart.stats.tx_high_water) {
+        uart.stats.tx_high_water = queued;
+    }
+    
+    uart_kick();
+    uart_unlock(flags);
+    return length;
+}
+
+/* Take up to `length` received bytes without blocking */
+size_t uart_read(char *buffer, size_t length) {
+    size_t count = 0;
+    
+    if (!uart_buffered) {
+        while (count < length && (inb(UART_COM1_BASE + UART_LSR) & UART_LSR_DR)) {
+            buffer[count++] = (char)inb(UART_COM1_BASE + UART_RBR);
+        }
+        return count;
+    }
+    
+    uint64_t flags = uart_lock();
+    while (count < length && uart.rx_tail != uart.rx_head) {
+        buffer[count++] = uart.rx_buffer[uart.rx_tail & (UART_RX_BUFFER_SIZE - 1)];
+        uart.rx_tail++;
+    }
+    uart_unlock(flags);
+    return count;
+}
+
+/* Block until everything queued has left the transmitter */
+void uart_flush(void) {
+    uint64_t flags = uart_lock();
+    uart_drain_sync();
+    uart_wait_lsr(UART_LSR_TEMT);
+    uart_unlock(flags);
+}
+
+/* Panic path: stop using interrupts, push out what is queued, then poll */
+void uart_panic(void) {
+    uint64_t flags = uart_lock();
+    
+    uart_buffered = false;
+    uart.ier = 0;
+    outb(UART_COM1_BASE + UART_IER, 0);
+    uart.tx_active = false;
+    uart_drain_sync();
+    
+    uart_unlock(flags);
+}
+
+static void uart_receive(void) {
+    for (uint32_t i = 0; i < UART_RX_BUFFER_SIZE && (inb(UART_COM1_BASE + UART_LSR) & UART_LSR_DR); i++) {
+        char c = (char)inb(UART_COM1_BASE + UART_RBR);
+        
+        if (uart.rx_head - uart.rx_tail >= UART_RX_BUFFER_SIZE) {
+            uart.stats.rx_dropped++;
+            continue;
+        }
+        uart.rx_buffer[uart.rx_head & (UART_RX_BUFFER_SIZE - 1)] = c;
+        uart.rx_head++;
+        uart.stats.rx_bytes++;
+    }
+}
+
+/* COM1 interrupt: refill the transmit FIFO, empty the receive FIFO */
+static int uart_irq_handler(uint8_t irq, void *data) {
+    (void)irq;
+    (void)data;
+    
+    int result = IRQ_NONE;
+    
+    for (int i = 0; i < UART_IRQ_LOOP_LIMIT; i++) {
+        uint8_t iir = inb(UART_COM1_BASE + UART_IIR);
+        if (iir & UART_IIR_NONE) {
+            break;
+        }
+        result = IRQ_HANDLED;
+        
+        switch (UART_IIR_ID(iir)) {
+            case UART_IIR_RLS:
+                if (inb(UART_COM1_BASE + UART_LSR) & UART_LSR_ERRORS) {
+                    uart.stats.line_errors++;
+                }
+                break;
+            case UART_IIR_RDA:
+            case UART_IIR_TIMEOUT:
+                uart_receive();
+                break;
+            case UART_IIR_THRE:
+                uart_fill_fifo();
+                if (uart.tx_tail == uart.tx_head) {
+                    uart.tx_active = false;
+                    uart.ier &= ~UART_IER_THRE;
+                    outb(UART_COM1_BASE + UART_IER, uart.ier);
+                }
+                break;
+            default:
+                inb(UART_COM1_BASE + UART_MSR);
+                break;
+        }
+    }
+    
+    if (result == IRQ_HANDLED) {
+        uart.stats.interrupts++;
+    }
+    return result;
+}
+
+/* Program the divisor latch for `baud` (8N1); queued output goes out first */
+int uart_set_baud(uint32_t baud) {
+    if (baud == 0 || baud > UART_CLOCK_HZ || UART_CLOCK_HZ / baud > 0xFFFF) {
+        return -1;
+    }
+    uint16_t divisor = (uint16_t)(UART_CLOCK_HZ / baud);
+    
+    uart_flush();
+    
+    uint64_t flags = uart_lock();
+    outb(UART_COM1_BASE + UART_LCR, UART_LCR_DLAB);
+    outb(UART_COM1_BASE + UART_DLL, (uint8_t)(divisor & 0xFF));
+    outb(UART_COM1_BASE + UART_DLM, (uint8_t)(divisor >> 8));
+    outb(UART_COM1_BASE + UART_LCR, UART_LCR_8N1);
+    uart.baud = UART_CLOCK_HZ / divisor;
+    uart_unlock(flags);
+    return 0;
+}
+
+/* Loopback echo: a missing UART reads back 0xFF */
+static bool uart_loopback_test(void) {
+    outb(UART_COM1_BASE + UART_MCR, UART_MCR_LOOPBACK | UART_MCR_RTS | UART_MCR_DTR);
+    outb(UART_COM1_BASE + UART_THR, 0xAE);
+    
+    bool ok = uart_wait_lsr(UART_LSR_DR) && inb(UART_COM1_BASE + UART_RBR) == 0xAE;
+    
+    outb(UART_COM1_BASE + UART_MCR, UART_MCR_DTR | UART_MCR_RTS | UART_MCR_OUT2);
+    return ok;
+}
+
+/* Take over COM1: detect the FIFO, set the baud rate and switch the console
+ * to interrupt-driven output. Needs the interrupt controller set up.
+ */
+int uart_init(uint32_t baud) {
+    if (uart_initialized) {
+        return uart_set_baud(baud);
+    }
+    
+    /* Let polled boot output finish before reprogramming */
+    uart_wait_lsr(UART_LSR_TEMT);
+    outb(UART_COM1_BASE + UART_IER, 0);
+    
+    if (uart_set_baud(baud) != 0) {
+        serial_puts("[NEURAL-UART] Unsupported baud rate, console stays polled\n");
+        return -1;
+    }
+    
+    outb(UART_COM1_BASE + UART_FCR, UART_FCR_ENABLE);
+    uint8_t iir = inb(UART_COM1_BASE + UART_IIR);
+    if ((iir & UART_IIR_FIFO) == UART_IIR_FIFO) {
+        uart.fifo_size = (iir & UART_IIR_FIFO64) ? 64 : 16;
+    } else {
+        uart.fifo_size = 1;             /* 8250/16450, or a 16550 with a broken FIFO */
+        outb(UART_COM1_BASE + UART_FCR, 0);
+    }
+    
+    if (!uart_loopback_test()) {
+        serial_puts("[NEURAL-UART] No UART at COM1, console stays polled\n");
+        return -1;
+    }
+    
+    if (irq_register_handler(UART_COM1_IRQ, uart_irq_handler, NULL, "uart") != 0) {
+        return -1;
+    }
+    
+    uart.tx_head = uart.tx_tail = 0;
+    uart.rx_head = uart.rx_tail = 0;
+    uart.ier = UART_IER_RDA | UART_IER_RLS;
+    outb(UART_COM1_BASE + UART_IER, uart.ier);
+    irq_enable(UART_COM1_IRQ);
+    
+    uart_initialized = true;
+    uart_buffered = true;
+    
+    serial_puts("[NEURAL-UART] COM1 ");
+    serial_puts(uart.fifo_size > 1 ? "16550A, " : "8250, ");
+    print_dec(uart.fifo_size);
+    serial_puts("-byte FIFO, ");
+    print_dec(uart.baud);
+    serial_puts(" baud, interrupt-driven\n");
+    return 0;
+}
+
+bool uart_is_buffered(void) {
+    return uart_buffered;
+}
+
+uint32_t uart_fifo_size(void) {
+    return uart.fifo_size;
+}
+
+void uart_get_stats(uart_stats_t *stats) {
+    if (!stats) {
+        return;
+    }
+    
+    uint64_t flags = uart_lock();
+    *stats = uart.stats;
+    uart_unlock(flags);
+}
+
+void uart_print_stats(void) {
+    uart_stats_t stats;
+    uart_get_stats(&stats);
+    
+    serial_puts("[NEURAL-UART] tx ");
+    print_dec(stats.tx_bytes);
+    serial_puts(" bytes, rx ");
+    print_dec(stats.rx_bytes);
+    serial_puts(" bytes, ");
+    print_dec(stats.interrupts);
+    serial_puts(" interrupts, peak queue ");
+    print_dec(stats.tx_high_water);
+    serial_puts(", ");
+    print_dec(stats.tx_stalls);
+    serial_puts(" stalls, ");
+    print_dec(stats.rx_dropped);
+    serial_puts(" rx dropped, ");
+    print_dec(stats.line_errors);
+    serial_puts(" line errors\n");
+}
+
+/* Console output used by every subsystem */
+void serial_putc(char c) {
+    uart_write(&c, 1);
+}
+
+void serial_puts(const char *s) {
+    size_t length = 0;
+    while (s[length]) {
+        length++;
+    }
+    uart_write(s, length);
+}
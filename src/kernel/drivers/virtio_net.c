@@ -8,6 +8,8 @@
 #include "kernel/pci.h"
 #include "kernel/hal.h"
 #include "kernel/interrupts.h"
+#include "kernel/msi.h"
+#include "kernel/dma.h"
 
 /* VirtIO Device IDs */
 #define VIRTIO_VENDOR_ID    0x1AF4
@@ -25,6 +27,12 @@
 #define VIRTIO_PCI_ISR               0x13
 #define VIRTIO_PCI_CONFIG_OFF        0x14
 
+/* Legacy header grows by two vector registers while MSI-X is enabled */
+#define VIRTIO_MSI_CONFIG_VECTOR     0x14
+#define VIRTIO_MSI_QUEUE_VECTOR      0x16
+#define VIRTIO_PCI_CONFIG_OFF_MSIX   0x18
+#define VIRTIO_MSI_NO_VECTOR         0xFFFF
+
 /* VirtIO Network Device Features */
 #define VIRTIO_NET_F_CSUM           0x00000001
 #define VIRTIO_NET_F_GUEST_CSUM     0x00000002
@@ -54,6 +62,10 @@
 #define VIRTIO_NET_TX_QUEUE    1
 #define VIRTIO_NET_CTRL_QUEUE  2
 
+/* MSI-X table entries: configuration changes, then one per queue */
+#define VIRTIO_NET_MSIX_CONFIG 0
+#define VIRTIO_NET_MSIX_QUEUE(idx) ((idx) + 1)
+
 /* Ring sizes */
 #define VIRTIO_NET_QUEUE_SIZE  256
 
@@ -97,6 +109,11 @@ struct virtio_queue {
     uint16_t free_head;
     uint16_t num_free;
     void *queue_mem;
+    dma_addr_t queue_dma;  /* Bus address of queue_mem */
+    size_t queue_bytes;
+    uint8_t vector;       /* MSI-X vector, 0 if none */
+    uint8_t cpu_id;       /* CPU the vector is delivered to */
+    uint32_t interrupts;
 } __attribute__((packed));
 
 /* VirtIO Network Header */
@@ -123,10 +140,16 @@ struct virtio_net_device {
     uint32_t tx_packets;
     uint32_t rx_bytes;
     uint32_t tx_bytes;
+    pci_msix_t msix;
+    int msix_enabled;
+    uint16_t config_off;  /* Device config moves past the MSI-X registers */
+    uint32_t config_interrupts;
 };
 
 static struct virtio_net_device *virtio_net_dev = NULL;
 
+static void virtio_net_cleanup_device(struct hal_device *hal_dev);
+
 /* External functions */
 extern void serial_puts(const char *s);
 extern void print_hex(uint64_t num);
@@ -188,6 +211,66 @@ static void virtio_write8(struct virtio_net_device *dev, uint16_t offset, uint8_
     outb(dev->io_base + offset, value);
 }
 
+/* Queue interrupt - each queue has its own vector, so no ISR read or sharing */
+static void virtio_net_queue_irq(uint8_t vector, void *data) {
+    struct virtio_queue *queue = (struct virtio_queue *)data;
+    (void)vector;
+    
+    queue->interrupts++;
+    
+    /* Consume completions; no buffers are posted yet, so nothing to return */
+    while (queue->last_used_idx != queue->used->idx) {
+        queue->last_used_idx++;
+    }
+}
+
+static void virtio_net_config_irq(uint8_t vector, void *data) {
+    struct virtio_net_device *dev = (struct virtio_net_device *)data;
+    (void)vector;
+    
+    dev->config_interrupts++;
+}
+
+/* Route a queue to its own MSI-X vector on its own CPU */
+static void virtio_net_bind_queue_vector(struct virtio_net_device *dev, struct virtio_queue *queue, uint16_t queue_idx) {
+    uint16_t entry = VIRTIO_NET_MSIX_QUEUE(queue_idx);
+    uint8_t cpu_id = pci_msi_queue_cpu(queue_idx);
+    
+    int vector = pci_msix_assign(&dev->msix, entry, virtio_net_queue_irq, queue, cpu_id);
+    if (vector < 0) {
+        return;
+    }
+    
+    /* Device answers NO_VECTOR when it can't take the mapping */
+    virtio_write16(dev, VIRTIO_MSI_QUEUE_VECTOR, entry);
+    if (virtio_read16(dev, VIRTIO_MSI_QUEUE_VECTOR) == VIRTIO_MSI_NO_VECTOR) {
+        serial_puts("[NEURAL-NET] Queue vector rejected by device\n");
+        pci_msix_mask(&dev->msix, entry, true);
+        return;
+    }
+    
+    queue->vector = (uint8_t)vector;
+    queue->cpu_id = cpu_id;
+}
+
+/* Enable MSI-X with a configuration-change vector */
+static void virtio_net_setup_msix(struct virtio_net_device *dev) {
+    dev->msix_enabled = 0;
+    dev->config_off = VIRTIO_PCI_CONFIG_OFF;
+    
+    if (pci_msix_init(&dev->msix, dev->pci_dev) != 0) {
+        serial_puts("[NEURAL-NET] MSI-X unavailable, queues left unsignalled\n");
+        return;
+    }
+    
+    dev->msix_enabled = 1;
+    dev->config_off = VIRTIO_PCI_CONFIG_OFF_MSIX;
+    
+    if (pci_msix_assign(&dev->msix, VIRTIO_NET_MSIX_CONFIG, virtio_net_config_irq, dev, 0) >= 0) {
+        virtio_write16(dev, VIRTIO_MSI_CONFIG_VECTOR, VIRTIO_NET_MSIX_CONFIG);
+    }
+}
+
 /* Initialize VirtIO queue */
 static int virtio_init_queue(struct virtio_net_device *dev, struct virtio_queue *queue, uint16_t queue_idx) {
     /* Select queue */
@@ -202,27 +285,26 @@ static int virtio_init_queue(struct virtio_net_device *dev, struct virtio_queue
     
     queue->queue_size = queue_size;
     
-    /* Allocate queue memory */
-    size_t queue_mem_size = sizeof(struct virtio_desc) * queue_size +
-                           sizeof(struct virtio_avail) + sizeof(uint16_t) * queue_size +
-                           sizeof(struct virtio_used) + sizeof(struct virtio_used_elem) * queue_size;
+    /* Legacy layout: descriptors and avail ring, then the used ring on the next page */
+    size_t avail_offset = sizeof(struct virtio_desc) * queue_size;
+    size_t used_offset = PAGE_ALIGN_UP(avail_offset + sizeof(uint16_t) * (3 + queue_size));
+    size_t queue_mem_size = used_offset +
+                            PAGE_ALIGN_UP(sizeof(uint16_t) * 3 + sizeof(struct virtio_used_elem) * queue_size);
     
-    queue->queue_mem = kmalloc(queue_mem_size);
+    /* The device only sees the PFN, so the rings must be physically contiguous */
+    dma_addr_t queue_dma;
+    queue->queue_mem = dma_alloc_coherent(dev->pci_dev, queue_mem_size, &queue_dma);
     if (!queue->queue_mem) {
         serial_puts("[NEURAL-NET] Failed to allocate queue memory\n");
         return -1;
     }
-    
-    /* Clear queue memory */
-    uint8_t *mem = (uint8_t *)queue->queue_mem;
-    for (size_t i = 0; i < queue_mem_size; i++) {
-        mem[i] = 0;
-    }
+    queue->queue_dma = queue_dma;
+    queue->queue_bytes = queue_mem_size;
     
     /* Set up queue pointers */
     queue->desc = (struct virtio_desc *)queue->queue_mem;
-    queue->avail = (struct virtio_avail *)(queue->desc + queue_size);
-    queue->used = (struct virtio_used *)((uint8_t *)queue->avail + sizeof(struct virtio_avail) + sizeof(uint16_t) * queue_size);
+    queue->avail = (struct virtio_avail *)((uint8_t *)queue->queue_mem + avail_offset);
+    queue->used = (struct virtio_used *)((uint8_t *)queue->queue_mem + used_offset);
     
     /* Initialize descriptor chain */
     for (uint16_t i = 0; i < queue_size - 1; i++) {
@@ -235,16 +317,23 @@ static int virtio_init_queue(struct virtio_net_device *dev, struct virtio_queue
     queue->last_used_idx = 0;
     
     /* Set queue PFN */
-    uint64_t queue_pfn = (uint64_t)queue->queue_mem >> 12;
+    uint64_t queue_pfn = queue->queue_dma >> 12;
     virtio_write32(dev, VIRTIO_PCI_QUEUE_PFN, (uint32_t)queue_pfn);
     
+    queue->vector = 0;
+    queue->cpu_id = 0;
+    queue->interrupts = 0;
+    if (dev->msix_enabled) {
+        virtio_net_bind_queue_vector(dev, queue, queue_idx);
+    }
+    
     return 0;
 }
 
 /* Get MAC address from device configuration */
 static void virtio_get_mac_address(struct virtio_net_device *dev) {
     for (int i = 0; i < 6; i++) {
-        dev->mac_addr[i] = virtio_read8(dev, VIRTIO_PCI_CONFIG_OFF + i);
+        dev->mac_addr[i] = virtio_read8(dev, dev->config_off + i);
     }
     
     serial_puts("[NEURAL-NET] MAC Address: ");
@@ -266,7 +355,7 @@ static int virtio_net_init_device(struct hal_device *hal_dev) {
     struct pci_device *pci_dev = hal_dev->pci_dev;
     
     /* Allocate device structure */
-    virtio_net_dev = (struct virtio_net_device *)kmalloc(sizeof(struct virtio_net_device));
+    virtio_net_dev = (struct virtio_net_device *)kcalloc(1, sizeof(struct virtio_net_device));
     if (!virtio_net_dev) {
         serial_puts("[NEURAL-NET] Failed to allocate device structure\n");
         return -1;
@@ -279,6 +368,10 @@ static int virtio_net_init_device(struct hal_device *hal_dev) {
     virtio_net_dev->tx_packets = 0;
     virtio_net_dev->rx_bytes = 0;
     virtio_net_dev->tx_bytes = 0;
+    virtio_net_dev->config_interrupts = 0;
+    
+    /* Legacy devices take a 32-bit queue PFN, i.e. 44-bit ring addresses */
+    dma_set_mask(pci_dev, DMA_BIT_MASK(44));
     
     /* Get I/O base address from BAR0 */
     virtio_net_dev->io_base = pci_dev->bar[0] & ~0x3;
@@ -287,8 +380,21 @@ static int virtio_net_init_device(struct hal_device *hal_dev) {
     print_hex(virtio_net_dev->io_base);
     serial_puts("\n");
     
-    /* Reset device */
+    /* Reset device; the HAL polls until it reads back as reset */
     virtio_write8(virtio_net_dev, VIRTIO_PCI_STATUS, 0);
+    return HAL_PROBE_PENDING;
+}
+
+/* Finish bring-up once the reset has taken effect */
+static int virtio_net_poll_device(struct hal_device *hal_dev) {
+    (void)hal_dev;
+    
+    if (!virtio_net_dev) {
+        return -1;
+    }
+    if (virtio_read8(virtio_net_dev, VIRTIO_PCI_STATUS) != 0) {
+        return HAL_PROBE_PENDING;
+    }
     
     /* Acknowledge device */
     virtio_write8(virtio_net_dev, VIRTIO_PCI_STATUS, VIRTIO_STATUS_ACKNOWLEDGE);
@@ -307,4 +413,230 @@ static int virtio_net_init_device(struct hal_device *hal_dev) {
     /* Select features we support */
     uint32_t guest_features = 0;
     if (virtio_net_dev->features & VIRTIO_NET_F_MAC) {
-        guest_features |= VIRTIO_NET_F_MAC;\n    }\n    if (virtio_net_dev->features & VIRTIO_NET_F_STATUS) {\n        guest_features |= VIRTIO_NET_F_STATUS;\n    }\n    \n    /* Write guest features */\n    virtio_write32(virtio_net_dev, VIRTIO_PCI_GUEST_FEATURES, guest_features);\n    \n    /* Features OK */\n    virtio_write8(virtio_net_dev, VIRTIO_PCI_STATUS, \n                  VIRTIO_STATUS_ACKNOWLEDGE | VIRTIO_STATUS_DRIVER | VIRTIO_STATUS_FEATURES_OK);\n    \n    /* Check features OK */\n    uint8_t status = virtio_read8(virtio_net_dev, VIRTIO_PCI_STATUS);\n    if (!(status & VIRTIO_STATUS_FEATURES_OK)) {\n        serial_puts(\"[NEURAL-NET] Features not accepted by device\\n\");\n        return -1;\n    }\n    \n    /* Initialize queues */\n    if (virtio_init_queue(virtio_net_dev, &virtio_net_dev->rx_queue, VIRTIO_NET_RX_QUEUE) != 0) {\n        serial_puts(\"[NEURAL-NET] Failed to initialize RX queue\\n\");\n        return -1;\n    }\n    \n    if (virtio_init_queue(virtio_net_dev, &virtio_net_dev->tx_queue, VIRTIO_NET_TX_QUEUE) != 0) {\n        serial_puts(\"[NEURAL-NET] Failed to initialize TX queue\\n\");\n        return -1;\n    }\n    \n    /* Get MAC address */\n    if (guest_features & VIRTIO_NET_F_MAC) {\n        virtio_get_mac_address(virtio_net_dev);\n    }\n    \n    /* Driver OK */\n    virtio_write8(virtio_net_dev, VIRTIO_PCI_STATUS, \n                  VIRTIO_STATUS_ACKNOWLEDGE | VIRTIO_STATUS_DRIVER | \n                  VIRTIO_STATUS_FEATURES_OK | VIRTIO_STATUS_DRIVER_OK);\n    \n    virtio_net_dev->initialized = 1;\n    hal_dev->device_data = virtio_net_dev;\n    \n    serial_puts(\"[NEURAL-NET] VirtIO neural network interface initialized successfully\\n\");\n    return 0;\n}\n\n/* Start VirtIO network device */\nstatic int virtio_net_start_device(struct hal_device *hal_dev) {\n    if (!virtio_net_dev || !virtio_net_dev->initialized) {\n        return -1;\n    }\n    \n    serial_puts(\"[NEURAL-NET] Starting neural network interface...\\n\");\n    \n    /* Setup receive buffers (simplified) */\n    /* In a full implementation, we would setup receive buffers here */\n    \n    serial_puts(\"[NEURAL-NET] Neural network interface started\\n\");\n    return 0;\n}\n\n/* Stop VirtIO network device */\nstatic int virtio_net_stop_device(struct hal_device *hal_dev) {\n    if (!virtio_net_dev) {\n        return -1;\n    }\n    \n    serial_puts(\"[NEURAL-NET] Stopping neural network interface...\\n\");\n    \n    /* Reset device */\n    virtio_write8(virtio_net_dev, VIRTIO_PCI_STATUS, 0);\n    \n    serial_puts(\"[NEURAL-NET] Neural network interface stopped\\n\");\n    return 0;\n}\n\n/* Reset VirtIO network device */\nstatic int virtio_net_reset_device(struct hal_device *hal_dev) {\n    serial_puts(\"[NEURAL-NET] Resetting neural network interface...\\n\");\n    \n    if (virtio_net_stop_device(hal_dev) != 0) {\n        return -1;\n    }\n    \n    return virtio_net_init_device(hal_dev);\n}\n\n/* Cleanup VirtIO network device */\nstatic void virtio_net_cleanup_device(struct hal_device *hal_dev) {\n    if (!virtio_net_dev) {\n        return;\n    }\n    \n    serial_puts(\"[NEURAL-NET] Cleaning up neural network interface...\\n\");\n    \n    /* Free queue memory */\n    if (virtio_net_dev->rx_queue.queue_mem) {\n        kfree(virtio_net_dev->rx_queue.queue_mem);\n    }\n    \n    if (virtio_net_dev->tx_queue.queue_mem) {\n        kfree(virtio_net_dev->tx_queue.queue_mem);\n    }\n    \n    /* Free device structure */\n    kfree(virtio_net_dev);\n    virtio_net_dev = NULL;\n    \n    serial_puts(\"[NEURAL-NET] Neural network interface cleanup complete\\n\");\n}\n\n/* Print network statistics */\nvoid virtio_net_print_stats(void) {\n    if (!virtio_net_dev) {\n        serial_puts(\"[NEURAL-NET] No neural network interface available\\n\");\n        return;\n    }\n    \n    serial_puts(\"[NEURAL-NET] === Network Interface Statistics ===\\n\");\n    serial_puts(\"[STATS] RX Packets: \");\n    print_dec(virtio_net_dev->rx_packets);\n    serial_puts(\"\\n\");\n    \n    serial_puts(\"[STATS] TX Packets: \");\n    print_dec(virtio_net_dev->tx_packets);\n    serial_puts(\"\\n\");\n    \n    serial_puts(\"[STATS] RX Bytes: \");\n    print_dec(virtio_net_dev->rx_bytes);\n    serial_puts(\"\\n\");\n    \n    serial_puts(\"[STATS] TX Bytes: \");\n    print_dec(virtio_net_dev->tx_bytes);\n    serial_puts(\"\\n\");\n    \n    serial_puts(\"[NEURAL-NET] === End Statistics ===\\n\");\n}\n\n/* Initialize VirtIO network driver */\nvoid virtio_net_init(void) {\n    serial_puts(\"[NEURAL-NET] Initializing VirtIO neural network driver...\\n\");\n    \n    /* Find VirtIO network device */\n    struct pci_device *virtio_dev = pci_find_device_by_id(VIRTIO_VENDOR_ID, VIRTIO_NET_DEVICE_ID);\n    if (!virtio_dev) {\n        virtio_dev = pci_find_device_by_id(VIRTIO_VENDOR_ID, VIRTIO_NET_DEVICE_ID_MODERN);\n    }\n    \n    if (!virtio_dev) {\n        serial_puts(\"[NEURAL-NET] No VirtIO network device found\\n\");\n        return;\n    }\n    \n    serial_puts(\"[NEURAL-NET] VirtIO network device detected\\n\");\n    \n    /* Create HAL device for VirtIO network */\n    struct hal_device *hal_dev = hal_create_device(DEVICE_TYPE_NETWORK, \n                                                   \"VirtIO Neural Network Interface\", \n                                                   \"Red Hat Inc. (Virtio)\");\n    if (!hal_dev) {\n        serial_puts(\"[NEURAL-NET] Failed to create HAL device\\n\");\n        return;\n    }\n    \n    hal_dev->pci_dev = virtio_dev;\n    hal_dev->init = virtio_net_init_device;\n    hal_dev->start = virtio_net_start_device;\n    hal_dev->stop = virtio_net_stop_device;\n    hal_dev->reset = virtio_net_reset_device;\n    hal_dev->cleanup = virtio_net_cleanup_device;\n    \n    /* Register device with HAL */\n    if (hal_register_device(hal_dev) != 0) {\n        serial_puts(\"[NEURAL-NET] Failed to register HAL device\\n\");\n        kfree(hal_dev);\n        return;\n    }\n    \n    serial_puts(\"[NEURAL-NET] VirtIO neural network driver initialized\\n\");\n}\n\n/* Get network device */\nstruct virtio_net_device *virtio_net_get_device(void) {\n    return virtio_net_dev;\n}", "original_text": "    if (virtio_net_dev->features & VIRTIO_NET_F_MAC) {\n        guest_features |= VIRTIO_NET_F_MAC;"}]
\ No newline at end of file
+        guest_features |= VIRTIO_NET_F_MAC;
+    }
+    if (virtio_net_dev->features & VIRTIO_NET_F_STATUS) {
+        guest_features |= VIRTIO_NET_F_STATUS;
+    }
+    
+    /* Write guest features */
+    virtio_write32(virtio_net_dev, VIRTIO_PCI_GUEST_FEATURES, guest_features);
+    
+    /* Features OK */
+    virtio_write8(virtio_net_dev, VIRTIO_PCI_STATUS, 
+                  VIRTIO_STATUS_ACKNOWLEDGE | VIRTIO_STATUS_DRIVER | VIRTIO_STATUS_FEATURES_OK);
+    
+    /* Check features OK */
+    uint8_t status = virtio_read8(virtio_net_dev, VIRTIO_PCI_STATUS);
+    if (!(status & VIRTIO_STATUS_FEATURES_OK)) {
+        serial_puts("[NEURAL-NET] Features not accepted by device\n");
+        return -1;
+    }
+    
+    /* MSI-X must be on before queue setup: it shifts the register layout */
+    virtio_net_setup_msix(virtio_net_dev);
+    
+    /* Initialize queues */
+    if (virtio_init_queue(virtio_net_dev, &virtio_net_dev->rx_queue, VIRTIO_NET_RX_QUEUE) != 0) {
+        serial_puts("[NEURAL-NET] Failed to initialize RX queue\n");
+        return -1;
+    }
+    
+    if (virtio_init_queue(virtio_net_dev, &virtio_net_dev->tx_queue, VIRTIO_NET_TX_QUEUE) != 0) {
+        serial_puts("[NEURAL-NET] Failed to initialize TX queue\n");
+        return -1;
+    }
+    
+    /* Get MAC address */
+    if (guest_features & VIRTIO_NET_F_MAC) {
+        virtio_get_mac_address(virtio_net_dev);
+    }
+    
+    /* Driver OK */
+    virtio_write8(virtio_net_dev, VIRTIO_PCI_STATUS, 
+                  VIRTIO_STATUS_ACKNOWLEDGE | VIRTIO_STATUS_DRIVER | 
+                  VIRTIO_STATUS_FEATURES_OK | VIRTIO_STATUS_DRIVER_OK);
+    
+    virtio_net_dev->initialized = 1;
+    hal_dev->device_data = virtio_net_dev;
+    
+    serial_puts("[NEURAL-NET] VirtIO neural network interface initialized successfully\n");
+    return 0;
+}
+
+/* Start VirtIO network device */
+static int virtio_net_start_device(struct hal_device *hal_dev) {
+    (void)hal_dev;
+    
+    if (!virtio_net_dev || !virtio_net_dev->initialized) {
+        return -1;
+    }
+    
+    serial_puts("[NEURAL-NET] Starting neural network interface...\n");
+    
+    /* Setup receive buffers (simplified) */
+    /* In a full implementation, we would setup receive buffers here */
+    
+    serial_puts("[NEURAL-NET] Neural network interface started\n");
+    return 0;
+}
+
+/* Stop VirtIO network device */
+static int virtio_net_stop_device(struct hal_device *hal_dev) {
+    (void)hal_dev;
+    
+    if (!virtio_net_dev) {
+        return -1;
+    }
+    
+    serial_puts("[NEURAL-NET] Stopping neural network interface...\n");
+    
+    /* Reset device */
+    virtio_write8(virtio_net_dev, VIRTIO_PCI_STATUS, 0);
+    
+    serial_puts("[NEURAL-NET] Neural network interface stopped\n");
+    return 0;
+}
+
+/* Reset VirtIO network device */
+static int virtio_net_reset_device(struct hal_device *hal_dev) {
+    serial_puts("[NEURAL-NET] Resetting neural network interface...\n");
+    
+    if (virtio_net_stop_device(hal_dev) != 0) {
+        return -1;
+    }
+    
+    /* Give back the vectors and rings before init allocates new ones */
+    virtio_net_cleanup_device(hal_dev);
+    
+    /* Re-probe through the HAL so the reset wait gets the probe timeout */
+    return hal_initialize_device(hal_dev->device_id);
+}
+
+/* Cleanup VirtIO network device */
+static void virtio_net_cleanup_device(struct hal_device *hal_dev) {
+    if (!virtio_net_dev) {
+        return;
+    }
+    
+    if (hal_dev) {
+        hal_dev->device_data = NULL;
+    }
+    
+    serial_puts("[NEURAL-NET] Cleaning up neural network interface...\n");
+    
+    if (virtio_net_dev->msix_enabled) {
+        pci_msix_release(&virtio_net_dev->msix);
+    }
+    
+    /* Free queue memory */
+    if (virtio_net_dev->rx_queue.queue_mem) {
+        dma_free_coherent(virtio_net_dev->pci_dev, virtio_net_dev->rx_queue.queue_bytes,
+                          virtio_net_dev->rx_queue.queue_mem, virtio_net_dev->rx_queue.queue_dma);
+    }
+    
+    if (virtio_net_dev->tx_queue.queue_mem) {
+        dma_free_coherent(virtio_net_dev->pci_dev, virtio_net_dev->tx_queue.queue_bytes,
+                          virtio_net_dev->tx_queue.queue_mem, virtio_net_dev->tx_queue.queue_dma);
+    }
+    
+    /* Free device structure */
+    kfree(virtio_net_dev);
+    virtio_net_dev = NULL;
+    
+    serial_puts("[NEURAL-NET] Neural network interface cleanup complete\n");
+}
+
+/* Print network statistics */
+void virtio_net_print_stats(void) {
+    if (!virtio_net_dev) {
+        serial_puts("[NEURAL-NET] No neural network interface available\n");
+        return;
+    }
+    
+    serial_puts("[NEURAL-NET] === Network Interface Statistics ===\n");
+    serial_puts("[STATS] RX Packets: ");
+    print_dec(virtio_net_dev->rx_packets);
+    serial_puts("\n");
+    
+    serial_puts("[STATS] TX Packets: ");
+    print_dec(virtio_net_dev->tx_packets);
+    serial_puts("\n");
+    
+    serial_puts("[STATS] RX Bytes: ");
+    print_dec(virtio_net_dev->rx_bytes);
+    serial_puts("\n");
+    
+    serial_puts("[STATS] TX Bytes: ");
+    print_dec(virtio_net_dev->tx_bytes);
+    serial_puts("\n");
+    
+    if (virtio_net_dev->msix_enabled) {
+        serial_puts("[STATS] RX Interrupts: ");
+        print_dec(virtio_net_dev->rx_queue.interrupts);
+        serial_puts(" (vector ");
+        print_hex(virtio_net_dev->rx_queue.vector);
+        serial_puts(", CPU ");
+        print_dec(virtio_net_dev->rx_queue.cpu_id);
+        serial_puts(")\n");
+        
+        serial_puts("[STATS] TX Interrupts: ");
+        print_dec(virtio_net_dev->tx_queue.interrupts);
+        serial_puts(" (vector ");
+        print_hex(virtio_net_dev->tx_queue.vector);
+        serial_puts(", CPU ");
+        print_dec(virtio_net_dev->tx_queue.cpu_id);
+        serial_puts(")\n");
+    }
+    
+    serial_puts("[NEURAL-NET] === End Statistics ===\n");
+}
+
+/* Initialize VirtIO network driver */
+void virtio_net_init(void) {
+    serial_puts("[NEURAL-NET] Initializing VirtIO neural network driver...\n");
+    
+    /* Find VirtIO network device */
+    struct pci_device *virtio_dev = pci_find_device_by_id(VIRTIO_VENDOR_ID, VIRTIO_NET_DEVICE_ID);
+    if (!virtio_dev) {
+        virtio_dev = pci_find_device_by_id(VIRTIO_VENDOR_ID, VIRTIO_NET_DEVICE_ID_MODERN);
+    }
+    
+    if (!virtio_dev) {
+        serial_puts("[NEURAL-NET] No VirtIO network device found\n");
+        return;
+    }
+    
+    serial_puts("[NEURAL-NET] VirtIO network device detected\n");
+    
+    /* Create HAL device for VirtIO network */
+    struct hal_device *hal_dev = hal_create_device(DEVICE_TYPE_NETWORK, 
+                                                   "VirtIO Neural Network Interface", 
+                                                   "Red Hat Inc. (Virtio)");
+    if (!hal_dev) {
+        serial_puts("[NEURAL-NET] Failed to create HAL device\n");
+        return;
+    }
+    
+    hal_dev->pci_dev = virtio_dev;
+    hal_dev->init = virtio_net_init_device;
+    hal_dev->poll = virtio_net_poll_device;
+    hal_dev->start = virtio_net_start_device;
+    hal_dev->stop = virtio_net_stop_device;
+    hal_dev->reset = virtio_net_reset_device;
+    hal_dev->cleanup = virtio_net_cleanup_device;
+    
+    /* Register device with HAL */
+    if (hal_register_device(hal_dev) != 0) {
+        serial_puts("[NEURAL-NET] Failed to register HAL device\n");
+        kfree(hal_dev);
+        return;
+    }
+    
+    serial_puts("[NEURAL-NET] VirtIO neural network driver initialized\n");
+}
+
+/* Get network device */
+struct virtio_net_device *virtio_net_get_device(void) {
+    return virtio_net_dev;
+}
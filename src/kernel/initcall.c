@@ -0,0 +1,249 @@
+/* initcall.c - Brandon Media OS Initcall Graph
+ * Starts Subsystems by Level, Dependencies First, Deferring What Can Wait
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "kernel/initcall.h"
+#include "kernel/boot_profile.h"
+#include "kernel/process.h"
+#include "kernel/tsc.h"
+
+/* External functions */
+extern void serial_puts(const char *s);
+extern void print_dec(uint64_t num);
+extern uint64_t timer_get_ticks(void);
+
+/* Registered initcall and its progress */
+typedef struct {
+    const initcall_t *call;
+    initcall_state_t state;
+    uint64_t cycles;
+} initcall_entry_t;
+
+typedef struct {
+    initcall_entry_t entries[INITCALL_MAX_CALLS];
+    uint32_t count;
+    bool headless;
+    bool late_started;
+    uint64_t late_wait_start;       /* Timer tick the late level started waiting */
+} initcall_system_t;
+
+static initcall_system_t initcalls;
+
+static const char *initcall_level_names[INITCALL_LEVEL_COUNT] = {
+    "core", "subsys", "device", "user", "late"
+};
+
+static const char *initcall_state_names[] = {
+    "pending", "running", "done", "failed", "skipped"
+};
+
+static bool initcall_name_is(const char *a, const char *b) {
+    while (*a && *a == *b) {
+        a++;
+        b++;
+    }
+    return *a == *b;
+}
+
+static initcall_entry_t *initcall_find(const char *name) {
+    for (uint32_t i = 0; i < initcalls.count; i++) {
+        if (initcall_name_is(initcalls.entries[i].call->name, name)) {
+            return &initcalls.entries[i];
+        }
+    }
+    return NULL;
+}
+
+/* Add a table of declared initcalls; names must be unique */
+int initcall_register(const initcall_t *calls, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        if (initcalls.count >= INITCALL_MAX_CALLS || initcall_find(calls[i].name)) {
+            serial_puts("[NEURAL-INIT] Cannot register initcall ");
+            serial_puts(calls[i].name);
+            serial_puts("\n");
+            return -1;
+        }
+        
+        initcall_entry_t *entry = &initcalls.entries[initcalls.count++];
+        entry->call = &calls[i];
+        entry->state = INITCALL_PENDING;
+        entry->cycles = 0;
+    }
+    return 0;
+}
+
+void initcall_set_headless(bool headless) {
+    initcalls.headless = headless;
+    serial_puts(headless ? "[NEURAL-INIT] Headless: graphics initcalls disabled\n"
+                         : "[NEURAL-INIT] Display present: graphics initcalls enabled\n");
+}
+
+bool initcall_is_headless(void) {
+    return initcalls.headless;
+}
+
+static void initcall_skip(initcall_entry_t *entry, const char *reason, const char *detail) {
+    entry->state = INITCALL_SKIPPED;
+    serial_puts("[NEURAL-INIT] Skipping ");
+    serial_puts(entry->call->name);
+    serial_puts(": ");
+    serial_puts(reason);
+    if (detail) {
+        serial_puts(detail);
+    }
+    serial_puts("\n");
+}
+
+/* Start one initcall after its dependencies; 0 once it has run successfully */
+static int initcall_start(initcall_entry_t *entry) {
+    switch (entry->state) {
+        case INITCALL_DONE:
+            return 0;
+        case INITCALL_RUNNING:
+            serial_puts("[NEURAL-INIT] Dependency cycle through ");
+            serial_puts(entry->call->name);
+            serial_puts("\n");
+            return -1;
+        case INITCALL_FAILED:
+        case INITCALL_SKIPPED:
+            return -1;
+        default:
+            break;
+    }
+    
+    const initcall_t *call = entry->call;
+    if ((call->flags & INITCALL_GRAPHICS) && initcalls.headless) {
+        initcall_skip(entry, "headless", NULL);
+        return -1;
+    }
+    
+    entry->state = INITCALL_RUNNING;
+    
+    for (int i = 0; i < INITCALL_MAX_DEPENDENCIES && call->depends_on[i]; i++) {
+        const char *name = call->depends_on[i];
+        bool ordering_only = name[0] == '?';
+        initcall_entry_t *dependency = initcall_find(ordering_only ? name + 1 : name);
+        
+        if (ordering_only) {
+            /* Only wait for calls that will run anyway */
+            if (dependency && dependency->state == INITCALL_PENDING &&
+                !(dependency->call->flags & INITCALL_LAZY) && dependency->call->level <= call->level) {
+                initcall_start(dependency);
+            }
+            continue;
+        }
+        
+        if (!dependency) {
+            initcall_skip(entry, "unknown dependency ", name);
+            return -1;
+        }
+        if (initcall_start(dependency) != 0) {
+            initcall_skip(entry, "needs ", name);
+            return -1;
+        }
+    }
+    
+    boot_profile_begin(call->name);
+    uint64_t start = rdtsc();
+    int result = call->fn();
+    entry->cycles = rdtsc() - start;
+    boot_profile_end();
+    
+    if (result != 0) {
+        entry->state = INITCALL_FAILED;
+        serial_puts("[NEURAL-INIT] Initcall failed: ");
+        serial_puts(call->name);
+        serial_puts("\n");
+        return -1;
+    }
+    
+    entry->state = INITCALL_DONE;
+    return 0;
+}
+
+/* Run every non-lazy initcall at `level`; returns the number that did not come up */
+int initcall_run_level(initcall_level_t level) {
+    int failures = 0;
+    
+    serial_puts("[NEURAL-INIT] Level ");
+    serial_puts(initcall_level_names[level]);
+    serial_puts("\n");
+    
+    for (uint32_t i = 0; i < initcalls.count; i++) {
+        initcall_entry_t *entry = &initcalls.entries[i];
+        if (entry->call->level != level || (entry->call->flags & INITCALL_LAZY)) {
+            continue;
+        }
+        if (entry->state == INITCALL_PENDING && initcall_start(entry) != 0) {
+            failures++;
+        }
+    }
+    return failures;
+}
+
+/* Start a subsystem on demand, with everything it depends on */
+int initcall_require(const char *name) {
+    initcall_entry_t *entry = initcall_find(name);
+    if (!entry) {
+        return -1;
+    }
+    return initcall_start(entry);
+}
+
+bool initcall_is_done(const char *name) {
+    initcall_entry_t *entry = initcall_find(name);
+    return entry && entry->state == INITCALL_DONE;
+}
+
+/* Called from the main loop: run the late level once userland is up (or
+ * after a timeout without one). Returns true on the call that ran it.
+ */
+bool initcall_poll_deferred(void) {
+    if (initcalls.late_started) {
+        return false;
+    }
+    
+    uint64_t now = timer_get_ticks();
+    if (initcalls.late_wait_start == 0) {
+        initcalls.late_wait_start = now ? now : 1;
+    }
+    
+    bool timed_out = now - initcalls.late_wait_start >= INITCALL_LATE_TIMEOUT_TICKS;
+    if (!scheduler_userland_started() && !timed_out) {
+        return false;
+    }
+    
+    initcalls.late_started = true;
+    if (timed_out && !scheduler_userland_started()) {
+        serial_puts("[NEURAL-INIT] No userland process yet, starting late initcalls anyway\n");
+    }
+    initcall_run_level(INITCALL_LEVEL_LATE);
+    return true;
+}
+
+/* Print every initcall with its state and start-up time */
+void initcall_print_status(void) {
+    serial_puts("[NEURAL-INIT] === Initcalls ===\n");
+    for (uint32_t i = 0; i < initcalls.count; i++) {
+        initcall_entry_t *entry = &initcalls.entries[i];
+        
+        serial_puts("[INIT] ");
+        serial_puts(initcall_level_names[entry->call->level]);
+        serial_puts(" ");
+        serial_puts(entry->call->name);
+        serial_puts(": ");
+        serial_puts(initcall_state_names[entry->state]);
+        if (entry->state == INITCALL_PENDING && (entry->call->flags & INITCALL_LAZY)) {
+            serial_puts(" (on demand)");
+        }
+        if (entry->cycles) {
+            serial_puts(", ");
+            print_dec(tsc_cycles_to_us(entry->cycles));
+            serial_puts("us");
+        }
+        serial_puts("\n");
+    }
+}
@@ -1,6 +1,7 @@
 /* exceptions.c - Brandon Media OS Exception Handlers */
 #include <stdint.h>
 #include "kernel/interrupts.h"
+#include "kernel/uart.h"
 
 /* Register structure for interrupt context */
 struct registers {
@@ -56,6 +57,9 @@ static void print_hex(uint64_t num) {
 
 /* Main exception handler */
 void exception_handler(struct registers *regs) {
+    /* Queued log output first, then the report by polling */
+    uart_panic();
+    
     /* Brandon Media OS cyberpunk error display */
     serial_puts("\n");
     serial_puts("╔═══════════════════════════════════════════════════════════╗\n");
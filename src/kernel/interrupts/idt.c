@@ -8,6 +8,9 @@ static struct idt_ptr idt_pointer;
 
 /* External assembly functions */
 extern void idt_flush(uint64_t);
+extern char irq_vector_stubs[];
+extern char irq_legacy_stubs[];
+extern void irq_spurious(void);
 
 /* Set up an IDT entry */
 void idt_set_gate(uint8_t num, uint64_t handler, uint16_t sel, uint8_t flags) {
@@ -51,6 +54,23 @@ void idt_init(void) {
     idt_set_gate(IRQ_TIMER,    (uint64_t)timer_handler,    0x08, IDT_PRESENT | IDT_INTERRUPT | IDT_RING0);
     idt_set_gate(IRQ_KEYBOARD, (uint64_t)keyboard_handler, 0x08, IDT_PRESENT | IDT_INTERRUPT | IDT_RING0);
     idt_set_gate(IRQ_SERIAL,   (uint64_t)serial_handler,   0x08, IDT_PRESENT | IDT_INTERRUPT | IDT_RING0);
+    
+    /* Every other legacy line gets a generic stub so registered handlers and
+     * spurious 8259 IRQs (7 and 15) reach irq_handler()
+     */
+    for (int irq = 0; irq < IRQ_LEGACY_COUNT; irq++) {
+        if (!(idt[32 + irq].type_attr & IDT_PRESENT)) {
+            uint64_t stub = (uint64_t)irq_legacy_stubs + irq * IRQ_VECTOR_STUB_SIZE;
+            idt_set_gate(32 + irq, stub, 0x08, IDT_PRESENT | IDT_INTERRUPT | IDT_RING0);
+        }
+    }
+    idt_set_gate(IRQ_SPURIOUS_VECTOR, (uint64_t)irq_spurious, 0x08, IDT_PRESENT | IDT_INTERRUPT | IDT_RING0);
+
+    /* Dynamic vectors for MSI/MSI-X */
+    for (int vector = IRQ_VECTOR_DYNAMIC_BASE; vector < IRQ_VECTOR_DYNAMIC_END; vector++) {
+        uint64_t stub = (uint64_t)irq_vector_stubs + (vector - IRQ_VECTOR_DYNAMIC_BASE) * IRQ_VECTOR_STUB_SIZE;
+        idt_set_gate(vector, stub, 0x08, IDT_PRESENT | IDT_INTERRUPT | IDT_RING0);
+    }
 
     /* Load the IDT */
     idt_flush((uint64_t)&idt_pointer);
@@ -0,0 +1,286 @@
+/* ioapic.c - Brandon Media OS I/O APIC Interrupt Routing
+ * Routes Legacy IRQs Through the MADT's I/O APICs to Local APICs
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "kernel/ioapic.h"
+#include "kernel/acpi.h"
+#include "kernel/memory.h"
+#include "kernel/smp.h"
+
+/* Register window page flags */
+#define IOAPIC_MMIO_FLAGS   (PAGE_PRESENT | PAGE_WRITABLE | PAGE_CACHE_DISABLED | PAGE_NO_EXECUTE)
+#define IOAPIC_MMIO_SIZE    0x20
+
+/* External functions */
+extern void serial_puts(const char *s);
+extern void print_hex(uint64_t num);
+extern void print_dec(uint64_t num);
+
+/* One I/O APIC and the GSIs it serves */
+typedef struct {
+    volatile uint32_t *base;
+    uint8_t id;
+    uint32_t gsi_base;
+    uint32_t pins;
+} ioapic_controller_t;
+
+/* Legacy IRQ routing, after interrupt source overrides */
+typedef struct {
+    uint32_t gsi;
+    uint16_t flags;                 /* MADT polarity/trigger */
+    uint8_t vector;
+    uint8_t cpu_id;
+    bool routed;
+} ioapic_irq_t;
+
+typedef struct {
+    ioapic_controller_t controllers[IOAPIC_MAX_CONTROLLERS];
+    uint32_t controller_count;
+    ioapic_irq_t irqs[IOAPIC_ISA_IRQS];
+    uint32_t lapic_count;
+    uint64_t lapic_address;
+} ioapic_state_t;
+
+static ioapic_state_t ioapic;
+static bool ioapic_initialized = false;
+
+static uint32_t ioapic_read(ioapic_controller_t *controller, uint8_t reg) {
+    controller->base[IOAPIC_REGSEL / 4] = reg;
+    return controller->base[IOAPIC_WINDOW / 4];
+}
+
+static void ioapic_write(ioapic_controller_t *controller, uint8_t reg, uint32_t value) {
+    controller->base[IOAPIC_REGSEL / 4] = reg;
+    controller->base[IOAPIC_WINDOW / 4] = value;
+}
+
+/* Controller serving a GSI, with the pin it arrives on */
+static ioapic_controller_t *ioapic_for_gsi(uint32_t gsi, uint32_t *pin) {
+    for (uint32_t i = 0; i < ioapic.controller_count; i++) {
+        ioapic_controller_t *controller = &ioapic.controllers[i];
+        if (gsi >= controller->gsi_base && gsi < controller->gsi_base + controller->pins) {
+            *pin = gsi - controller->gsi_base;
+            return controller;
+        }
+    }
+    return NULL;
+}
+
+static void ioapic_add_controller(const acpi_madt_ioapic_t *entry) {
+    if (ioapic.controller_count >= IOAPIC_MAX_CONTROLLERS) {
+        return;
+    }
+    
+    uint64_t offset = entry->address & PAGE_MASK;
+    uint8_t *mapped = (uint8_t *)vmm_map(entry->address - offset, offset + IOAPIC_MMIO_SIZE, IOAPIC_MMIO_FLAGS);
+    if (!mapped) {
+        return;
+    }
+    
+    ioapic_controller_t *controller = &ioapic.controllers[ioapic.controller_count++];
+    controller->base = (volatile uint32_t *)(mapped + offset);
+    controller->id = entry->ioapic_id;
+    controller->gsi_base = entry->gsi_base;
+    controller->pins = ((ioapic_read(controller, IOAPIC_REG_VERSION) >> 16) & 0xFF) + 1;
+    
+    /* Nothing fires until a driver routes it */
+    for (uint32_t pin = 0; pin < controller->pins; pin++) {
+        ioapic_write(controller, IOAPIC_REG_REDIRECT + pin * 2, IOAPIC_REDIRECT_MASKED);
+        ioapic_write(controller, IOAPIC_REG_REDIRECT + pin * 2 + 1, 0);
+    }
+    
+    serial_puts("[NEURAL-IOAPIC] I/O APIC ");
+    print_dec(controller->id);
+    serial_puts(" at ");
+    print_hex(entry->address);
+    serial_puts(", GSI ");
+    print_dec(controller->gsi_base);
+    serial_puts("-");
+    print_dec(controller->gsi_base + controller->pins - 1);
+    serial_puts("\n");
+}
+
+/* Walk the MADT: controllers, overrides and CPU count */
+static void ioapic_parse_madt(const acpi_madt_t *madt) {
+    ioapic.lapic_address = madt->lapic_address;
+    
+    const uint8_t *cursor = (const uint8_t *)(madt + 1);
+    const uint8_t *end = (const uint8_t *)madt + madt->header.length;
+    
+    while (cursor + sizeof(acpi_madt_entry_t) <= end) {
+        const acpi_madt_entry_t *entry = (const acpi_madt_entry_t *)cursor;
+        if (entry->length < sizeof(acpi_madt_entry_t) || cursor + entry->length > end) {
+            break;
+        }
+        
+        switch (entry->type) {
+            case ACPI_MADT_LOCAL_APIC:
+                if (((const acpi_madt_lapic_t *)entry)->flags & ACPI_MADT_LAPIC_ENABLED) {
+                    ioapic.lapic_count++;
+                }
+                break;
+            
+            case ACPI_MADT_IO_APIC:
+                ioapic_add_controller((const acpi_madt_ioapic_t *)entry);
+                break;
+            
+            case ACPI_MADT_INT_OVERRIDE: {
+                const acpi_madt_override_t *override = (const acpi_madt_override_t *)entry;
+                if (override->bus == 0 && override->source < IOAPIC_ISA_IRQS) {
+                    ioapic.irqs[override->source].gsi = override->gsi;
+                    ioapic.irqs[override->source].flags = override->flags;
+                }
+                break;
+            }
+            
+            case ACPI_MADT_LAPIC_OVERRIDE:
+                ioapic.lapic_address = ((const acpi_madt_lapic_override_t *)entry)->address;
+                break;
+            
+            default:
+                break;
+        }
+        
+        cursor += entry->length;
+    }
+}
+
+/* Initialize I/O APIC routing from the MADT; all pins start masked */
+int ioapic_init(void) {
+    if (ioapic_initialized) {
+        return 0;
+    }
+    
+    for (int i = 0; i < IOAPIC_ISA_IRQS; i++) {
+        ioapic.irqs[i].gsi = i;     /* ISA IRQs are identity mapped unless overridden */
+        ioapic.irqs[i].flags = 0;
+        ioapic.irqs[i].vector = 0;
+        ioapic.irqs[i].cpu_id = 0;
+        ioapic.irqs[i].routed = false;
+    }
+    ioapic.controller_count = 0;
+    ioapic.lapic_count = 0;
+    
+    acpi_init();
+    const acpi_madt_t *madt = (const acpi_madt_t *)acpi_find_table("APIC");
+    if (!madt) {
+        serial_puts("[NEURAL-IOAPIC] No MADT, staying on the 8259 PIC\n");
+        return -1;
+    }
+    
+    ioapic_parse_madt(madt);
+    if (ioapic.controller_count == 0) {
+        serial_puts("[NEURAL-IOAPIC] MADT lists no I/O APIC, staying on the 8259 PIC\n");
+        return -1;
+    }
+    
+    ioapic_initialized = true;
+    
+    serial_puts("[NEURAL-IOAPIC] ");
+    print_dec(ioapic.controller_count);
+    serial_puts(" I/O APIC(s), ");
+    print_dec(ioapic.lapic_count);
+    serial_puts(" local APICs at ");
+    print_hex(ioapic.lapic_address);
+    serial_puts("\n");
+    return 0;
+}
+
+bool ioapic_is_enabled(void) {
+    return ioapic_initialized;
+}
+
+uint32_t ioapic_irq_to_gsi(uint8_t irq) {
+    return irq < IOAPIC_ISA_IRQS ? ioapic.irqs[irq].gsi : irq;
+}
+
+/* Program one redirection entry from the routing table */
+static int ioapic_program(uint8_t irq, bool masked) {
+    ioapic_irq_t *route = &ioapic.irqs[irq];
+    uint32_t pin;
+    ioapic_controller_t *controller = ioapic_for_gsi(route->gsi, &pin);
+    if (!controller) {
+        return -1;
+    }
+    
+    /* ISA defaults are edge/active-high; overrides may say otherwise */
+    uint32_t low = route->vector;
+    if ((route->flags & ACPI_MADT_POLARITY_MASK) == ACPI_MADT_POLARITY_LOW) {
+        low |= IOAPIC_REDIRECT_POLARITY_LOW;
+    }
+    if ((route->flags & ACPI_MADT_TRIGGER_MASK) == ACPI_MADT_TRIGGER_LEVEL) {
+        low |= IOAPIC_REDIRECT_TRIGGER_LEVEL;
+    }
+    if (masked) {
+        low |= IOAPIC_REDIRECT_MASKED;
+    }
+    
+    /* Mask while the destination changes so no half-written entry fires */
+    ioapic_write(controller, IOAPIC_REG_REDIRECT + pin * 2, IOAPIC_REDIRECT_MASKED);
+    ioapic_write(controller, IOAPIC_REG_REDIRECT + pin * 2 + 1,
+                 smp_get_apic_id(route->cpu_id) << IOAPIC_REDIRECT_DEST_SHIFT);
+    ioapic_write(controller, IOAPIC_REG_REDIRECT + pin * 2, low);
+    return 0;
+}
+
+/* Deliver a legacy IRQ as `vector` to `cpu_id` and unmask it */
+int ioapic_route_irq(uint8_t irq, uint8_t vector, uint8_t cpu_id) {
+    if (!ioapic_initialized || irq >= IOAPIC_ISA_IRQS) {
+        return -1;
+    }
+    
+    ioapic.irqs[irq].vector = vector;
+    ioapic.irqs[irq].cpu_id = cpu_id;
+    if (ioapic_program(irq, false) != 0) {
+        return -1;
+    }
+    
+    ioapic.irqs[irq].routed = true;
+    return 0;
+}
+
+/* Move a routed IRQ to another CPU */
+int ioapic_set_affinity(uint8_t irq, uint8_t cpu_id) {
+    if (!ioapic_initialized || irq >= IOAPIC_ISA_IRQS || !ioapic.irqs[irq].routed) {
+        return -1;
+    }
+    
+    ioapic.irqs[irq].cpu_id = cpu_id;
+    return ioapic_program(irq, false);
+}
+
+void ioapic_mask_irq(uint8_t irq, bool masked) {
+    if (!ioapic_initialized || irq >= IOAPIC_ISA_IRQS || !ioapic.irqs[irq].routed) {
+        return;
+    }
+    
+    ioapic_program(irq, masked);
+}
+
+/* Print legacy IRQ routes */
+void ioapic_print_routes(void) {
+    if (!ioapic_initialized) {
+        serial_puts("[NEURAL-IOAPIC] Not active\n");
+        return;
+    }
+    
+    serial_puts("[NEURAL-IOAPIC] === Interrupt Routes ===\n");
+    for (int irq = 0; irq < IOAPIC_ISA_IRQS; irq++) {
+        if (!ioapic.irqs[irq].routed) {
+            continue;
+        }
+        
+        serial_puts("[ROUTE] IRQ ");
+        print_dec(irq);
+        serial_puts(" -> GSI ");
+        print_dec(ioapic.irqs[irq].gsi);
+        serial_puts(" -> vector ");
+        print_hex(ioapic.irqs[irq].vector);
+        serial_puts(" on CPU ");
+        print_dec(ioapic.irqs[irq].cpu_id);
+        serial_puts("\n");
+    }
+}
@@ -1,6 +1,13 @@
 /* irq.c - Brandon Media OS Hardware Interrupt Handlers */
 #include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
 #include "kernel/interrupts.h"
+#include "kernel/ioapic.h"
+#include "kernel/smp.h"
+#include "kernel/tsc.h"
+#include "kernel/fs.h"
 
 /* Register structure for interrupt context */
 struct registers {
@@ -16,6 +23,12 @@ struct registers {
 #define PIC2_COMMAND    0xA0
 #define PIC2_DATA       0xA1
 #define PIC_EOI         0x20    /* End of Interrupt */
+#define PIC_READ_ISR    0x0B    /* OCW3: next command-port read returns the ISR */
+
+/* Text view of the statistics */
+#define IRQ_STATS_DEVICE_DIR    "/dev"
+#define IRQ_STATS_DEVICE_NAME   "interrupts"
+#define IRQ_STATS_TEXT_SIZE     8192
 
 /* I/O port functions */
 static inline void outb(uint16_t port, uint8_t val) {
@@ -32,12 +45,53 @@ static inline uint8_t inb(uint16_t port) {
 extern void serial_puts(const char *s);
 extern void serial_putc(char c);
 extern void scheduler_tick(void);
+extern void smp_apic_eoi(void);
+extern void print_dec(uint64_t num);
+extern void print_hex(uint64_t num);
+extern int snprintf(char *str, size_t size, const char *format, ...);
+
+/* Context of the interrupt being handled; NULL outside one */
+static const irq_context_t *irq_current_context = NULL;
+
+/* Global timer tick counter (read by timer.c) */
+volatile uint64_t timer_ticks = 0;
+
+/* Registered legacy handler; shared lines chain through `next` */
+typedef struct irq_action {
+    irq_handler_t handler;
+    void *data;
+    const char *name;
+    struct irq_action *next;
+} irq_action_t;
+
+static irq_action_t irq_actions[IRQ_MAX_ACTIONS];
+static irq_action_t *irq_chains[IRQ_LEGACY_COUNT];
 
-/* Global timer tick counter */
-static volatile uint64_t timer_ticks = 0;
+/* Statistics, indexed by IDT vector */
+static irq_stats_t irq_stats[256];
+static uint64_t irq_cpu_totals[IRQ_STATS_MAX_CPUS];
+static char irq_stats_text[IRQ_STATS_TEXT_SIZE];
+
+/* Dynamic vector table (MSI/MSI-X), indexed by IDT vector */
+static struct {
+    irq_vector_handler_t handler;
+    void *data;
+    uint8_t cpu_id;
+} irq_vectors[IRQ_VECTOR_DYNAMIC_END];
+
+/* Delivery CPU per legacy IRQ */
+static uint8_t irq_affinity[IRQ_LEGACY_COUNT];
+
+static int irq_timer_handler(uint8_t irq, void *data);
 
 /* Send End of Interrupt signal */
 static void send_eoi(uint8_t irq) {
+    /* Routed through the I/O APIC: one local APIC write, no port I/O */
+    if (ioapic_is_enabled()) {
+        smp_apic_eoi();
+        return;
+    }
+    
     if (irq >= 8) {
         outb(PIC2_COMMAND, PIC_EOI);  /* Send EOI to slave PIC */
     }
@@ -46,6 +100,11 @@ static void send_eoi(uint8_t irq) {
 
 /* Initialize PIC (Programmable Interrupt Controller) */
 void pic_init(void) {
+    /* Built-in devices; drivers add theirs with irq_register_handler() */
+    if (!irq_chains[0]) {
+        irq_register_handler(0, irq_timer_handler, NULL, "timer");
+    }
+    
     /* Save current interrupt masks */
     uint8_t mask1 = inb(PIC1_DATA);
     uint8_t mask2 = inb(PIC2_DATA);
@@ -66,19 +125,50 @@ void pic_init(void) {
     outb(PIC1_DATA, 0x01);
     outb(PIC2_DATA, 0x01);
     
+    /* Hand interrupts to the I/O APIC when the MADT describes one */
+    if (ioapic_init() == 0) {
+        pic_disable();
+        
+        /* I/O APIC pins start masked; carry over every line the 8259 had
+         * open or a handler is already waiting on. IRQ 2 is only the cascade.
+         */
+        uint16_t unmasked = (uint16_t)~(mask1 | (mask2 << 8));
+        for (uint8_t irq = 0; irq < IRQ_LEGACY_COUNT; irq++) {
+            if (irq != 2 && (irq_chains[irq] || (unmasked & (1 << irq)))) {
+                irq_enable(irq);
+            }
+        }
+        
+        serial_puts("[NEURAL-IRQ] Legacy IRQs routed through the I/O APIC\n");
+        return;
+    }
+    
     /* Restore interrupt masks */
     outb(PIC1_DATA, mask1);
     outb(PIC2_DATA, mask2);
 }
 
+/* Mask every 8259 line; they stay remapped so spurious IRQs hit known vectors */
+void pic_disable(void) {
+    outb(PIC1_DATA, 0xFF);
+    outb(PIC2_DATA, 0xFF);
+}
+
 /* Enable specific IRQ */
 void irq_enable(uint8_t irq) {
     uint16_t port;
     uint8_t value;
     
+    if (ioapic_is_enabled()) {
+        ioapic_route_irq(irq, 32 + irq, irq_affinity[irq & 0xF]);
+        return;
+    }
+    
     if (irq < 8) {
         port = PIC1_DATA;
     } else {
+        /* Slave lines only reach the CPU through the cascade on IRQ 2 */
+        outb(PIC1_DATA, inb(PIC1_DATA) & ~(1 << 2));
         port = PIC2_DATA;
         irq -= 8;
     }
@@ -87,8 +177,119 @@ void irq_enable(uint8_t irq) {
     outb(port, value);
 }
 
+/* Choose the CPU a legacy IRQ is delivered to (I/O APIC only) */
+int irq_set_affinity(uint8_t irq, uint8_t cpu_id) {
+    if (irq >= IRQ_LEGACY_COUNT) {
+        return -1;
+    }
+    
+    irq_affinity[irq] = cpu_id;
+    return ioapic_is_enabled() ? ioapic_set_affinity(irq, cpu_id) : -1;
+}
+
+/* Allocate `count` consecutive vectors (power of two, naturally aligned as
+ * multi-message MSI requires). Returns the first vector or -1.
+ */
+int irq_vector_alloc(uint32_t count, irq_vector_handler_t handler, void *data, uint8_t cpu_id) {
+    if (!handler || count == 0 || (count & (count - 1)) != 0 || count > 32) {
+        return -1;
+    }
+    
+    /* Round the base up to the block alignment */
+    uint32_t first = (IRQ_VECTOR_DYNAMIC_BASE + count - 1) & ~(count - 1);
+    
+    for (uint32_t base = first; base + count <= IRQ_VECTOR_DYNAMIC_END; base += count) {
+        uint32_t i;
+        for (i = 0; i < count; i++) {
+            if (irq_vectors[base + i].handler) {
+                break;
+            }
+        }
+        if (i < count) {
+            continue;
+        }
+        
+        for (i = 0; i < count; i++) {
+            irq_vectors[base + i].data = data;
+            irq_vectors[base + i].cpu_id = cpu_id;
+            irq_vectors[base + i].handler = handler;
+        }
+        return (int)base;
+    }
+    
+    serial_puts("[NEURAL-IRQ] Interrupt vectors exhausted\n");
+    return -1;
+}
+
+void irq_vector_free(uint8_t vector, uint32_t count) {
+    for (uint32_t i = 0; i < count && vector + i < IRQ_VECTOR_DYNAMIC_END; i++) {
+        if (vector + i >= IRQ_VECTOR_DYNAMIC_BASE) {
+            irq_vectors[vector + i].handler = NULL;
+            irq_vectors[vector + i].data = NULL;
+        }
+    }
+}
+
+uint8_t irq_vector_get_cpu(uint8_t vector) {
+    return vector < IRQ_VECTOR_DYNAMIC_END ? irq_vectors[vector].cpu_id : 0;
+}
+
+/* Attach a handler to a legacy IRQ line; lines may be shared. The line is
+ * still unmasked separately with irq_enable().
+ */
+int irq_register_handler(uint8_t irq, irq_handler_t handler, void *data, const char *name) {
+    if (irq >= IRQ_LEGACY_COUNT || !handler) {
+        return -1;
+    }
+    
+    irq_action_t *action = NULL;
+    for (int i = 0; i < IRQ_MAX_ACTIONS; i++) {
+        if (!irq_actions[i].handler) {
+            action = &irq_actions[i];
+            break;
+        }
+    }
+    if (!action) {
+        serial_puts("[NEURAL-IRQ] Handler table full\n");
+        return -1;
+    }
+    
+    action->data = data;
+    action->name = name ? name : "unnamed";
+    action->next = NULL;
+    action->handler = handler;
+    
+    /* Append so earlier registrants keep first look at the line */
+    irq_action_t **link = &irq_chains[irq];
+    while (*link) {
+        link = &(*link)->next;
+    }
+    *link = action;
+    return 0;
+}
+
+int irq_unregister_handler(uint8_t irq, irq_handler_t handler, void *data) {
+    if (irq >= IRQ_LEGACY_COUNT) {
+        return -1;
+    }
+    
+    for (irq_action_t **link = &irq_chains[irq]; *link; link = &(*link)->next) {
+        irq_action_t *action = *link;
+        if (action->handler == handler && action->data == data) {
+            *link = action->next;
+            action->handler = NULL;
+            action->next = NULL;
+            return 0;
+        }
+    }
+    return -1;
+}
+
 /* Timer interrupt handler */
-void handle_timer_irq(void) {
+static int irq_timer_handler(uint8_t irq, void *data) {
+    (void)irq;
+    (void)data;
+    
     timer_ticks++;
     
     /* Call scheduler tick for process management */
@@ -110,49 +311,325 @@ void handle_timer_irq(void) {
         serial_puts(&buffer[i + 1]);
         serial_puts(" cycles\n");
     }
+    return IRQ_HANDLED;
 }
 
-/* Keyboard interrupt handler */
-void handle_keyboard_irq(void) {
-    uint8_t scancode = inb(0x60);  /* Read from keyboard data port */
+/* An 8259 raises IRQ 7/15 with a clear in-service bit when the line drops
+ * before the CPU acknowledges it. Those get no EOI, except that the master
+ * still needs one for the cascade when the slave was spurious.
+ */
+static bool irq_is_pic_spurious(uint8_t irq) {
+    if (irq != 7 && irq != 15) {
+        return false;
+    }
+    
+    /* Under the I/O APIC the 8259s are masked and vectors 39/47 are real
+     * routed lines; they always need the local APIC EOI, handlers or not
+     */
+    if (ioapic_is_enabled()) {
+        return false;
+    }
     
-    serial_puts("[INPUT] Neural interface scancode: 0x");
-    char hex_chars[] = "0123456789ABCDEF";
-    serial_putc(hex_chars[(scancode >> 4) & 0xF]);
-    serial_putc(hex_chars[scancode & 0xF]);
-    serial_puts("\n");
+    uint16_t port = irq == 7 ? PIC1_COMMAND : PIC2_COMMAND;
+    outb(port, PIC_READ_ISR);
+    if (inb(port) & 0x80) {
+        return false;
+    }
+    
+    if (irq == 15) {
+        outb(PIC1_COMMAND, PIC_EOI);
+    }
+    return true;
 }
 
-/* Serial interrupt handler */
-void handle_serial_irq(void) {
-    serial_puts("[COMM] Serial data transmission complete\n");
+/* Run every handler on a shared line; true if any claimed the interrupt */
+static bool irq_run_chain(uint8_t irq) {
+    bool handled = false;
+    for (irq_action_t *action = irq_chains[irq]; action; action = action->next) {
+        if (action->handler(irq, action->data) == IRQ_HANDLED) {
+            handled = true;
+        }
+    }
+    return handled;
+}
+
+static uint32_t irq_latency_bucket(uint64_t cycles) {
+    uint32_t bucket = 0;
+    cycles >>= IRQ_LATENCY_MIN_SHIFT + 1;
+    while (cycles && bucket < IRQ_LATENCY_BUCKETS - 1) {
+        cycles >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+/* Count one delivery: per-CPU totals, handler time and storm detection */
+static void irq_account(uint8_t vector, uint64_t start, uint64_t end, bool handled) {
+    irq_stats_t *stats = &irq_stats[vector];
+    uint64_t cycles = end - start;
+    
+    struct neural_cpu *cpu = smp_get_current_cpu();
+    uint32_t slot = IRQ_STATS_MAX_CPUS - 1;
+    if (cpu) {
+        cpu->interrupts_handled++;
+        if (cpu->cpu_id < IRQ_STATS_MAX_CPUS) {
+            slot = cpu->cpu_id;
+        }
+    }
+    
+    stats->count++;
+    stats->cpu_count[slot]++;
+    irq_cpu_totals[slot]++;
+    if (!handled) {
+        stats->unhandled++;
+    }
+    
+    stats->total_cycles += cycles;
+    if (cycles > stats->max_cycles) {
+        stats->max_cycles = cycles;
+    }
+    stats->histogram[irq_latency_bucket(cycles)]++;
+    
+    /* One-second windows; report each storm once */
+    uint64_t window = tsc_get_frequency();
+    if (window && end - stats->window_start >= window) {
+        stats->window_start = end;
+        stats->window_count = 0;
+    }
+    if (++stats->window_count == IRQ_STORM_THRESHOLD) {
+        stats->storms++;
+        serial_puts("[NEURAL-IRQ] Interrupt storm on vector ");
+        print_hex(vector);
+        serial_puts("\n");
+    }
 }
 
 /* Main IRQ handler dispatcher */
 void irq_handler(struct registers *regs) {
-    uint8_t irq_num = regs->int_no - 32;  /* Convert to IRQ number */
+    uint8_t vector = (uint8_t)regs->int_no;
     
-    switch (irq_num) {
-        case 0:  /* Timer IRQ */
-            handle_timer_irq();
-            break;
-            
-        case 1:  /* Keyboard IRQ */
-            handle_keyboard_irq();
-            break;
-            
-        case 4:  /* Serial IRQ */
-            handle_serial_irq();
-            break;
-            
-        default:
-            serial_puts("[UNKNOWN] IRQ #");
-            char hex_chars[] = "0123456789ABCDEF";
-            serial_putc(hex_chars[irq_num & 0xF]);
-            serial_puts(" received\n");
-            break;
+    /* Local APIC spurious interrupts must not be EOI'd */
+    if (vector == IRQ_SPURIOUS_VECTOR) {
+        irq_stats[vector].spurious++;
+        return;
+    }
+    
+    uint64_t start = rdtsc();
+    bool handled = false;
+    
+    /* Expose the interrupted context to handlers (restored for nesting) */
+    irq_context_t context = {regs->rip, regs->rsp, regs->rbp, regs->cs};
+    const irq_context_t *previous = irq_current_context;
+    irq_current_context = &context;
+    
+    /* Message-signalled vectors go to the local APIC, never the PIC */
+    if (vector >= IRQ_VECTOR_DYNAMIC_BASE && vector < IRQ_VECTOR_DYNAMIC_END) {
+        if (irq_vectors[vector].handler) {
+            irq_vectors[vector].handler(vector, irq_vectors[vector].data);
+            handled = true;
+        }
+        irq_current_context = previous;
+        irq_account(vector, start, rdtsc(), handled);
+        smp_apic_eoi();
+        return;
+    }
+    
+    uint8_t irq_num = vector - 32;  /* Convert to IRQ number */
+    if (irq_num >= IRQ_LEGACY_COUNT) {
+        irq_current_context = previous;
+        return;
+    }
+    
+    if (irq_is_pic_spurious(irq_num)) {
+        irq_current_context = previous;
+        irq_stats[vector].spurious++;
+        return;
     }
     
+    handled = irq_run_chain(irq_num);
+    irq_current_context = previous;
+    irq_account(vector, start, rdtsc(), handled);
+    
     /* Send End of Interrupt signal */
     send_eoi(irq_num);
-}
\ No newline at end of file
+}
+
+const irq_context_t *irq_get_context(void) {
+    return irq_current_context;
+}
+
+const irq_stats_t *irq_get_stats(uint8_t vector) {
+    return &irq_stats[vector];
+}
+
+uint64_t irq_get_cpu_total(uint8_t cpu_id) {
+    return irq_cpu_totals[cpu_id < IRQ_STATS_MAX_CPUS ? cpu_id : IRQ_STATS_MAX_CPUS - 1];
+}
+
+uint64_t irq_get_spurious_total(void) {
+    uint64_t total = 0;
+    for (int vector = 0; vector < 256; vector++) {
+        total += irq_stats[vector].spurious;
+    }
+    return total;
+}
+
+void irq_reset_stats(void) {
+    memset(irq_stats, 0, sizeof(irq_stats));
+    memset(irq_cpu_totals, 0, sizeof(irq_cpu_totals));
+}
+
+static const char *irq_vector_name(uint8_t vector) {
+    if (vector == IRQ_SPURIOUS_VECTOR) {
+        return "lapic-spurious";
+    }
+    if (vector >= 32 && vector < 32 + IRQ_LEGACY_COUNT) {
+        irq_action_t *action = irq_chains[vector - 32];
+        return action ? action->name : "-";
+    }
+    if (vector >= IRQ_VECTOR_DYNAMIC_BASE && vector < IRQ_VECTOR_DYNAMIC_END) {
+        return "msi";
+    }
+    return "-";
+}
+
+static uint32_t irq_stats_cpu_columns(void) {
+    uint32_t cpus = smp_get_active_cpu_count();
+    if (cpus == 0) {
+        cpus = 1;
+    }
+    return cpus > IRQ_STATS_MAX_CPUS ? IRQ_STATS_MAX_CPUS : cpus;
+}
+
+/* Render the table /dev/interrupts serves; returns its length */
+static size_t irq_stats_format(char *text, size_t size) {
+    uint32_t cpus = irq_stats_cpu_columns();
+    size_t len = 0;
+    
+#define IRQ_STATS_APPEND(...) \
+    do { \
+        if (len < size) { \
+            int n = snprintf(text + len, size - len, __VA_ARGS__); \
+            len += n > 0 ? (size_t)n : 0; \
+        } \
+    } while (0)
+    
+    IRQ_STATS_APPEND(" VEC IRQ");
+    for (uint32_t cpu = 0; cpu < cpus; cpu++) {
+        IRQ_STATS_APPEND("       CPU%u", cpu);
+    }
+    IRQ_STATS_APPEND("  UNHANDLED  SPURIOUS  AVG_US  MAX_US STORMS NAME\n");
+    
+    for (int vector = 32; vector < 256; vector++) {
+        irq_stats_t *stats = &irq_stats[vector];
+        if (!stats->count && !stats->spurious) {
+            continue;
+        }
+        
+        IRQ_STATS_APPEND("%4x", vector);
+        if (vector < 32 + IRQ_LEGACY_COUNT) {
+            IRQ_STATS_APPEND(" %3u", vector - 32);
+        } else {
+            IRQ_STATS_APPEND("   -");
+        }
+        for (uint32_t cpu = 0; cpu < cpus; cpu++) {
+            IRQ_STATS_APPEND(" %10u", (uint32_t)stats->cpu_count[cpu]);
+        }
+        
+        uint64_t avg = stats->count ? stats->total_cycles / stats->count : 0;
+        IRQ_STATS_APPEND(" %10u %9u %7u %7u %6u %s\n",
+                         (uint32_t)stats->unhandled, (uint32_t)stats->spurious,
+                         (uint32_t)tsc_cycles_to_us(avg), (uint32_t)tsc_cycles_to_us(stats->max_cycles),
+                         stats->storms, irq_vector_name(vector));
+    }
+    
+#undef IRQ_STATS_APPEND
+    return len < size ? len : size - 1;
+}
+
+static int64_t irq_stats_read(struct vfs_node *node, void *buffer, uint64_t size, uint64_t offset) {
+    (void)node;
+    
+    size_t len = irq_stats_format(irq_stats_text, sizeof(irq_stats_text));
+    if (offset >= len) {
+        return 0;
+    }
+    
+    uint64_t count = len - offset < size ? len - offset : size;
+    memcpy(buffer, irq_stats_text + offset, count);
+    return (int64_t)count;
+}
+
+static struct file_operations irq_stats_ops = {
+    .read = irq_stats_read,
+};
+
+/* Publish /dev/interrupts for userland diagnostics */
+int irq_stats_device_init(void) {
+    struct vfs_node *node = vfs_create_device(IRQ_STATS_DEVICE_DIR, IRQ_STATS_DEVICE_NAME, &irq_stats_ops, NULL);
+    if (!node) {
+        serial_puts("[NEURAL-IRQ] Failed to create " IRQ_STATS_DEVICE_DIR "/" IRQ_STATS_DEVICE_NAME "\n");
+        return -1;
+    }
+    
+    node->permissions = FS_PERM_READ;
+    return 0;
+}
+
+/* Print per-vector counts, handler latency histograms and spurious totals */
+void irq_print_stats(void) {
+    uint32_t cpus = irq_stats_cpu_columns();
+    
+    serial_puts("[NEURAL-IRQ] === Interrupt Statistics ===\n");
+    for (uint32_t cpu = 0; cpu < cpus; cpu++) {
+        serial_puts("[CPU-");
+        print_dec(cpu);
+        serial_puts("] ");
+        print_dec(irq_cpu_totals[cpu]);
+        serial_puts(" interrupts\n");
+    }
+    
+    for (int vector = 32; vector < 256; vector++) {
+        irq_stats_t *stats = &irq_stats[vector];
+        if (!stats->count) {
+            continue;
+        }
+        
+        serial_puts("[VECTOR ");
+        print_hex(vector);
+        serial_puts("] ");
+        serial_puts(irq_vector_name(vector));
+        serial_puts(": ");
+        print_dec(stats->count);
+        serial_puts(" total, ");
+        print_dec(stats->unhandled);
+        serial_puts(" unhandled, max ");
+        print_dec(tsc_cycles_to_us(stats->max_cycles));
+        serial_puts("us\n");
+        
+        /* Histogram: "<2^n cycles: count" for the populated buckets */
+        serial_puts("  latency");
+        for (int bucket = 0; bucket < IRQ_LATENCY_BUCKETS; bucket++) {
+            if (!stats->histogram[bucket]) {
+                continue;
+            }
+            serial_puts(" <2^");
+            print_dec(bucket == IRQ_LATENCY_BUCKETS - 1 ? 64 : bucket + IRQ_LATENCY_MIN_SHIFT + 1);
+            serial_puts(":");
+            print_dec(stats->histogram[bucket]);
+        }
+        serial_puts("\n");
+        
+        if (stats->storms) {
+            serial_puts("  storms: ");
+            print_dec(stats->storms);
+            serial_puts("\n");
+        }
+    }
+    
+    serial_puts("[NEURAL-IRQ] Spurious: ");
+    print_dec(irq_stats[IRQ_SPURIOUS_VECTOR].spurious);
+    serial_puts(" local APIC, ");
+    print_dec(irq_stats[39].spurious + irq_stats[47].spurious);
+    serial_puts(" 8259\n");
+}
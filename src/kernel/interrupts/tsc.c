@@ -0,0 +1,98 @@
+/* tsc.c - Brandon Media OS Time Stamp Counter Calibration
+ * Measures TSC frequency against PIT channel 2
+ */
+
+#include <stdint.h>
+#include "kernel/tsc.h"
+
+/* PIT channel 2 gate/speaker control */
+#define PIT_CHANNEL2        0x42
+#define PIT_COMMAND         0x43
+#define PIT_GATE_PORT       0x61
+#define PIT_FREQUENCY       1193182
+
+/* Calibration window: 10ms of PIT ticks */
+#define TSC_CALIBRATE_MS    10
+#define TSC_CALIBRATE_TICKS ((PIT_FREQUENCY * TSC_CALIBRATE_MS) / 1000)
+
+/* Fallback when calibration fails (assume 2GHz) */
+#define TSC_DEFAULT_HZ      2000000000ULL
+
+/* I/O port functions */
+static inline void outb(uint16_t port, uint8_t val) {
+    asm volatile ("outb %0, %1" : : "a"(val), "Nd"(port));
+}
+
+static inline uint8_t inb(uint16_t port) {
+    uint8_t ret;
+    asm volatile ("inb %1, %0" : "=a"(ret) : "Nd"(port));
+    return ret;
+}
+
+/* External functions */
+extern void serial_puts(const char *s);
+extern void print_dec(uint64_t num);
+
+static uint64_t tsc_hz = TSC_DEFAULT_HZ;
+static uint64_t tsc_base = 0;
+
+/* Calibrate TSC using PIT channel 2 one-shot countdown */
+void tsc_calibrate(void) {
+    uint8_t gate = inb(PIT_GATE_PORT);
+
+    /* Disable speaker, enable channel 2 gate */
+    outb(PIT_GATE_PORT, (gate & ~0x02) | 0x01);
+
+    /* Channel 2, low/high byte, mode 0 (interrupt on terminal count) */
+    outb(PIT_COMMAND, 0xB0);
+    outb(PIT_CHANNEL2, TSC_CALIBRATE_TICKS & 0xFF);
+    outb(PIT_CHANNEL2, (TSC_CALIBRATE_TICKS >> 8) & 0xFF);
+
+    /* Restart the count by toggling the gate */
+    gate = inb(PIT_GATE_PORT);
+    outb(PIT_GATE_PORT, gate & ~0x01);
+    outb(PIT_GATE_PORT, gate | 0x01);
+
+    uint64_t start = rdtsc();
+    uint32_t spins = 0;
+
+    /* OUT2 (bit 5) goes high when the count expires */
+    while (!(inb(PIT_GATE_PORT) & 0x20)) {
+        if (++spins > 100000000) break;
+    }
+
+    uint64_t end = rdtsc();
+    outb(PIT_GATE_PORT, gate & ~0x01);
+
+    if (end > start && spins <= 100000000) {
+        tsc_hz = (end - start) * (1000 / TSC_CALIBRATE_MS);
+    } else {
+        serial_puts("[TSC] Calibration failed - using default frequency\n");
+    }
+
+    tsc_base = rdtsc();
+
+    serial_puts("[TSC] Neural chronometer calibrated at ");
+    print_dec(tsc_hz / 1000000);
+    serial_puts(" MHz\n");
+}
+
+/* Get TSC frequency in Hz */
+uint64_t tsc_get_frequency(void) {
+    return tsc_hz;
+}
+
+/* Convert TSC cycles to microseconds */
+uint64_t tsc_cycles_to_us(uint64_t cycles) {
+    return (cycles * 1000) / (tsc_hz / 1000);
+}
+
+/* Convert TSC cycles to nanoseconds */
+uint64_t tsc_cycles_to_ns(uint64_t cycles) {
+    return (cycles * 1000) / (tsc_hz / 1000000);
+}
+
+/* Microseconds elapsed since calibration */
+uint64_t tsc_get_us(void) {
+    return tsc_cycles_to_us(rdtsc() - tsc_base);
+}
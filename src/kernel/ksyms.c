@@ -0,0 +1,78 @@
+/* ksyms.c - Brandon Media OS Kernel Symbol Table
+ * Function Names Embedded at Link Time for Symbolizing Addresses
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "kernel/ksyms.h"
+
+/* Linker script (config/link.ld): kernel text and the generated table.
+ * The .ksyms section holds a symbol count followed by the entries; it is
+ * empty in the first link pass.
+ */
+extern char __text_start[];
+extern char __text_end[];
+extern char __ksyms_start[];
+extern char __ksyms_end[];
+
+typedef struct {
+    uint64_t count;
+    ksym_t symbols[];
+} ksym_table_t;
+
+static const ksym_table_t *ksyms_table(void) {
+    if ((size_t)(__ksyms_end - __ksyms_start) < sizeof(ksym_table_t)) {
+        return NULL;
+    }
+    return (const ksym_table_t *)__ksyms_start;
+}
+
+uint64_t ksyms_count(void) {
+    const ksym_table_t *table = ksyms_table();
+    return table ? table->count : 0;
+}
+
+const ksym_t *ksyms_get(uint64_t index) {
+    const ksym_table_t *table = ksyms_table();
+    return table && index < table->count ? &table->symbols[index] : NULL;
+}
+
+bool ksyms_is_kernel_text(uint64_t address) {
+    return address >= (uint64_t)__text_start && address < (uint64_t)__text_end;
+}
+
+/* Index of the function containing `address`, or -1 */
+int64_t ksyms_lookup_index(uint64_t address) {
+    const ksym_table_t *table = ksyms_table();
+    if (!table || table->count == 0 || !ksyms_is_kernel_text(address) ||
+        address < table->symbols[0].address) {
+        return -1;
+    }
+    
+    /* Last symbol at or below the address */
+    uint64_t low = 0;
+    uint64_t high = table->count - 1;
+    while (low < high) {
+        uint64_t mid = (low + high + 1) / 2;
+        if (table->symbols[mid].address <= address) {
+            low = mid;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return (int64_t)low;
+}
+
+const char *ksyms_lookup(uint64_t address, uint64_t *offset) {
+    int64_t index = ksyms_lookup_index(address);
+    if (index < 0) {
+        return NULL;
+    }
+    
+    const ksym_t *symbol = ksyms_get((uint64_t)index);
+    if (offset) {
+        *offset = address - symbol->address;
+    }
+    return symbol->name;
+}
@@ -10,25 +10,25 @@
 #include "kernel/virtio_net.h"
 #include "kernel/framebuffer.h"
 #include "kernel/gui.h"
+#include "kernel/gui_pipeline.h"
+#include "kernel/quality.h"
 #include "kernel/input.h"
 #include "kernel/graphics_3d.h"
 #include "kernel/device_test.h"
 #include "kernel/smp.h"
 #include "kernel/advanced_scheduler.h"
 #include "kernel/security.h"
+#include "kernel/boot_profile.h"
 #include "kernel/uefi_boot.h"
 #include "kernel/uefi_manager.h"
+#include "kernel/tsc.h"
+#include "kernel/perf.h"
+#include "kernel/render_bench.h"
+#include "kernel/initcall.h"
+#include "kernel/uart.h"
+#include "kernel/profiler.h"
 
 #define VGA_BUF ((volatile uint16_t*)0xB8000)
-#define COM1 0x3F8
-
-static inline void outb(uint16_t port, uint8_t val) {
-    asm volatile ("outb %0, %1" : : "a"(val), "Nd"(port));
-}
-
-static void serial_putc(char c) {
-    outb(COM1, (uint8_t)c);
-}
 
 static void vga_puts(const char *s) {
     volatile uint16_t *v = VGA_BUF;
@@ -38,14 +38,12 @@ static void vga_puts(const char *s) {
     }
 }
 
-static void serial_puts(const char *s) {
-    for (int i = 0; s[i]; ++i) serial_putc(s[i]);
-}
-
 /* External interrupt system functions */
 extern void idt_init(void);
 extern void pic_init(void);
 extern void timer_init(uint32_t frequency);
+extern int irq_stats_device_init(void);
+extern void irq_print_stats(void);
 extern void interrupts_enable(void);
 extern void interrupts_disable(void);
 
@@ -122,97 +120,99 @@ extern int64_t vfs_write(int fd, const void *buffer, size_t count);
 extern int64_t vfs_read(int fd, void *buffer, size_t count);
 extern int vfs_stat(const char *path, struct file_stat *stat);
 
-void kmain(void) {
-    /* Brandon Media OS - Cyberpunk boot sequence */
-    const char *boot_msg = "[NEXUS] Brandon Media OS v0.1 - Neural interface online";
-    vga_puts(boot_msg);
-    serial_puts(boot_msg);
-    serial_putc('\n');
-    
-    /* Initialize memory management */
-    serial_puts("[MATRIX] Initializing memory management nexus...\n");
-    
-    /* Create basic memory map (simplified for now) */
-    struct memory_region memory_map[] = {
-        {0x0000000, 0x9FC00, 1, 0},           /* Conventional memory 0-639KB */
-        {0x100000, 0x7F00000, 1, 0},         /* Extended memory 1MB-127MB */
-    };
-    
-    pmm_init(memory_map, 2);              /* Initialize physical memory */
-    paging_init();                        /* Initialize paging */
-    paging_enable();                      /* Enable virtual memory */
-    vmm_init();                          /* Initialize virtual memory manager */
-    heap_init();                         /* Initialize kernel heap */
-    
-    /* Initialize process management */
-    serial_puts("[NEXUS] Initializing neural process matrix...\n");
-    process_init();                      /* Initialize process management */
-    scheduler_init();                    /* Initialize scheduler */
-    
-    /* Initialize system calls */
-    serial_puts("[NEXUS] Initializing neural interface gateway...\n");
-    syscalls_init();                     /* Initialize system call interface */
-    user_mode_init();                    /* Initialize user mode support */
-    
-    /* Initialize file system */
-    serial_puts("[MATRIX] Initializing neural file system...\n");
-    vfs_init();                          /* Initialize Virtual File System */
-    file_ops_init();                     /* Initialize file operations */
-    storage_init();                      /* Initialize storage devices */
-    ramfs_init();                        /* Initialize RAM filesystem */
-    
-    /* Initialize device drivers */
-    serial_puts("[NEXUS] Initializing neural device matrix...\n");
-    hal_init();                          /* Initialize Hardware Abstraction Layer */
-    virtio_net_init();                   /* Initialize VirtIO network driver */
-    framebuffer_init();                  /* Initialize graphics driver */
-    hal_initialize_all_devices();        /* Initialize all discovered devices */
-    
-    /* Initialize advanced features (Phase 8) */
-    serial_puts("[NEXUS] Activating advanced neural systems...\n");
-    uefi_manager_init();                 /* Initialize UEFI boot manager */
-    smp_init();                          /* Initialize SMP (multi-core support) */
-    advanced_scheduler_init();           /* Initialize advanced scheduling */
-    security_init();                     /* Initialize security framework */
-    
-    /* Create storage device for testing */
-    struct storage_device *ram_storage = storage_create_ram_device("neural_ram", 1024 * 1024);  /* 1MB */
-    if (ram_storage) {
-        storage_register_device(ram_storage);
-        serial_puts("[SUCCESS] Neural RAM storage device created\n");
+/* External GUI functions */
+extern int compositor_init(void);
+extern int accessibility_init(void);
+
+/* Conventional and extended memory (simplified for now) */
+static struct memory_region memory_map[] = {
+    {0x0000000, 0x9FC00, 1, 0, NULL},     /* Conventional memory 0-639KB */
+    {0x100000, 0x7F00000, 1, 0, NULL},   /* Extended memory 1MB-127MB */
+};
+
+/* Adapt a void init function to the initcall signature */
+#define INITCALL_WRAP(fn)                               \
+    static int fn##_initcall(void) {                    \
+        fn();                                           \
+        return 0;                                       \
     }
-    
-    /* Initialize interrupt system */
+
+INITCALL_WRAP(heap_init)
+INITCALL_WRAP(vmm_init)
+INITCALL_WRAP(process_init)
+INITCALL_WRAP(scheduler_init)
+INITCALL_WRAP(syscalls_init)
+INITCALL_WRAP(user_mode_init)
+INITCALL_WRAP(vfs_init)
+INITCALL_WRAP(file_ops_init)
+INITCALL_WRAP(storage_init)
+INITCALL_WRAP(tsc_calibrate)
+INITCALL_WRAP(hal_init)
+INITCALL_WRAP(virtio_net_init)
+INITCALL_WRAP(hal_initialize_all_devices)
+INITCALL_WRAP(uefi_manager_init)
+INITCALL_WRAP(smp_init)
+INITCALL_WRAP(advanced_scheduler_init)
+INITCALL_WRAP(security_init)
+
+static int pmm_initcall(void) {
+    serial_puts("[MATRIX] Initializing memory management nexus...\n");
+    pmm_init(memory_map, sizeof(memory_map) / sizeof(memory_map[0]));
+    return 0;
+}
+
+static int paging_initcall(void) {
+    paging_init();
+    paging_enable();
+    return 0;
+}
+
+/* Headless when built that way or when PCI has no display controller */
+static int display_detect_initcall(void) {
+#ifdef KERNEL_HEADLESS
+    initcall_set_headless(true);
+#else
+    initcall_set_headless(pci_find_device_by_class(PCI_CLASS_DISPLAY, PCI_SUBCLASS_VGA) == NULL);
+#endif
+    return 0;
+}
+
+static int interrupts_initcall(void) {
     serial_puts("[MATRIX] Initializing interrupt handlers...\n");
     interrupts_disable();  /* Disable interrupts during setup */
-    idt_init();           /* Initialize IDT */
-    pic_init();           /* Initialize PIC */
-    timer_init(100);      /* 100Hz timer frequency */
+    idt_init();
+    pic_init();
+    timer_init(100);       /* 100Hz timer frequency */
+    irq_stats_device_init();
     
     serial_puts("[SYSTEM] Enabling quantum processing matrix...\n");
-    interrupts_enable();  /* Enable interrupts */
-    
-    /* Display memory statistics */
-    struct memory_stats *stats = memory_get_stats();
-    serial_puts("[NEXUS] Memory matrix status:\n");
-    serial_puts("[STATS] Physical pages allocated: ");
-    print_dec(stats->pages_allocated);
-    serial_puts("\n");
-    
-    /* Test memory allocation */
-    serial_puts("[TEST] Testing memory allocation matrix...\n");
-    void *test_ptr = kmalloc(1024);
-    if (test_ptr) {
-        serial_puts("[SUCCESS] 1KB allocation successful at: ");
-        print_hex((uint64_t)test_ptr);
-        serial_puts("\n");
-        kfree(test_ptr);
-        serial_puts("[SUCCESS] Memory deallocation completed\n");
-    } else {
-        serial_puts("[ERROR] Memory allocation test failed\n");
+    interrupts_enable();
+    return 0;
+}
+
+/* Serial console output moves from polling to the transmit-empty interrupt */
+static int uart_initcall(void) {
+    return uart_init(UART_BAUD);
+}
+
+/* First ring 3 process; late initcalls wait until it has been scheduled */
+static int userland_initcall(void) {
+    serial_puts("[TEST] Testing neural interface gateway...\n");
+    test_user_mode();
+    return 0;
+}
+
+static int ram_storage_initcall(void) {
+    struct storage_device *ram_storage = storage_create_ram_device("neural_ram", 1024 * 1024);  /* 1MB */
+    if (!ram_storage) {
+        return -1;
     }
-    
-    /* Test process creation */
+    storage_register_device(ram_storage);
+    serial_puts("[SUCCESS] Neural RAM storage device created\n");
+    return 0;
+}
+
+static int demo_processes_initcall(void) {
     serial_puts("[TEST] Testing neural process spawning...\n");
     struct process *proc1 = process_create("test_proc_1", test_process_1, PRIORITY_NORMAL);
     struct process *proc2 = process_create("test_proc_2", test_process_2, PRIORITY_LOW);
@@ -226,59 +226,159 @@ void kmain(void) {
         serial_puts("[SUCCESS] Process 2 spawned successfully\n");
         scheduler_add_process(proc2);
     }
+    return 0;
+}
+
+static int input_initcall(void) {
+    if (input_init() != 0) {
+        return -1;
+    }
+    serial_puts("[SUCCESS] Neural Input System initialized\n");
+    return 0;
+}
+
+static int gui_initcall(void) {
+    serial_puts("[NEXUS] Initializing Neural GUI Interface...\n");
+    if (gui_init() != 0) {
+        serial_puts("[ERROR] Failed to initialize Neural GUI System\n");
+        return -1;
+    }
+    serial_puts("[SUCCESS] Neural GUI System initialized\n");
+    return 0;
+}
+
+static int accessibility_initcall(void) {
+    if (accessibility_init() != 0) {
+        return -1;
+    }
+    serial_puts("[SUCCESS] Neural Accessibility System initialized\n");
+    return 0;
+}
+
+static int scada_demo_initcall(void) {
+    extern void gui_test(void);
+    extern void scada_demo_init(void);
+    gui_test();
+    scada_demo_init();
+    return 0;
+}
+
+static int gui_pipeline_initcall(void) {
+    if (gui_pipeline_init() != 0) {
+        return -1;
+    }
+    serial_puts("[SUCCESS] Neural GUI pipeline online\n");
+    return 0;
+}
+
+/* Frame statistics are not graphics-only; without a display they go to serial */
+static int perf_initcall(void) {
+    if (perf_init() != 0) {
+        return -1;
+    }
+    perf_set_headless(initcall_is_headless() || !framebuffer_get_device());
+    return 0;
+}
+
+/* Hold the frame budget by trading detail on slow machines */
+static int quality_initcall(void) {
+    return quality_governor_init(PERF_FRAME_BUDGET_US);
+}
+
+static int graphics_3d_initcall(void) {
+    framebuffer_device_t *fb_dev = framebuffer_get_device();
+    if (!fb_dev || graphics_3d_init(fb_dev->width, fb_dev->height, fb_dev->framebuffer) != 0) {
+        return -1;
+    }
+    serial_puts("[SUCCESS] Neural 3D Graphics Engine initialized\n");
+    return 0;
+}
+
+static int graphics_3d_test_initcall(void) {
+    extern void graphics_3d_test(void);
+    graphics_3d_test();
+    return 0;
+}
+
+/* Replays the benchmark scenes off-screen, results on serial */
+static int render_bench_initcall(void) {
+    return render_bench_run_all(RENDER_BENCH_DEFAULT_FRAMES, false) < 0 ? -1 : 0;
+}
+
+/* Opt-in with -DKERNEL_RENDER_BENCH; it brings up GUI state even when headless */
+static int boot_bench_initcall(void) {
+#ifdef KERNEL_RENDER_BENCH
+    return initcall_require("render_bench");
+#else
+    return 0;
+#endif
+}
+
+static int memory_selftest_initcall(void) {
+    struct memory_stats *stats = memory_get_stats();
+    serial_puts("[NEXUS] Memory matrix status:\n");
+    serial_puts("[STATS] Physical pages allocated: ");
+    print_dec(stats->pages_allocated);
+    serial_puts("\n");
     
-    /* Test system calls and user mode */
-    serial_puts("[TEST] Testing neural interface gateway...\n");
-    test_user_mode();
-    
-    /* Test file system */
+    serial_puts("[TEST] Testing memory allocation matrix...\n");
+    void *test_ptr = kmalloc(1024);
+    if (!test_ptr) {
+        serial_puts("[ERROR] Memory allocation test failed\n");
+        return -1;
+    }
+    serial_puts("[SUCCESS] 1KB allocation successful at: ");
+    print_hex((uint64_t)test_ptr);
+    serial_puts("\n");
+    kfree(test_ptr);
+    serial_puts("[SUCCESS] Memory deallocation completed\n");
+    return 0;
+}
+
+static int fs_selftest_initcall(void) {
     serial_puts("[TEST] Testing neural file system...\n");
-    
-    /* Print storage devices */
     storage_print_devices();
     
-    /* Create test directory */
-    if (vfs_mkdir("/neural", 0755) == 0) {
-        serial_puts("[SUCCESS] Created /neural directory\n");
-        
-        /* Create test file */
-        if (vfs_create_file("/neural/test.dat", 0644) == 0) {
-            serial_puts("[SUCCESS] Created /neural/test.dat file\n");
-            
-            /* Test file operations */
-            int fd = vfs_open("/neural/test.dat", 3, 0);  /* Read+Write */
-            if (fd >= 0) {
-                const char *test_data = "Brandon Media OS Neural File System Test Data\n";
-                int64_t written = vfs_write(fd, test_data, 46);
-                serial_puts("[TEST] Wrote ");
-                print_dec(written);
-                serial_puts(" bytes to neural file\n");
-                
-                /* Test read operation */
-                vfs_seek(fd, 0, 0);  /* Seek to beginning */
-                char read_buffer[64];
-                int64_t read_bytes = vfs_read(fd, read_buffer, 46);
-                serial_puts("[TEST] Read ");
-                print_dec(read_bytes);
-                serial_puts(" bytes from neural file\n");
-                
-                vfs_close(fd);
-                serial_puts("[SUCCESS] Neural file operations test completed\n");
-            } else {
-                serial_puts("[ERROR] Failed to open neural file\n");
-            }
-        } else {
-            serial_puts("[ERROR] Failed to create neural file\n");
-        }
-    } else {
+    if (vfs_mkdir("/neural", 0755) != 0) {
         serial_puts("[ERROR] Failed to create neural directory\n");
+        return -1;
     }
+    serial_puts("[SUCCESS] Created /neural directory\n");
     
-    /* Test device drivers */
+    if (vfs_create_file("/neural/test.dat", 0644) != 0) {
+        serial_puts("[ERROR] Failed to create neural file\n");
+        return -1;
+    }
+    serial_puts("[SUCCESS] Created /neural/test.dat file\n");
+    
+    int fd = vfs_open("/neural/test.dat", 3, 0);  /* Read+Write */
+    if (fd < 0) {
+        serial_puts("[ERROR] Failed to open neural file\n");
+        return -1;
+    }
+    
+    const char *test_data = "Brandon Media OS Neural File System Test Data\n";
+    int64_t written = vfs_write(fd, test_data, 46);
+    serial_puts("[TEST] Wrote ");
+    print_dec(written);
+    serial_puts(" bytes to neural file\n");
+    
+    vfs_seek(fd, 0, 0);  /* Seek to beginning */
+    char read_buffer[64];
+    int64_t read_bytes = vfs_read(fd, read_buffer, 46);
+    serial_puts("[TEST] Read ");
+    print_dec(read_bytes);
+    serial_puts(" bytes from neural file\n");
+    
+    vfs_close(fd);
+    serial_puts("[SUCCESS] Neural file operations test completed\n");
+    return 0;
+}
+
+static int device_selftest_initcall(void) {
     serial_puts("[TEST] Testing neural device matrix...\n");
     hal_print_all_devices();
     
-    /* Find and test network devices */
     struct hal_device *network_devices[8];
     int network_count = hal_find_devices_by_type(DEVICE_TYPE_NETWORK, network_devices, 8);
     if (network_count > 0) {
@@ -288,66 +388,26 @@ void kmain(void) {
         for (int i = 0; i < network_count; i++) {
             hal_print_device_info(network_devices[i]);
         }
-    } else {
-        serial_puts("[INFO] No neural network interfaces detected\n");
-    }
-    
-    /* Test graphics interface */
-    serial_puts("[TEST] Testing neural display interface...\n");
-    fb_print_info();
-    fb_test_graphics();
-    
-    /* Initialize Neural GUI System */
-    serial_puts("[NEXUS] Initializing Neural GUI Interface...\n");
-    if (gui_init() == 0) {
-        serial_puts("[SUCCESS] Neural GUI System initialized\n");
         
-        /* Initialize input system */
-        if (input_init() == 0) {
-            serial_puts("[SUCCESS] Neural Input System initialized\n");
-            
-            /* Initialize accessibility system */
-            extern int accessibility_init(void);
-            if (accessibility_init() == 0) {
-                serial_puts("[SUCCESS] Neural Accessibility System initialized\n");
-            }
-        }
-        
-        /* Initialize 3D graphics */
-        framebuffer_device_t *fb_dev = framebuffer_get_device();
-        if (fb_dev && graphics_3d_init(fb_dev->width, fb_dev->height, fb_dev->framebuffer) == 0) {
-            serial_puts("[SUCCESS] Neural 3D Graphics Engine initialized\n");
-            
-            /* Test 3D graphics */
-            extern void graphics_3d_test(void);
-            graphics_3d_test();
-        }
-        
-        /* Test GUI system */
-        extern void gui_test(void);
-        gui_test();
-        
-        /* Create SCADA demo interface */
-        extern void scada_demo_init(void);
-        scada_demo_init();
-    } else {
-        serial_puts("[ERROR] Failed to initialize Neural GUI System\n");
-    }
-    
-    /* Test network interface */
-    if (network_count > 0) {
         serial_puts("[TEST] Testing neural network interface...\n");
         virtio_net_print_stats();
+    } else {
+        serial_puts("[INFO] No neural network interfaces detected\n");
     }
     
-    /* Run comprehensive device driver tests */
     serial_puts("[TEST] Running comprehensive device driver test suite...\n");
     run_device_driver_tests();
-    
-    /* Test advanced features (Phase 8) */
-    serial_puts("[TEST] Testing advanced neural systems...\n");
-    
-    /* Test UEFI boot manager */
+    return 0;
+}
+
+static int display_selftest_initcall(void) {
+    serial_puts("[TEST] Testing neural display interface...\n");
+    fb_print_info();
+    fb_test_graphics();
+    return 0;
+}
+
+static int uefi_selftest_initcall(void) {
     serial_puts("[TEST] Testing UEFI neural boot interface...\n");
     uefi_manager_run_tests();
     if (uefi_manager_is_uefi_boot()) {
@@ -355,6 +415,11 @@ void kmain(void) {
     } else {
         serial_puts("[INFO] Legacy BIOS boot mode detected\n");
     }
+    return 0;
+}
+
+static int system_selftest_initcall(void) {
+    serial_puts("[TEST] Testing advanced neural systems...\n");
     
     /* Test SMP and neural matrix */
     if (smp_is_available()) {
@@ -374,6 +439,10 @@ void kmain(void) {
         serial_puts("[INFO] Single-core neural processing mode\n");
     }
     
+    /* Interrupt counts and handler latency so far */
+    irq_print_stats();
+    uart_print_stats();
+    
     /* Test advanced scheduling */
     if (sched_is_advanced_initialized()) {
         serial_puts("[TEST] Testing advanced neural scheduling...\n");
@@ -389,47 +458,118 @@ void kmain(void) {
         security_test_features();
         serial_puts("[SUCCESS] Neural protection systems operational\n");
     }
-    
-    /* Test enhanced userland framework */
+    return 0;
+}
+
+static int app_framework_selftest_initcall(void) {
     serial_puts("[TEST] Testing neural application framework...\n");
     extern void neural_app_framework_test(void);
     neural_app_framework_test();
     serial_puts("[SUCCESS] Neural application framework operational\n");
+    return 0;
+}
+
+/* Kernel bring-up. Core through user levels run before the main loop; late
+ * calls wait for the first userland process. Lazy calls only start through
+ * initcall_require(). Graphics calls never start when headless.
+ */
+static const initcall_t kernel_initcalls[] = {
+    /* name                 function                          level                  flags */
+    {"pmm",                 pmm_initcall,                     INITCALL_LEVEL_CORE,   0, {NULL}},
+    {"paging",              paging_initcall,                  INITCALL_LEVEL_CORE,   0, {"pmm"}},
+    {"vmm",                 vmm_init_initcall,                INITCALL_LEVEL_CORE,   0, {"paging"}},
+    {"heap",                heap_init_initcall,               INITCALL_LEVEL_CORE,   0, {"vmm"}},
+    
+    {"process",             process_init_initcall,            INITCALL_LEVEL_SUBSYS, 0, {"heap"}},
+    {"scheduler",           scheduler_init_initcall,          INITCALL_LEVEL_SUBSYS, 0, {"process"}},
+    {"syscalls",            syscalls_init_initcall,           INITCALL_LEVEL_SUBSYS, 0, {"heap"}},
+    {"user_mode",           user_mode_init_initcall,          INITCALL_LEVEL_SUBSYS, 0, {"syscalls", "process"}},
+    {"vfs",                 vfs_init_initcall,                INITCALL_LEVEL_SUBSYS, 0, {"heap"}},
+    {"file_ops",            file_ops_init_initcall,           INITCALL_LEVEL_SUBSYS, 0, {"vfs"}},
+    {"storage",             storage_init_initcall,            INITCALL_LEVEL_SUBSYS, 0, {"heap"}},
+    {"ramfs",               ramfs_init,                       INITCALL_LEVEL_SUBSYS, 0, {"vfs", "storage"}},
+    
+    {"tsc",                 tsc_calibrate_initcall,           INITCALL_LEVEL_DEVICE, 0, {NULL}},
+    {"hal",                 hal_init_initcall,                INITCALL_LEVEL_DEVICE, 0, {"heap", "tsc"}},
+    {"display_detect",      display_detect_initcall,          INITCALL_LEVEL_DEVICE, 0, {"hal"}},
+    {"virtio_net",          virtio_net_init_initcall,         INITCALL_LEVEL_DEVICE, 0, {"hal"}},
+    {"framebuffer",         framebuffer_init,                 INITCALL_LEVEL_DEVICE, INITCALL_GRAPHICS, {"display_detect"}},
+    {"devices",             hal_initialize_all_devices_initcall, INITCALL_LEVEL_DEVICE, 0, {"virtio_net", "smp", "?framebuffer"}},
+    {"smp",                 smp_init_initcall,                INITCALL_LEVEL_DEVICE, 0, {"heap"}},
+    {"advanced_scheduler",  advanced_scheduler_init_initcall, INITCALL_LEVEL_DEVICE, 0, {"scheduler", "smp"}},
+    {"security",            security_init_initcall,           INITCALL_LEVEL_DEVICE, 0, {"process"}},
+    {"interrupts",          interrupts_initcall,              INITCALL_LEVEL_DEVICE, 0, {"scheduler", "vfs", "smp", "?devices"}},
+    {"uart",                uart_initcall,                    INITCALL_LEVEL_DEVICE, 0, {"interrupts"}},
+    {"profiler",            profiler_init,                    INITCALL_LEVEL_DEVICE, 0, {"interrupts", "vfs"}},
+    
+    {"userland",            userland_initcall,                INITCALL_LEVEL_USER,   0, {"user_mode", "scheduler", "interrupts"}},
+    
+    {"uefi_manager",        uefi_manager_init_initcall,       INITCALL_LEVEL_LATE,   0, {"heap"}},
+    {"ram_storage",         ram_storage_initcall,             INITCALL_LEVEL_LATE,   0, {"storage"}},
+    {"demo_processes",      demo_processes_initcall,          INITCALL_LEVEL_LATE,   0, {"scheduler"}},
+    {"input",               input_initcall,                   INITCALL_LEVEL_LATE,   0, {"interrupts"}},
+    {"gui",                 gui_initcall,                     INITCALL_LEVEL_LATE,   INITCALL_GRAPHICS, {"framebuffer"}},
+    {"compositor",          compositor_init,                  INITCALL_LEVEL_LATE,   INITCALL_GRAPHICS, {"gui"}},
+    {"perf",                perf_initcall,                    INITCALL_LEVEL_LATE,   0, {"input", "?framebuffer"}},
+    {"accessibility",       accessibility_initcall,           INITCALL_LEVEL_LATE,   INITCALL_GRAPHICS, {"gui", "input"}},
+    {"scada_demo",          scada_demo_initcall,              INITCALL_LEVEL_LATE,   INITCALL_GRAPHICS, {"gui"}},
+    {"gui_pipeline",        gui_pipeline_initcall,            INITCALL_LEVEL_LATE,   INITCALL_GRAPHICS, {"gui", "?perf", "?scada_demo"}},
+    {"quality",             quality_initcall,                 INITCALL_LEVEL_LATE,   INITCALL_GRAPHICS, {"gui_pipeline"}},
+    {"graphics_3d",         graphics_3d_initcall,             INITCALL_LEVEL_LATE,   INITCALL_LAZY | INITCALL_GRAPHICS, {"framebuffer"}},
+    {"graphics_3d_test",    graphics_3d_test_initcall,        INITCALL_LEVEL_LATE,   INITCALL_GRAPHICS, {"graphics_3d"}},
+    {"render_bench",        render_bench_initcall,            INITCALL_LEVEL_LATE,   INITCALL_LAZY, {"heap", "tsc"}},
+    {"boot_bench",          boot_bench_initcall,              INITCALL_LEVEL_LATE,   0, {NULL}},
+    
+    {"memory_selftest",     memory_selftest_initcall,         INITCALL_LEVEL_LATE,   0, {"heap"}},
+    {"fs_selftest",         fs_selftest_initcall,             INITCALL_LEVEL_LATE,   0, {"file_ops", "ramfs", "?ram_storage"}},
+    {"device_selftest",     device_selftest_initcall,         INITCALL_LEVEL_LATE,   0, {"devices"}},
+    {"display_selftest",    display_selftest_initcall,        INITCALL_LEVEL_LATE,   INITCALL_GRAPHICS, {"framebuffer", "?scada_demo"}},
+    {"uefi_selftest",       uefi_selftest_initcall,           INITCALL_LEVEL_LATE,   0, {"uefi_manager"}},
+    {"system_selftest",     system_selftest_initcall,         INITCALL_LEVEL_LATE,   0, {"advanced_scheduler", "security", "interrupts"}},
+    {"app_framework_selftest", app_framework_selftest_initcall, INITCALL_LEVEL_LATE, 0, {"userland"}},
+};
+
+void kmain(void) {
+    boot_profile_start();
     
-    serial_puts("[NEXUS] Brandon Media OS fully operational - Cyberpunk mode active\n");
+    /* Brandon Media OS - Cyberpunk boot sequence */
+    const char *boot_msg = "[NEXUS] Brandon Media OS v0.1 - Neural interface online";
+    vga_puts(boot_msg);
+    serial_puts(boot_msg);
+    serial_putc('\n');
+    
+    initcall_register(kernel_initcalls, sizeof(kernel_initcalls) / sizeof(kernel_initcalls[0]));
+    
+    /* Everything needed to run the first userland process */
+    for (int level = INITCALL_LEVEL_CORE; level <= INITCALL_LEVEL_USER; level++) {
+        initcall_run_level((initcall_level_t)level);
+    }
+    
+    serial_puts("[NEXUS] Brandon Media OS core operational - Cyberpunk mode active\n");
     serial_puts("[STATUS] Press any key to test neural interface\n");
     
     /* Main kernel loop with cyberpunk aesthetics and GUI updates */
     uint64_t loop_count = 0;
-    uint32_t last_gui_update = get_time_ms();
     
     for (;;) {
-        uint32_t current_time = get_time_ms();
-        uint32_t delta_ms = current_time - last_gui_update;
+        /* Non-critical subsystems, once userland is running */
+        if (initcall_poll_deferred()) {
+            /* Where boot time went, on serial and as a trace file */
+            boot_profile_finish();
+            boot_profile_report();
+            boot_profile_write_trace(BOOT_PROFILE_TRACE_PATH);
+            initcall_print_status();
+            serial_puts("[NEXUS] Brandon Media OS fully operational\n");
+        }
         
-        /* Update GUI system at 60fps */
-        if (delta_ms >= 16) { /* ~60fps */
-            /* Update input system */
-            extern void input_update(void);
+        /* Input and simulation step at a fixed rate; rendering draws the
+         * newest published snapshot at ~60fps
+         */
+        if (gui_pipeline_is_initialized()) {
+            gui_pipeline_poll();
+        } else {
+            /* Headless: still drain device rings out to /dev/input readers */
             input_update();
-            
-            /* Update GUI system */
-            extern void gui_update(uint32_t delta_ms);
-            gui_update(delta_ms);
-            
-            /* Update SCADA demo */
-            extern void scada_demo_update(void);
-            scada_demo_update();
-            
-            /* Render GUI */
-            extern void gui_render(void);
-            gui_render();
-            
-            /* Swap framebuffer if double buffering is enabled */
-            extern void fb_swap_buffers(void);
-            fb_swap_buffers();
-            
-            last_gui_update = current_time;
         }
         
         asm volatile("hlt");  /* Wait for interrupts */
@@ -439,4 +579,4 @@ void kmain(void) {
             serial_puts("[HEARTBEAT] Neural System Matrix Stable - All systems nominal\n");
         }
     }
-}
\ No newline at end of file
+}
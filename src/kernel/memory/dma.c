@@ -0,0 +1,366 @@
+/* dma.c - Brandon Media OS DMA Mapping
+ * Translates Kernel Buffers to Bus Addresses, Bouncing What Devices Can't Reach
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "kernel/dma.h"
+#include "kernel/memory.h"
+
+/* Mapping flags for coherent and bounce memory (x86 DMA snoops the cache) */
+#define DMA_KERNEL_FLAGS    (PAGE_PRESENT | PAGE_WRITABLE | PAGE_NO_EXECUTE)
+
+/* External functions */
+extern void serial_puts(const char *s);
+extern void print_hex(uint64_t num);
+extern uint64_t get_cr3(void);
+
+/* Live bounce buffer standing in for a caller's buffer */
+typedef struct {
+    dma_addr_t dma_addr;
+    void *bounce;
+    void *original;
+    size_t size;
+    size_t pages;
+} dma_bounce_t;
+
+static dma_bounce_t dma_bounces[DMA_MAX_BOUNCES];
+static dma_stats_t dma_stats;
+
+/* Physical address behind a kernel virtual address, 0 if unmapped */
+static uint64_t dma_virt_to_phys(const void *cpu_addr) {
+    uint64_t virt = (uint64_t)cpu_addr;
+    if (virt < KERNEL_PHYSICAL_END) {
+        return virt;
+    }
+    
+    pml4_t *pml4 = (pml4_t *)(get_cr3() & ~(uint64_t)PAGE_MASK);
+    return paging_get_physical_address(pml4, virt);
+}
+
+/* Bus address for a buffer if it is physically contiguous, else 0 */
+static uint64_t dma_contiguous_phys(const void *cpu_addr, size_t size) {
+    uint64_t phys = dma_virt_to_phys(cpu_addr);
+    if (!phys) {
+        return 0;
+    }
+    
+    uint64_t virt = (uint64_t)cpu_addr;
+    for (uint64_t page = PAGE_ALIGN_DOWN(virt) + PAGE_SIZE; page < virt + size; page += PAGE_SIZE) {
+        if (dma_virt_to_phys((const void *)page) != phys + (page - virt)) {
+            return 0;
+        }
+    }
+    return phys;
+}
+
+static bool dma_reachable(struct pci_device *dev, uint64_t phys, size_t size) {
+    return phys + size - 1 <= dma_get_mask(dev);
+}
+
+int dma_set_mask(struct pci_device *dev, uint64_t mask) {
+    if (!dev || mask < DMA_BIT_MASK(24)) {
+        return -1;
+    }
+    
+    dev->dma_mask = mask;
+    return 0;
+}
+
+uint64_t dma_get_mask(struct pci_device *dev) {
+    return dev ? dev->dma_mask : DMA_BIT_MASK(32);
+}
+
+/* Allocate zeroed, physically contiguous memory the device can reach */
+void *dma_alloc_coherent(struct pci_device *dev, size_t size, dma_addr_t *dma_handle) {
+    if (size == 0 || !dma_handle) {
+        return NULL;
+    }
+    
+    size_t pages = PAGE_ALIGN_UP(size) / PAGE_SIZE;
+    uint64_t phys = pmm_alloc_frames(pages);
+    if (!phys) {
+        dma_stats.failures++;
+        return NULL;
+    }
+    
+    /* Frames come lowest-first, so a miss here means nothing lower is free */
+    if (!dma_reachable(dev, phys, pages * PAGE_SIZE)) {
+        pmm_free_frames(phys, pages);
+        dma_stats.failures++;
+        serial_puts("[NEURAL-DMA] No coherent memory below device mask\n");
+        return NULL;
+    }
+    
+    void *cpu_addr = vmm_map(phys, pages * PAGE_SIZE, DMA_KERNEL_FLAGS);
+    if (!cpu_addr) {
+        pmm_free_frames(phys, pages);
+        dma_stats.failures++;
+        return NULL;
+    }
+    
+    memset(cpu_addr, 0, pages * PAGE_SIZE);
+    dma_stats.coherent_bytes += pages * PAGE_SIZE;
+    *dma_handle = phys;
+    return cpu_addr;
+}
+
+void dma_free_coherent(struct pci_device *dev, size_t size, void *cpu_addr, dma_addr_t dma_handle) {
+    (void)dev;
+    
+    if (!cpu_addr || size == 0) {
+        return;
+    }
+    
+    size_t pages = PAGE_ALIGN_UP(size) / PAGE_SIZE;
+    vmm_unmap(cpu_addr, pages * PAGE_SIZE);
+    pmm_free_frames(dma_handle, pages);
+    dma_stats.coherent_bytes -= pages * PAGE_SIZE;
+}
+
+static dma_bounce_t *dma_find_bounce(dma_addr_t dma_handle) {
+    for (int i = 0; i < DMA_MAX_BOUNCES; i++) {
+        if (dma_bounces[i].bounce && dma_bounces[i].dma_addr == dma_handle) {
+            return &dma_bounces[i];
+        }
+    }
+    return NULL;
+}
+
+/* Copy a buffer into reachable contiguous memory for the device */
+static dma_addr_t dma_bounce_map(struct pci_device *dev, void *cpu_addr, size_t size, dma_direction_t dir) {
+    dma_bounce_t *slot = NULL;
+    for (int i = 0; i < DMA_MAX_BOUNCES; i++) {
+        if (!dma_bounces[i].bounce) {
+            slot = &dma_bounces[i];
+            break;
+        }
+    }
+    if (!slot) {
+        serial_puts("[NEURAL-DMA] Bounce slots exhausted\n");
+        return DMA_MAPPING_ERROR;
+    }
+    
+    dma_addr_t dma_addr;
+    void *bounce = dma_alloc_coherent(dev, size, &dma_addr);
+    if (!bounce) {
+        return DMA_MAPPING_ERROR;
+    }
+    
+    if (dir != DMA_FROM_DEVICE) {
+        memcpy(bounce, cpu_addr, size);
+    }
+    
+    slot->dma_addr = dma_addr;
+    slot->bounce = bounce;
+    slot->original = cpu_addr;
+    slot->size = size;
+    slot->pages = PAGE_ALIGN_UP(size) / PAGE_SIZE;
+    
+    dma_stats.bounced++;
+    dma_stats.bounce_bytes += size;
+    return dma_addr;
+}
+
+/* Map a kernel buffer for one transfer; zero-copy whenever the device can
+ * reach it directly.
+ */
+dma_addr_t dma_map_single(struct pci_device *dev, void *cpu_addr, size_t size, dma_direction_t dir) {
+    if (!cpu_addr || size == 0) {
+        return DMA_MAPPING_ERROR;
+    }
+    
+    dma_stats.mappings++;
+    
+    uint64_t phys = dma_contiguous_phys(cpu_addr, size);
+    if (phys && dma_reachable(dev, phys, size)) {
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        return phys;
+    }
+    
+    dma_addr_t dma_addr = dma_bounce_map(dev, cpu_addr, size, dir);
+    if (dma_addr == DMA_MAPPING_ERROR) {
+        dma_stats.failures++;
+    }
+    return dma_addr;
+}
+
+void dma_unmap_single(struct pci_device *dev, dma_addr_t dma_handle, size_t size, dma_direction_t dir) {
+    dma_bounce_t *bounce = dma_find_bounce(dma_handle);
+    if (!bounce) {
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        return;
+    }
+    
+    if (dir != DMA_TO_DEVICE) {
+        memcpy(bounce->original, bounce->bounce, size < bounce->size ? size : bounce->size);
+    }
+    
+    dma_free_coherent(dev, bounce->pages * PAGE_SIZE, bounce->bounce, bounce->dma_addr);
+    bounce->bounce = NULL;
+    bounce->original = NULL;
+}
+
+/* Hand a mapped buffer back to the CPU between transfers */
+void dma_sync_single_for_cpu(struct pci_device *dev, dma_addr_t dma_handle, size_t size, dma_direction_t dir) {
+    (void)dev;
+    
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    
+    dma_bounce_t *bounce = dma_find_bounce(dma_handle);
+    if (bounce && dir != DMA_TO_DEVICE) {
+        memcpy(bounce->original, bounce->bounce, size < bounce->size ? size : bounce->size);
+    }
+}
+
+void dma_sync_single_for_device(struct pci_device *dev, dma_addr_t dma_handle, size_t size, dma_direction_t dir) {
+    (void)dev;
+    
+    dma_bounce_t *bounce = dma_find_bounce(dma_handle);
+    if (bounce && dir != DMA_FROM_DEVICE) {
+        memcpy(bounce->bounce, bounce->original, size < bounce->size ? size : bounce->size);
+    }
+    
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+/* Map every entry of a scatter-gather list; returns nents or 0 on failure */
+int dma_map_sg(struct pci_device *dev, dma_sg_entry_t *sg, int nents, dma_direction_t dir) {
+    if (!sg || nents <= 0) {
+        return 0;
+    }
+    
+    for (int i = 0; i < nents; i++) {
+        sg[i].dma_address = dma_map_single(dev, sg[i].cpu_addr, sg[i].length, dir);
+        if (sg[i].dma_address == DMA_MAPPING_ERROR) {
+            dma_unmap_sg(dev, sg, i, dir);
+            return 0;
+        }
+    }
+    return nents;
+}
+
+void dma_unmap_sg(struct pci_device *dev, dma_sg_entry_t *sg, int nents, dma_direction_t dir) {
+    if (!sg) {
+        return;
+    }
+    
+    for (int i = 0; i < nents; i++) {
+        dma_unmap_single(dev, sg[i].dma_address, sg[i].length, dir);
+        sg[i].dma_address = DMA_MAPPING_ERROR;
+    }
+}
+
+/* Create a pool of `size`-byte blocks aligned to `align` (power of two) */
+dma_pool_t *dma_pool_create(const char *name, struct pci_device *dev, size_t size, size_t align) {
+    if (align < sizeof(void *)) {
+        align = sizeof(void *);
+    }
+    if (size == 0 || (align & (align - 1)) != 0) {
+        return NULL;
+    }
+    
+    size_t block_size = (size + align - 1) & ~(align - 1);
+    if (block_size > PAGE_SIZE) {
+        return NULL;
+    }
+    
+    dma_pool_t *pool = (dma_pool_t *)kcalloc(1, sizeof(dma_pool_t));
+    if (!pool) {
+        return NULL;
+    }
+    
+    pool->name = name;
+    pool->dev = dev;
+    pool->block_size = block_size;
+    return pool;
+}
+
+/* Carve a fresh coherent page into blocks */
+static int dma_pool_grow(dma_pool_t *pool) {
+    if (pool->page_count >= DMA_POOL_MAX_PAGES) {
+        serial_puts("[NEURAL-DMA] Pool exhausted: ");
+        serial_puts(pool->name);
+        serial_puts("\n");
+        return -1;
+    }
+    
+    dma_addr_t dma_addr;
+    uint8_t *page = (uint8_t *)dma_alloc_coherent(pool->dev, PAGE_SIZE, &dma_addr);
+    if (!page) {
+        return -1;
+    }
+    
+    pool->pages[pool->page_count].cpu_addr = page;
+    pool->pages[pool->page_count].dma_addr = dma_addr;
+    pool->page_count++;
+    
+    for (size_t offset = 0; offset + pool->block_size <= PAGE_SIZE; offset += pool->block_size) {
+        *(void **)(page + offset) = pool->free_list;
+        pool->free_list = page + offset;
+    }
+    return 0;
+}
+
+void *dma_pool_alloc(dma_pool_t *pool, dma_addr_t *dma_handle) {
+    if (!pool || !dma_handle) {
+        return NULL;
+    }
+    
+    if (!pool->free_list && dma_pool_grow(pool) != 0) {
+        return NULL;
+    }
+    
+    uint8_t *block = (uint8_t *)pool->free_list;
+    pool->free_list = *(void **)block;
+    
+    /* Pool pages are page aligned, so the block's page gives its bus address */
+    uint8_t *page = (uint8_t *)PAGE_ALIGN_DOWN((uint64_t)block);
+    for (uint32_t i = 0; i < pool->page_count; i++) {
+        if (pool->pages[i].cpu_addr == page) {
+            *dma_handle = pool->pages[i].dma_addr + (block - page);
+            break;
+        }
+    }
+    
+    memset(block, 0, pool->block_size);
+    pool->in_use++;
+    return block;
+}
+
+void dma_pool_free(dma_pool_t *pool, void *cpu_addr, dma_addr_t dma_handle) {
+    (void)dma_handle;
+    
+    if (!pool || !cpu_addr) {
+        return;
+    }
+    
+    *(void **)cpu_addr = pool->free_list;
+    pool->free_list = cpu_addr;
+    pool->in_use--;
+}
+
+void dma_pool_destroy(dma_pool_t *pool) {
+    if (!pool) {
+        return;
+    }
+    
+    if (pool->in_use) {
+        serial_puts("[NEURAL-DMA] Destroying pool with blocks in use: ");
+        serial_puts(pool->name);
+        serial_puts("\n");
+    }
+    
+    for (uint32_t i = 0; i < pool->page_count; i++) {
+        dma_free_coherent(pool->dev, PAGE_SIZE, pool->pages[i].cpu_addr, pool->pages[i].dma_addr);
+    }
+    kfree(pool);
+}
+
+void dma_get_stats(dma_stats_t *stats) {
+    if (stats) {
+        *stats = dma_stats;
+    }
+}
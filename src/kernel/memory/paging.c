@@ -2,6 +2,7 @@
 #include <stdint.h>
 #include "kernel/memory.h"
 #include "kernel/interrupts.h"
+#include "kernel/boot_profile.h"
 
 /* External functions */
 extern void serial_puts(const char *s);
@@ -37,17 +38,21 @@ void paging_init(void) {
     
     /* Identity map first 4MB for kernel */
     serial_puts("[MATRIX] Mapping kernel reality anchor points...\n");
+    boot_profile_begin("paging: identity map");
     for (uint64_t addr = 0; addr < KERNEL_PHYSICAL_END; addr += PAGE_SIZE) {
         paging_map_page(kernel_pml4, addr, addr, 
                        PAGE_PRESENT | PAGE_WRITABLE | PAGE_GLOBAL);
     }
+    boot_profile_end();
     
     /* Map kernel to higher half */
     serial_puts("[MATRIX] Creating higher-dimensional kernel space...\n");
+    boot_profile_begin("paging: higher half");
     for (uint64_t addr = 0; addr < KERNEL_PHYSICAL_END; addr += PAGE_SIZE) {
         paging_map_page(kernel_pml4, KERNEL_VIRTUAL_BASE + addr, addr,
                        PAGE_PRESENT | PAGE_WRITABLE | PAGE_GLOBAL);
     }
+    boot_profile_end();
     
     serial_puts("[MATRIX] Virtual reality matrix constructed successfully\n");
 }
@@ -179,6 +179,14 @@ void process_terminate(struct process *proc) {
     print_dec(proc->pid);
     serial_puts(")\\n");
     
+    /* Release compositor surfaces mapped into this process */
+    extern void compositor_release_process(uint32_t owner_pid);
+    compositor_release_process(proc->pid);
+    
+    /* Release input event rings mapped into this process */
+    extern void input_dev_release_process(uint32_t owner_pid);
+    input_dev_release_process(proc->pid);
+    
     /* Change state to zombie */
     proc->state = PROCESS_ZOMBIE;
     
@@ -245,10 +253,32 @@ void process_sleep(uint32_t milliseconds) {
     print_dec(milliseconds);
     serial_puts("ms\\n");
     
+    process_prepare_sleep(milliseconds);
+    scheduler_yield();
+}
+
+/* Mark the current process asleep without yielding. Waiters call this before
+ * their final condition check, so a process_wake() landing in between makes
+ * the following scheduler_yield() a plain reschedule instead of being lost.
+ */
+void process_prepare_sleep(uint32_t milliseconds) {
+    if (!current_process) return;
+    
     current_process->state = PROCESS_SLEEPING;
     current_process->sleep_until = timer_get_ticks() + (milliseconds / 10);  /* Convert to ticks */
+}
+
+/* Back out of process_prepare_sleep() when the condition already holds */
+void process_cancel_sleep(void) {
+    if (!current_process || current_process->state == PROCESS_RUNNING) return;
     
-    scheduler_yield();
+    /* Woken and queued meanwhile; it is running, so take it off the queue */
+    if (current_process->state == PROCESS_READY) {
+        scheduler_remove_process(current_process);
+    }
+    
+    current_process->state = PROCESS_RUNNING;
+    current_process->sleep_until = 0;
 }
 
 /* Wake up sleeping process */
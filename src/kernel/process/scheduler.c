@@ -1,5 +1,6 @@
 /* scheduler.c - Brandon Media OS Neural Process Scheduler */
 #include <stdint.h>
+#include <stdbool.h>
 #include "kernel/process.h"
 #include "kernel/memory.h"
 #include "kernel/interrupts.h"
@@ -18,6 +19,7 @@ static struct process *ready_queue_tail = NULL;
 static struct process *running_process = NULL;
 static uint64_t last_schedule_time = 0;
 static uint32_t time_slice_counter = 0;
+static bool userland_started = false;
 
 /* Priority queues for priority scheduling */
 static struct process *priority_queues[5] = {NULL}; /* One for each priority level */
@@ -249,6 +251,11 @@ void context_switch(struct process *from, struct process *to) {
     to->last_scheduled = timer_get_ticks();
     running_process = to;
     
+    /* Ring 3 code selector: the first userland process is about to run */
+    if (to->context.cs == USER_CODE_SELECTOR) {
+        userland_started = true;
+    }
+    
     /* Perform actual context switch */
     if (from && to) {
         context_switch_asm(&from->context, &to->context);
@@ -257,6 +264,11 @@ void context_switch(struct process *from, struct process *to) {
     }
 }
 
+/* True once any userland process has been switched to */
+bool scheduler_userland_started(void) {
+    return userland_started;
+}
+
 /* Yield CPU voluntarily */
 void scheduler_yield(void) {
     struct process *current = process_get_current();
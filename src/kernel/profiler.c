@@ -0,0 +1,680 @@
+/* profiler.c - Brandon Media OS Sampling Profiler
+ * Periodic Interrupted-RIP Samples with Frame-Pointer Call Stacks
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include "kernel/profiler.h"
+#include "kernel/ksyms.h"
+#include "kernel/interrupts.h"
+#include "kernel/process.h"
+#include "kernel/memory.h"
+#include "kernel/smp.h"
+#include "kernel/fs.h"
+
+/* CMOS RTC periodic interrupt - the sample clock, independent of the
+ * 100Hz PIT that drives the scheduler
+ */
+#define RTC_INDEX           0x70
+#define RTC_DATA            0x71
+#define RTC_NMI_DISABLE     0x80
+#define RTC_REG_A           0x0A
+#define RTC_REG_B           0x0B
+#define RTC_REG_C           0x0C
+#define RTC_B_PERIODIC      0x40    /* Periodic interrupt enable */
+#define RTC_C_PERIODIC      0x40    /* Periodic interrupt fired */
+#define RTC_IRQ             8
+#define RTC_BASE_HZ         32768
+
+/* Report text served by /dev/profile */
+#define PROFILER_TEXT_SIZE  32768
+#define PROFILER_MAX_CALLERS 8
+#define PROFILER_MAX_PIDS   16
+
+/* I/O port functions */
+static inline void outb(uint16_t port, uint8_t val) {
+    asm volatile ("outb %0, %1" : : "a"(val), "Nd"(port));
+}
+
+static inline uint8_t inb(uint16_t port) {
+    uint8_t ret;
+    asm volatile ("inb %1, %0" : "=a"(ret) : "Nd"(port));
+    return ret;
+}
+
+/* External functions */
+extern void serial_puts(const char *s);
+extern void print_dec(uint64_t num);
+extern int snprintf(char *str, size_t size, const char *format, ...);
+
+/* Per-CPU sample ring, written only from that CPU's RTC interrupt */
+typedef struct {
+    profiler_sample_t *samples;
+    uint64_t total;                 /* Samples taken; ring index is total % size */
+} profiler_cpu_t;
+
+typedef struct {
+    profiler_cpu_t cpus[PROFILER_MAX_CPUS];
+    uint32_t cpu_count;             /* Buffers allocated */
+    uint32_t rate;
+    volatile bool running;
+    volatile bool formatting;       /* Sampling paused while a report reads the rings */
+    profiler_format_t format;       /* Selected for /dev/profile */
+    size_t text_length;
+} profiler_state_t;
+
+/* Samples resolved to symbol buckets for reporting */
+typedef struct {
+    uint32_t *frames;               /* count * PROFILER_MAX_DEPTH buckets, leaf first */
+    uint8_t *depths;
+    uint32_t *pids;
+    uint32_t count;
+    uint32_t buckets;               /* Symbols, then [user], then [unknown] */
+} profiler_view_t;
+
+static profiler_state_t profiler;
+static char profiler_text[PROFILER_TEXT_SIZE];
+static bool profiler_initialized = false;
+
+static inline uint64_t profiler_lock(void) {
+    uint64_t flags;
+    asm volatile ("pushfq; popq %0; cli" : "=r"(flags) : : "memory");
+    return flags;
+}
+
+static inline void profiler_unlock(uint64_t flags) {
+    if (flags & 0x200) {
+        asm volatile ("sti" : : : "memory");
+    }
+}
+
+static uint8_t rtc_read(uint8_t reg) {
+    outb(RTC_INDEX, RTC_NMI_DISABLE | reg);
+    return inb(RTC_DATA);
+}
+
+static void rtc_write(uint8_t reg, uint8_t value) {
+    outb(RTC_INDEX, RTC_NMI_DISABLE | reg);
+    outb(RTC_DATA, value);
+}
+
+/* Walk saved RBP links while they stay on the interrupted stack */
+static void profiler_walk_frames(profiler_sample_t *sample, const irq_context_t *context) {
+    uint64_t frame = context->rbp;
+    uint64_t low = context->rsp;
+    uint64_t high = context->rsp + PROFILER_STACK_WINDOW;
+    
+    while (sample->depth < PROFILER_MAX_DEPTH && frame >= low && frame + 16 <= high && !(frame & 7)) {
+        const uint64_t *link = (const uint64_t *)frame;
+        uint64_t return_address = link[1];
+        if (!ksyms_is_kernel_text(return_address)) {
+            break;
+        }
+        
+        /* Attribute to the call instruction, not the one after it */
+        sample->pc[sample->depth++] = return_address - 1;
+        if (link[0] <= frame) {
+            break;
+        }
+        frame = link[0];
+    }
+}
+
+static void profiler_record(const irq_context_t *context) {
+    struct neural_cpu *cpu = smp_get_current_cpu();
+    uint32_t slot = cpu ? cpu->cpu_id : 0;
+    if (slot >= profiler.cpu_count) {
+        slot = profiler.cpu_count - 1;
+    }
+    
+    profiler_cpu_t *buffer = &profiler.cpus[slot];
+    profiler_sample_t *sample = &buffer->samples[buffer->total % PROFILER_SAMPLES_PER_CPU];
+    buffer->total++;
+    
+    struct process *current = process_get_current();
+    sample->pc[0] = context->rip;
+    sample->pid = current ? current->pid : 0;
+    sample->cpu = (uint8_t)slot;
+    sample->depth = 1;
+    sample->user = (context->cs & 3) != 0;
+    
+    if (!sample->user) {
+        profiler_walk_frames(sample, context);
+    }
+}
+
+static int profiler_rtc_handler(uint8_t irq, void *data) {
+    (void)irq;
+    (void)data;
+    
+    /* Reading register C acknowledges the RTC; it stops interrupting otherwise */
+    outb(RTC_INDEX, RTC_REG_C);
+    if (!(inb(RTC_DATA) & RTC_C_PERIODIC)) {
+        return IRQ_NONE;
+    }
+    
+    const irq_context_t *context = irq_get_context();
+    if (profiler.running && !profiler.formatting && context) {
+        profiler_record(context);
+    }
+    return IRQ_HANDLED;
+}
+
+/* Sample at `hz` (rounded down to a power of two); 0 selects the default */
+int profiler_start(uint32_t hz) {
+    if (!profiler_initialized) {
+        return -1;
+    }
+    
+    if (hz == 0) {
+        hz = PROFILER_DEFAULT_HZ;
+    }
+    if (hz < PROFILER_MIN_HZ) {
+        hz = PROFILER_MIN_HZ;
+    }
+    if (hz > PROFILER_MAX_HZ) {
+        hz = PROFILER_MAX_HZ;
+    }
+    
+    /* Rate select 3..15 gives 32768 >> (select - 1) Hz */
+    uint8_t select = 3;
+    while (select < 15 && (uint32_t)(RTC_BASE_HZ >> (select - 1)) > hz) {
+        select++;
+    }
+    
+    if (profiler.cpu_count == 0) {
+        uint32_t cpus = smp_get_active_cpu_count();
+        if (cpus == 0) {
+            cpus = 1;
+        }
+        if (cpus > PROFILER_MAX_CPUS) {
+            cpus = PROFILER_MAX_CPUS;
+        }
+        
+        for (uint32_t i = 0; i < cpus; i++) {
+            profiler.cpus[i].samples = (profiler_sample_t *)kcalloc(PROFILER_SAMPLES_PER_CPU, sizeof(profiler_sample_t));
+            if (!profiler.cpus[i].samples) {
+                serial_puts("[NEURAL-PROF] Out of memory for sample buffers\n");
+                while (i-- > 0) {
+                    kfree(profiler.cpus[i].samples);
+                    profiler.cpus[i].samples = NULL;
+                }
+                return -1;
+            }
+        }
+        profiler.cpu_count = cpus;
+    }
+    
+    uint64_t flags = profiler_lock();
+    rtc_write(RTC_REG_A, (rtc_read(RTC_REG_A) & 0xF0) | select);
+    rtc_write(RTC_REG_B, rtc_read(RTC_REG_B) | RTC_B_PERIODIC);
+    rtc_read(RTC_REG_C);
+    outb(RTC_INDEX, RTC_REG_C);     /* Leave NMIs enabled */
+    profiler.rate = RTC_BASE_HZ >> (select - 1);
+    profiler.running = true;
+    profiler_unlock(flags);
+    
+    irq_enable(RTC_IRQ);
+    
+    serial_puts("[NEURAL-PROF] Sampling at ");
+    print_dec(profiler.rate);
+    serial_puts("Hz on ");
+    print_dec(profiler.cpu_count);
+    serial_puts(" CPU(s)\n");
+    if (ksyms_count() == 0) {
+        serial_puts("[NEURAL-PROF] No kernel symbol table linked; samples will show as [unknown]\n");
+    }
+    return 0;
+}
+
+void profiler_stop(void) {
+    if (!profiler.running) {
+        return;
+    }
+    
+    uint64_t flags = profiler_lock();
+    rtc_write(RTC_REG_B, rtc_read(RTC_REG_B) & ~RTC_B_PERIODIC);
+    rtc_read(RTC_REG_C);
+    outb(RTC_INDEX, RTC_REG_C);
+    profiler.running = false;
+    profiler_unlock(flags);
+    
+    serial_puts("[NEURAL-PROF] Stopped after ");
+    print_dec(profiler_sample_count());
+    serial_puts(" samples\n");
+}
+
+void profiler_reset(void) {
+    uint64_t flags = profiler_lock();
+    for (uint32_t i = 0; i < profiler.cpu_count; i++) {
+        profiler.cpus[i].total = 0;
+    }
+    profiler_unlock(flags);
+}
+
+bool profiler_is_running(void) {
+    return profiler.running;
+}
+
+uint32_t profiler_get_rate(void) {
+    return profiler.rate;
+}
+
+static uint32_t profiler_cpu_samples(const profiler_cpu_t *buffer) {
+    return buffer->total < PROFILER_SAMPLES_PER_CPU ? (uint32_t)buffer->total : PROFILER_SAMPLES_PER_CPU;
+}
+
+/* Samples currently held (the rings keep the newest) */
+uint64_t profiler_sample_count(void) {
+    uint64_t count = 0;
+    for (uint32_t i = 0; i < profiler.cpu_count; i++) {
+        count += profiler_cpu_samples(&profiler.cpus[i]);
+    }
+    return count;
+}
+
+static uint32_t profiler_bucket(uint64_t pc, bool user, uint32_t symbols) {
+    if (user) {
+        return symbols;
+    }
+    int64_t index = ksyms_lookup_index(pc);
+    return index < 0 ? symbols + 1 : (uint32_t)index;
+}
+
+static const char *profiler_bucket_name(const profiler_view_t *view, uint32_t bucket) {
+    if (bucket + 2 == view->buckets) {
+        return "[user]";
+    }
+    if (bucket + 1 == view->buckets) {
+        return "[unknown]";
+    }
+    return ksyms_get(bucket)->name;
+}
+
+static void profiler_view_free(profiler_view_t *view) {
+    kfree(view->frames);
+    kfree(view->depths);
+    kfree(view->pids);
+}
+
+/* Symbolize every held sample once; sampling must be paused */
+static int profiler_view_build(profiler_view_t *view) {
+    uint32_t symbols = (uint32_t)ksyms_count();
+    
+    memset(view, 0, sizeof(*view));
+    view->buckets = symbols + 2;
+    
+    uint64_t total = profiler_sample_count();
+    if (total == 0) {
+        return 0;
+    }
+    
+    view->frames = (uint32_t *)kmalloc(total * PROFILER_MAX_DEPTH * sizeof(uint32_t));
+    view->depths = (uint8_t *)kmalloc(total);
+    view->pids = (uint32_t *)kmalloc(total * sizeof(uint32_t));
+    if (!view->frames || !view->depths || !view->pids) {
+        profiler_view_free(view);
+        return -1;
+    }
+    
+    for (uint32_t cpu = 0; cpu < profiler.cpu_count; cpu++) {
+        const profiler_cpu_t *buffer = &profiler.cpus[cpu];
+        uint32_t held = profiler_cpu_samples(buffer);
+        
+        for (uint32_t i = 0; i < held; i++) {
+            const profiler_sample_t *sample = &buffer->samples[i];
+            uint32_t *frames = &view->frames[view->count * PROFILER_MAX_DEPTH];
+            
+            for (uint32_t depth = 0; depth < sample->depth; depth++) {
+                frames[depth] = profiler_bucket(sample->pc[depth], sample->user, symbols);
+            }
+            view->depths[view->count] = sample->depth;
+            view->pids[view->count] = sample->pid;
+            view->count++;
+        }
+    }
+    return 0;
+}
+
+#define PROFILER_APPEND(...) \
+    do { \
+        if (len < size) { \
+            int n = snprintf(text + len, size - len, __VA_ARGS__); \
+            len += n > 0 ? (size_t)n : 0; \
+        } \
+    } while (0)
+
+/* Highest remaining count; taken entries are zeroed */
+static uint32_t profiler_take_max(uint32_t *counts, uint32_t entries, uint32_t *value) {
+    uint32_t best = 0;
+    for (uint32_t i = 1; i < entries; i++) {
+        if (counts[i] > counts[best]) {
+            best = i;
+        }
+    }
+    *value = counts[best];
+    counts[best] = 0;
+    return best;
+}
+
+static size_t profiler_format_flat(const profiler_view_t *view, char *text, size_t size, size_t len) {
+    uint32_t *self = (uint32_t *)kcalloc(view->buckets, sizeof(uint32_t));
+    if (!self) {
+        return len;
+    }
+    
+    uint32_t pids[PROFILER_MAX_PIDS];
+    uint32_t pid_counts[PROFILER_MAX_PIDS] = {0};
+    uint32_t pid_entries = 0;
+    uint32_t pid_other = 0;
+    
+    for (uint32_t i = 0; i < view->count; i++) {
+        self[view->frames[i * PROFILER_MAX_DEPTH]]++;
+        
+        uint32_t p = 0;
+        while (p < pid_entries && pids[p] != view->pids[i]) {
+            p++;
+        }
+        if (p == pid_entries && pid_entries < PROFILER_MAX_PIDS) {
+            pids[pid_entries++] = view->pids[i];
+        }
+        if (p < pid_entries) {
+            pid_counts[p]++;
+        } else {
+            pid_other++;
+        }
+    }
+    
+    PROFILER_APPEND("  SAMPLES    PCT FUNCTION\n");
+    for (uint32_t shown = 0; shown < PROFILER_REPORT_TOP; shown++) {
+        uint32_t count;
+        uint32_t bucket = profiler_take_max(self, view->buckets, &count);
+        if (count == 0) {
+            break;
+        }
+        uint32_t permille = (uint32_t)((uint64_t)count * 1000 / view->count);
+        PROFILER_APPEND("%9u %3u.%u%% %s\n", count, permille / 10, permille % 10,
+                        profiler_bucket_name(view, bucket));
+    }
+    
+    PROFILER_APPEND("\n  SAMPLES    PCT PID\n");
+    for (uint32_t shown = 0; shown < pid_entries; shown++) {
+        uint32_t count;
+        uint32_t p = profiler_take_max(pid_counts, pid_entries, &count);
+        if (count == 0) {
+            break;
+        }
+        uint32_t permille = (uint32_t)((uint64_t)count * 1000 / view->count);
+        PROFILER_APPEND("%9u %3u.%u%% %u\n", count, permille / 10, permille % 10, pids[p]);
+    }
+    if (pid_other) {
+        PROFILER_APPEND("%9u        (other processes)\n", pid_other);
+    }
+    
+    kfree(self);
+    return len;
+}
+
+static size_t profiler_format_graph(const profiler_view_t *view, char *text, size_t size, size_t len) {
+    uint32_t *self = (uint32_t *)kcalloc(view->buckets, sizeof(uint32_t));
+    uint32_t *total = (uint32_t *)kcalloc(view->buckets, sizeof(uint32_t));
+    if (!self || !total) {
+        kfree(self);
+        kfree(total);
+        return len;
+    }
+    
+    for (uint32_t i = 0; i < view->count; i++) {
+        const uint32_t *frames = &view->frames[i * PROFILER_MAX_DEPTH];
+        self[frames[0]]++;
+        
+        /* Count each function once per sample, however deep it recurses */
+        for (uint32_t depth = 0; depth < view->depths[i]; depth++) {
+            uint32_t seen = 0;
+            while (seen < depth && frames[seen] != frames[depth]) {
+                seen++;
+            }
+            if (seen == depth) {
+                total[frames[depth]]++;
+            }
+        }
+    }
+    
+    PROFILER_APPEND("  TOTAL%%     TOTAL      SELF FUNCTION\n");
+    PROFILER_APPEND("                               <- caller (samples)\n");
+    for (uint32_t shown = 0; shown < PROFILER_REPORT_TOP; shown++) {
+        uint32_t count;
+        uint32_t bucket = profiler_take_max(total, view->buckets, &count);
+        if (count == 0) {
+            break;
+        }
+        
+        uint32_t permille = (uint32_t)((uint64_t)count * 1000 / view->count);
+        PROFILER_APPEND("%5u.%u%% %9u %9u %s\n", permille / 10, permille % 10, count, self[bucket],
+                        profiler_bucket_name(view, bucket));
+        
+        /* Immediate callers at the outermost occurrence */
+        uint32_t callers[PROFILER_MAX_CALLERS];
+        uint32_t caller_counts[PROFILER_MAX_CALLERS] = {0};
+        uint32_t caller_entries = 0;
+        
+        for (uint32_t i = 0; i < view->count; i++) {
+            const uint32_t *frames = &view->frames[i * PROFILER_MAX_DEPTH];
+            int32_t depth = (int32_t)view->depths[i] - 1;
+            while (depth >= 0 && frames[depth] != bucket) {
+                depth--;
+            }
+            if (depth < 0 || depth + 1 >= (int32_t)view->depths[i]) {
+                continue;
+            }
+            
+            uint32_t caller = frames[depth + 1];
+            uint32_t c = 0;
+            while (c < caller_entries && callers[c] != caller) {
+                c++;
+            }
+            if (c == caller_entries && caller_entries < PROFILER_MAX_CALLERS) {
+                callers[caller_entries++] = caller;
+            }
+            if (c < caller_entries) {
+                caller_counts[c]++;
+            }
+        }
+        
+        for (uint32_t c = 0; c < caller_entries; c++) {
+            uint32_t calls;
+            uint32_t index = profiler_take_max(caller_counts, caller_entries, &calls);
+            if (calls == 0) {
+                break;
+            }
+            PROFILER_APPEND("                               <- %s (%u)\n",
+                            profiler_bucket_name(view, callers[index]), calls);
+        }
+    }
+    
+    kfree(self);
+    kfree(total);
+    return len;
+}
+
+static bool profiler_same_stack(const profiler_view_t *view, uint32_t a, uint32_t b) {
+    if (view->depths[a] != view->depths[b] || view->pids[a] != view->pids[b]) {
+        return false;
+    }
+    return memcmp(&view->frames[a * PROFILER_MAX_DEPTH], &view->frames[b * PROFILER_MAX_DEPTH],
+                  view->depths[a] * sizeof(uint32_t)) == 0;
+}
+
+static size_t profiler_format_folded(const profiler_view_t *view, char *text, size_t size, size_t len) {
+    uint32_t *stacks = (uint32_t *)kmalloc(PROFILER_MAX_STACKS * sizeof(uint32_t));
+    uint32_t *counts = (uint32_t *)kcalloc(PROFILER_MAX_STACKS, sizeof(uint32_t));
+    if (!stacks || !counts) {
+        kfree(stacks);
+        kfree(counts);
+        return len;
+    }
+    
+    uint32_t entries = 0;
+    uint32_t other = 0;
+    for (uint32_t i = 0; i < view->count; i++) {
+        uint32_t s = 0;
+        while (s < entries && !profiler_same_stack(view, stacks[s], i)) {
+            s++;
+        }
+        if (s == entries && entries < PROFILER_MAX_STACKS) {
+            stacks[entries++] = i;
+        }
+        if (s < entries) {
+            counts[s]++;
+        } else {
+            other++;
+        }
+    }
+    
+    /* Root frame is the process, then outermost caller down to the leaf */
+    for (uint32_t s = 0; s < entries; s++) {
+        uint32_t sample = stacks[s];
+        const uint32_t *frames = &view->frames[sample * PROFILER_MAX_DEPTH];
+        
+        PROFILER_APPEND("pid-%u", view->pids[sample]);
+        for (int32_t depth = (int32_t)view->depths[sample] - 1; depth >= 0; depth--) {
+            PROFILER_APPEND(";%s", profiler_bucket_name(view, frames[depth]));
+        }
+        PROFILER_APPEND(" %u\n", counts[s]);
+    }
+    if (other) {
+        PROFILER_APPEND("[other] %u\n", other);
+    }
+    
+    kfree(stacks);
+    kfree(counts);
+    return len;
+}
+
+/* Render the held samples; returns the text length */
+size_t profiler_format(profiler_format_t format, char *text, size_t size) {
+    size_t len = 0;
+    profiler_view_t view;
+    
+    if (!text || size == 0) {
+        return 0;
+    }
+    
+    profiler.formatting = true;
+    int result = profiler_view_build(&view);
+    profiler.formatting = false;
+    
+    if (result != 0) {
+        PROFILER_APPEND("# out of memory\n");
+        return len < size ? len : size - 1;
+    }
+    
+    if (format != PROFILER_FORMAT_FOLDED) {
+        PROFILER_APPEND("# %u samples at %uHz on %u CPU(s), %s\n", view.count, profiler.rate,
+                        profiler.cpu_count, profiler.running ? "running" : "stopped");
+    }
+    
+    if (view.count) {
+        switch (format) {
+            case PROFILER_FORMAT_GRAPH:
+                len = profiler_format_graph(&view, text, size, len);
+                break;
+            case PROFILER_FORMAT_FOLDED:
+                len = profiler_format_folded(&view, text, size, len);
+                break;
+            default:
+                len = profiler_format_flat(&view, text, size, len);
+                break;
+        }
+    }
+    
+    profiler_view_free(&view);
+    return len < size ? len : size - 1;
+}
+
+#undef PROFILER_APPEND
+
+/* Dump a report to the serial console */
+void profiler_print(profiler_format_t format) {
+    profiler_format(format, profiler_text, sizeof(profiler_text));
+    serial_puts("[NEURAL-PROF] === Profile ===\n");
+    serial_puts(profiler_text);
+    serial_puts("[NEURAL-PROF] === End Profile ===\n");
+}
+
+/* Reads from offset 0 render a fresh report; later reads continue it */
+static int64_t profiler_device_read(struct vfs_node *node, void *buffer, uint64_t size, uint64_t offset) {
+    (void)node;
+    
+    if (offset == 0) {
+        profiler.text_length = profiler_format(profiler.format, profiler_text, sizeof(profiler_text));
+    }
+    if (offset >= profiler.text_length) {
+        return 0;
+    }
+    
+    uint64_t count = profiler.text_length - offset < size ? profiler.text_length - offset : size;
+    memcpy(buffer, profiler_text + offset, count);
+    return (int64_t)count;
+}
+
+static int64_t profiler_device_ioctl(struct vfs_node *node, uint32_t cmd, void *arg) {
+    (void)node;
+    
+    switch (cmd) {
+        case PROFILER_IOCTL_START:
+            return profiler_start((uint32_t)(uintptr_t)arg);
+        
+        case PROFILER_IOCTL_STOP:
+            profiler_stop();
+            return 0;
+        
+        case PROFILER_IOCTL_RESET:
+            profiler_reset();
+            return 0;
+        
+        case PROFILER_IOCTL_FORMAT:
+            if ((uintptr_t)arg > PROFILER_FORMAT_FOLDED) {
+                return -1;
+            }
+            profiler.format = (profiler_format_t)(uintptr_t)arg;
+            return 0;
+        
+        default:
+            return -1;
+    }
+}
+
+static struct file_operations profiler_device_ops = {
+    .read = profiler_device_read,
+    .ioctl = profiler_device_ioctl,
+};
+
+/* Claim the RTC interrupt and publish /dev/profile; sampling starts on request */
+int profiler_init(void) {
+    if (profiler_initialized) {
+        return 0;
+    }
+    
+    if (irq_register_handler(RTC_IRQ, profiler_rtc_handler, NULL, "profiler") != 0) {
+        return -1;
+    }
+    
+    struct vfs_node *node = vfs_create_device(PROFILER_DEVICE_DIR, PROFILER_DEVICE_NAME, &profiler_device_ops, NULL);
+    if (!node) {
+        serial_puts("[NEURAL-PROF] Failed to create " PROFILER_DEVICE_DIR "/" PROFILER_DEVICE_NAME "\n");
+        irq_unregister_handler(RTC_IRQ, profiler_rtc_handler, NULL);
+        return -1;
+    }
+    node->permissions = FS_PERM_READ;
+    
+    profiler.format = PROFILER_FORMAT_FLAT;
+    profiler_initialized = true;
+    
+    serial_puts("[NEURAL-PROF] Sampling profiler ready, ");
+    print_dec(ksyms_count());
+    serial_puts(" kernel symbols\n");
+    return 0;
+}
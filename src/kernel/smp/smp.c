@@ -61,6 +61,7 @@ struct neural_cpu {
     uint32_t interrupts_handled;
     const char *neural_designation;
     int online;
+    int running;                    /* Executing kernel code; safe interrupt target */
 } __attribute__((aligned(64)));
 
 /* CPU Status Codes */
@@ -182,6 +183,7 @@ static void detect_neural_cores(void) {
     neural_matrix[0].interrupts_handled = 0;
     neural_matrix[0].neural_designation = get_neural_designation(0);
     neural_matrix[0].online = 1;
+    neural_matrix[0].running = 1;
     
     neural_cpu_count = 1;
     active_neural_cores = 1;
@@ -206,6 +208,7 @@ static void detect_neural_cores(void) {
         neural_matrix[i].interrupts_handled = 0;
         neural_matrix[i].neural_designation = get_neural_designation(i);
         neural_matrix[i].online = 0;
+        neural_matrix[i].running = 0;
         
         neural_cpu_count++;
         
@@ -268,6 +271,11 @@ static int start_application_processor(uint8_t cpu_id) {
     
     neural_matrix[cpu_id].status = CPU_STATUS_ONLINE;
     neural_matrix[cpu_id].online = 1;
+    
+    /* No trampoline at the startup vector yet: the AP never reaches kernel
+     * code, so it stays off the list of interrupt targets
+     */
+    neural_matrix[cpu_id].running = 0;
     active_neural_cores++;
     
     serial_puts("[NEURAL-SMP] ");
@@ -378,6 +386,12 @@ void smp_print_neural_matrix_status(void) {
         print_dec(i);
         serial_puts("] Load Average: ");
         print_dec(neural_matrix[i].load_average);
+        serial_puts("\n");
+        
+        serial_puts("[CORE-");
+        print_dec(i);
+        serial_puts("] Interrupts Handled: ");
+        print_dec(neural_matrix[i].interrupts_handled);
         serial_puts("\n\n");
     }
     
@@ -467,4 +481,37 @@ uint32_t smp_get_cpu_count(void) {
 /* Get active CPU count */
 uint32_t smp_get_active_cpu_count(void) {
     return active_neural_cores;
-}
\ No newline at end of file
+}
+
+/* CPUs that execute kernel code and can take interrupts */
+uint32_t smp_get_running_cpu_count(void) {
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < neural_cpu_count; i++) {
+        if (neural_matrix[i].running) {
+            count++;
+        }
+    }
+    return count ? count : 1;
+}
+
+int smp_cpu_is_running(uint8_t cpu_id) {
+    if (cpu_id >= neural_cpu_count) {
+        return cpu_id == 0;
+    }
+    return neural_matrix[cpu_id].running;
+}
+/* Signal end of interrupt to this CPU's local APIC */
+void smp_apic_eoi(void) {
+    if (neural_matrix_base) {
+        apic_write(APIC_EOI, 0);
+    }
+}
+
+/* Get the APIC ID interrupts must target to reach a CPU */
+uint32_t smp_get_apic_id(uint8_t cpu_id) {
+    if (cpu_id >= neural_cpu_count) {
+        return neural_matrix[0].apic_id;
+    }
+    
+    return neural_matrix[cpu_id].apic_id;
+}
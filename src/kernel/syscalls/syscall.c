@@ -4,6 +4,8 @@
 #include "kernel/process.h"
 #include "kernel/memory.h"
 #include "kernel/interrupts.h"
+#include "kernel/compositor.h"
+#include "kernel/uart.h"
 
 /* External functions */
 extern void serial_puts(const char *s);
@@ -14,6 +16,12 @@ extern void process_sleep(uint32_t milliseconds);
 extern void scheduler_yield(void);
 extern void process_terminate(struct process *proc);
 
+/* VFS channel operations (fs.h clashes with struct file_stat here) */
+extern int vfs_open(const char *path, uint32_t flags, uint32_t mode);
+extern int vfs_close(int fd);
+extern int64_t vfs_read(int fd, void *buffer, size_t count);
+extern int64_t vfs_ioctl(int fd, uint32_t cmd, void *arg);
+
 /* System call function pointer table */
 typedef int64_t (*syscall_func_t)(uint64_t arg0, uint64_t arg1, uint64_t arg2, 
                                   uint64_t arg3, uint64_t arg4, uint64_t arg5);
@@ -42,7 +50,7 @@ static syscall_func_t syscall_table[MAX_SYSCALL_NUM + 1] = {
     (syscall_func_t)sys_brk,       /* 15: Heap boundary adjust */
     (syscall_func_t)sys_pipe,      /* 16: Neural data pipe */
     sys_invalid,                   /* 17: DUP - not implemented */
-    sys_invalid,                   /* 18: IOCTL - not implemented */
+    (syscall_func_t)sys_ioctl,     /* 18: Neural device control */
     sys_invalid,                   /* 19: STAT - not implemented */
     sys_invalid,                   /* 20: MKDIR - not implemented */
     sys_invalid,                   /* 21: RMDIR - not implemented */
@@ -57,6 +65,10 @@ static syscall_func_t syscall_table[MAX_SYSCALL_NUM + 1] = {
     sys_invalid,                   /* 30: CONNECT - not implemented */
     sys_invalid,                   /* 31: SEND - not implemented */
     sys_invalid,                   /* 32: RECV - not implemented */
+    (syscall_func_t)sys_surface_create,    /* 33: Shared surface map */
+    (syscall_func_t)sys_surface_commit,    /* 34: Surface damage commit */
+    (syscall_func_t)sys_surface_destroy,   /* 35: Shared surface unmap */
+    (syscall_func_t)sys_surface_configure, /* 36: Surface placement */
 };
 
 /* System call statistics */
@@ -115,17 +127,19 @@ int64_t syscall_handler(struct syscall_params *params) {
     syscall_stats.total_calls++;
     syscall_stats.call_counts[params->syscall_num]++;
     
-    /* Log system call (for debugging) */
-    serial_puts("[GATEWAY] Neural interface command: ");
-    print_dec(params->syscall_num);
-    serial_puts(" from PID: ");
-    struct process *current = process_get_current();
-    if (current) {
-        print_dec(current->pid);
-    } else {
-        serial_puts("UNKNOWN");
+    /* Log system call (for debugging) - per-frame surface commits stay quiet */
+    if (params->syscall_num != SYS_SURFACE_COMMIT) {
+        serial_puts("[GATEWAY] Neural interface command: ");
+        print_dec(params->syscall_num);
+        serial_puts(" from PID: ");
+        struct process *current = process_get_current();
+        if (current) {
+            print_dec(current->pid);
+        } else {
+            serial_puts("UNKNOWN");
+        }
+        serial_puts("\\n");
     }
-    serial_puts("\\n");
     
     /* Call the appropriate system call handler */
     syscall_func_t handler = syscall_table[params->syscall_num];
@@ -171,19 +185,25 @@ int64_t sys_exit(int32_t status) {
 
 /* Read from file descriptor */
 int64_t sys_read(int32_t fd, void *buffer, size_t count) {
+    if (!buffer) {
+        return -EFAULT;
+    }
+    
+    /* Console input from the UART receive ring; never blocks, so the
+     * shell polls it without logging every attempt
+     */
+    if (fd == STDIN_FILENO) {
+        return (int64_t)uart_read((char *)buffer, count);
+    }
+    
     serial_puts("[READ] Neural data stream read: FD ");
     print_dec(fd);
     serial_puts(", Count: ");
     print_dec(count);
     serial_puts("\\n");
     
-    /* Simple implementation - only support stdin for now */
-    if (fd == STDIN_FILENO) {
-        /* For now, return 0 (EOF) */
-        return 0;
-    }
-    
-    return -EBADF;
+    int64_t result = vfs_read(fd, buffer, count);
+    return result < 0 ? -EBADF : result;
 }
 
 /* Write to file descriptor */
@@ -192,37 +212,41 @@ int64_t sys_write(int32_t fd, const void *buffer, size_t count) {
         return -EINVAL;
     }
     
+    /* Console output goes out verbatim: the shell echoes keystrokes and
+     * erases with "\b \b" one byte at a time, so no log or prefix here
+     */
+    if (fd == STDOUT_FILENO || fd == STDERR_FILENO) {
+        uart_write((const char *)buffer, count);
+        return count;
+    }
+    
     serial_puts("[WRITE] Neural output: FD ");
     print_dec(fd);
     serial_puts(", Count: ");
     print_dec(count);
     serial_puts("\\n");
     
-    /* Support stdout and stderr */
-    if (fd == STDOUT_FILENO || fd == STDERR_FILENO) {
-        const char *data = (const char *)buffer;
-        
-        /* Write to serial console */
-        serial_puts("[USER_OUTPUT] ");
-        for (size_t i = 0; i < count; i++) {
-            extern void serial_putc(char c);
-            serial_putc(data[i]);
-        }
-        
-        return count;
-    }
-    
     return -EBADF;
 }
 
 /* Open file */
 int64_t sys_open(const char *pathname, int32_t flags, uint32_t mode) {
-    (void)pathname; (void)flags; (void)mode;
+    if (!pathname) {
+        return -EFAULT;
+    }
     
     serial_puts("[OPEN] Neural channel open request\\n");
     
-    /* Not implemented yet */
-    return -ENOSYS;
+    /* O_* access mode to VFS read/write permission bits */
+    uint32_t access;
+    switch (flags & 0x3) {
+        case O_WRONLY: access = 0x2; break;
+        case O_RDWR:   access = 0x3; break;
+        default:       access = 0x1; break;
+    }
+    
+    int fd = vfs_open(pathname, access, mode);
+    return fd < 0 ? -ENOENT : fd;
 }
 
 /* Close file */
@@ -231,8 +255,14 @@ int64_t sys_close(int32_t fd) {
     print_dec(fd);
     serial_puts("\\n");
     
-    /* Not implemented yet */
-    return -ENOSYS;
+    if (fd < 0) {
+        return -EBADF;
+    }
+    if (fd <= STDERR_FILENO) {
+        return 0;
+    }
+    
+    return vfs_close(fd) == 0 ? 0 : -EBADF;
 }
 
 /* Fork process */
@@ -373,6 +403,64 @@ int64_t sys_pipe(int32_t pipefd[2]) {
     return -ENOSYS;
 }
 
+/* Device control */
+int64_t sys_ioctl(int32_t fd, uint32_t cmd, void *arg) {
+    if (fd < 0) {
+        return -EBADF;
+    }
+    if (fd <= STDERR_FILENO) {
+        return -ENOTTY;
+    }
+    
+    int64_t result = vfs_ioctl(fd, cmd, arg);
+    return result < 0 ? -EINVAL : result;
+}
+
+/* Create compositor surface - returns the client address of its shared header */
+int64_t sys_surface_create(uint32_t width, uint32_t height, uint32_t flags) {
+    struct process *current = process_get_current();
+    if (!current) {
+        return -ESRCH;
+    }
+    
+    uint64_t user_addr = 0;
+    if (compositor_surface_create(current->pid, width, height, flags, &user_addr) < 0) {
+        return -ENOMEM;
+    }
+    
+    return (int64_t)user_addr;
+}
+
+/* Commit surface damage - pixels are already in shared memory */
+int64_t sys_surface_commit(uint32_t id) {
+    struct process *current = process_get_current();
+    if (!current) {
+        return -ESRCH;
+    }
+    
+    return compositor_surface_commit(current->pid, id) == 0 ? 0 : -EBADF;
+}
+
+/* Destroy compositor surface */
+int64_t sys_surface_destroy(uint32_t id) {
+    struct process *current = process_get_current();
+    if (!current) {
+        return -ESRCH;
+    }
+    
+    return compositor_surface_destroy(current->pid, id) == 0 ? 0 : -EBADF;
+}
+
+/* Move/restack compositor surface */
+int64_t sys_surface_configure(uint32_t id, int32_t x, int32_t y, int32_t z) {
+    struct process *current = process_get_current();
+    if (!current) {
+        return -ESRCH;
+    }
+    
+    return compositor_surface_configure(current->pid, id, x, y, z) == 0 ? 0 : -EBADF;
+}
+
 /* Error handling functions */
 const char *syscall_strerror(int32_t error_code) {
     switch (error_code) {
@@ -90,6 +90,92 @@ struct neural_app_registration {
     struct neural_app_interface interface;
 };
 
+/* Compositor Surface Sharing (mirrors kernel/compositor.h) */
+#define NEURAL_SURFACE_MAGIC        0x53555246
+#define NEURAL_SURFACE_DAMAGE_RING  32
+#define NEURAL_SURFACE_OPAQUE       0x01
+#define NEURAL_SURFACE_HIDDEN       0x02
+
+struct neural_surface_damage {
+    int32_t x;
+    int32_t y;
+    int32_t width;
+    int32_t height;
+};
+
+/* Header page of a surface mapped by the kernel; pixels follow at pixel_offset */
+struct neural_surface_shared {
+    uint32_t magic;
+    uint32_t id;
+    uint32_t width;
+    uint32_t height;
+    uint32_t pitch;
+    uint32_t pixel_offset;
+    uint32_t flags;
+    uint32_t reserved;
+    volatile uint32_t damage_head;
+    volatile uint32_t damage_tail;
+    volatile uint32_t damage_overflow;
+    volatile uint32_t frame_seq;
+    struct neural_surface_damage damage[NEURAL_SURFACE_DAMAGE_RING];
+};
+
+/* Input Device Rings (mirrors kernel/input_dev.h) */
+#define NEURAL_INPUT_MAGIC          0x45564E54
+#define NEURAL_INPUT_RING_SIZE      256
+#define NEURAL_INPUT_IOCTL_MAP_RING 0x4901
+#define NEURAL_INPUT_IOCTL_GET_INFO 0x4902
+#define NEURAL_INPUT_IOCTL_WAIT     0x4903
+
+/* Event types (kernel input_event_type_t) */
+#define NEURAL_INPUT_KEY_PRESS      0
+#define NEURAL_INPUT_KEY_RELEASE    1
+#define NEURAL_INPUT_MOUSE_MOVE     2
+#define NEURAL_INPUT_MOUSE_PRESS    3
+#define NEURAL_INPUT_MOUSE_RELEASE  4
+#define NEURAL_INPUT_MOUSE_WHEEL    5
+
+struct neural_input_event {
+    uint64_t tsc;
+    uint32_t timestamp;
+    uint16_t type;
+    uint16_t code;
+    int32_t value;
+    int32_t x, y;
+    int32_t dx, dy;
+    uint32_t reserved;
+};
+
+/* Event ring of an open /dev/input/eventN, mapped by the kernel */
+struct neural_input_shared {
+    uint32_t magic;
+    uint32_t device_type;
+    uint32_t ring_size;
+    uint32_t event_size;
+    volatile uint32_t head;
+    volatile uint32_t tail;
+    volatile uint32_t dropped;
+    volatile uint32_t waiting;
+    char name[32];
+    struct neural_input_event events[NEURAL_INPUT_RING_SIZE];
+};
+
+/* Input Context for Neural Applications */
+struct neural_input_context {
+    int fd;
+    struct neural_input_shared *ring;
+};
+
+/* Sampling Profiler (mirrors kernel/profiler.h) */
+#define NEURAL_PROFILE_IOCTL_START  0x5001      /* arg: rate in Hz, 0 = default */
+#define NEURAL_PROFILE_IOCTL_STOP   0x5002
+#define NEURAL_PROFILE_IOCTL_RESET  0x5003
+#define NEURAL_PROFILE_IOCTL_FORMAT 0x5004
+
+#define NEURAL_PROFILE_FLAT         0
+#define NEURAL_PROFILE_GRAPH        1
+#define NEURAL_PROFILE_FOLDED       2
+
 /* Graphics Context for Neural Applications */
 struct neural_graphics_context {
     uint32_t width;
@@ -102,6 +188,13 @@ struct neural_graphics_context {
     uint32_t background_color;
     int cursor_x;
     int cursor_y;
+    
+    /* Compositor surface backing the framebuffer */
+    struct neural_surface_shared *surface;
+    int damage_x0;
+    int damage_y0;
+    int damage_x1;
+    int damage_y1;
 };
 
 /* Network Context for Neural Applications */
@@ -146,8 +239,16 @@ void neural_graphics_clear(struct neural_graphics_context *gfx, uint32_t color);
 void neural_graphics_put_pixel(struct neural_graphics_context *gfx, int x, int y, uint32_t color);
 void neural_graphics_draw_rect(struct neural_graphics_context *gfx, int x, int y, int width, int height, uint32_t color);
 void neural_graphics_draw_text(struct neural_graphics_context *gfx, int x, int y, const char *text, uint32_t color);
+void neural_graphics_damage(struct neural_graphics_context *gfx, int x, int y, int width, int height);
+void neural_graphics_move(struct neural_graphics_context *gfx, int x, int y, int z);
 void neural_graphics_flip(struct neural_graphics_context *gfx);
 
+/* Input Interface */
+int neural_input_open(struct neural_input_context *input, const char *path);
+void neural_input_close(struct neural_input_context *input);
+int neural_input_poll(struct neural_input_context *input, struct neural_input_event *event);
+int neural_input_wait(struct neural_input_context *input, uint32_t timeout_ms);
+
 /* Network Interface */
 int neural_network_init(struct neural_network_context *net);
 void neural_network_cleanup(struct neural_network_context *net);
@@ -149,6 +149,21 @@ int neural_app_check_permission(struct neural_app_context *ctx, uint32_t permiss
 
 /* Graphics Interface Functions */
 
+/* Grow the pending damage box; flushed to the compositor on flip */
+static void neural_graphics_mark(struct neural_graphics_context *gfx, int x0, int y0, int x1, int y1) {
+    if (x0 < gfx->damage_x0) gfx->damage_x0 = x0;
+    if (y0 < gfx->damage_y0) gfx->damage_y0 = y0;
+    if (x1 > gfx->damage_x1) gfx->damage_x1 = x1;
+    if (y1 > gfx->damage_y1) gfx->damage_y1 = y1;
+}
+
+static void neural_graphics_reset_damage(struct neural_graphics_context *gfx) {
+    gfx->damage_x0 = (int)gfx->width;
+    gfx->damage_y0 = (int)gfx->height;
+    gfx->damage_x1 = 0;
+    gfx->damage_y1 = 0;
+}
+
 int neural_graphics_init(struct neural_graphics_context *gfx) {
     if (!gfx) return -1;
     
@@ -156,7 +171,7 @@ int neural_graphics_init(struct neural_graphics_context *gfx) {
     gfx->width = 800;
     gfx->height = 600;
     gfx->bpp = 32;
-    gfx->framebuffer = NULL;  /* Will be mapped by system */
+    gfx->framebuffer = NULL;
     gfx->pitch = gfx->width * (gfx->bpp / 8);
     gfx->double_buffered = 1;
     gfx->foreground_color = NEURAL_COLOR_CYAN;
@@ -164,6 +179,18 @@ int neural_graphics_init(struct neural_graphics_context *gfx) {
     gfx->cursor_x = 0;
     gfx->cursor_y = 0;
     
+    /* Ask the compositor for a shared surface - we draw straight into its pages */
+    gfx->surface = (struct neural_surface_shared *)surface_create(gfx->width, gfx->height, NEURAL_SURFACE_OPAQUE);
+    if (!gfx->surface || gfx->surface->magic != NEURAL_SURFACE_MAGIC) {
+        gfx->surface = NULL;
+        neural_error("Neural compositor surface unavailable");
+        return -1;
+    }
+    
+    gfx->framebuffer = (uint32_t *)((uint8_t *)gfx->surface + gfx->surface->pixel_offset);
+    gfx->pitch = gfx->surface->pitch;
+    neural_graphics_reset_damage(gfx);
+    
     neural_log(NEURAL_APP_TYPE_MEDIA, "Neural graphics initialized");
     return 0;
 }
@@ -171,6 +198,12 @@ int neural_graphics_init(struct neural_graphics_context *gfx) {
 void neural_graphics_cleanup(struct neural_graphics_context *gfx) {
     if (!gfx) return;
     
+    if (gfx->surface) {
+        surface_destroy(gfx->surface->id);
+        gfx->surface = NULL;
+        gfx->framebuffer = NULL;
+    }
+    
     neural_log(NEURAL_APP_TYPE_MEDIA, "Neural graphics cleanup");
 }
 
@@ -183,6 +216,8 @@ void neural_graphics_clear(struct neural_graphics_context *gfx, uint32_t color)
             gfx->framebuffer[y * gfx->width + x] = color;
         }
     }
+    
+    neural_graphics_mark(gfx, 0, 0, (int)gfx->width, (int)gfx->height);
 }
 
 void neural_graphics_put_pixel(struct neural_graphics_context *gfx, int x, int y, uint32_t color) {
@@ -192,6 +227,7 @@ void neural_graphics_put_pixel(struct neural_graphics_context *gfx, int x, int y
     }
     
     gfx->framebuffer[y * gfx->width + x] = color;
+    neural_graphics_mark(gfx, x, y, x + 1, y + 1);
 }
 
 void neural_graphics_draw_rect(struct neural_graphics_context *gfx, int x, int y, int width, int height, uint32_t color) {
@@ -220,11 +256,108 @@ void neural_graphics_draw_text(struct neural_graphics_context *gfx, int x, int y
     }
 }
 
+/* Report pixels written directly through gfx->framebuffer */
+void neural_graphics_damage(struct neural_graphics_context *gfx, int x, int y, int width, int height) {
+    if (!gfx || width <= 0 || height <= 0) return;
+    
+    neural_graphics_mark(gfx, x, y, x + width, y + height);
+}
+
+/* Place the surface on screen; higher z stacks on top */
+void neural_graphics_move(struct neural_graphics_context *gfx, int x, int y, int z) {
+    if (!gfx || !gfx->surface) return;
+    
+    surface_configure(gfx->surface->id, x, y, z);
+}
+
 void neural_graphics_flip(struct neural_graphics_context *gfx) {
-    if (!gfx || !gfx->double_buffered) return;
+    if (!gfx || !gfx->surface) return;
+    
+    /* Nothing drawn since the last flip */
+    if (gfx->damage_x0 >= gfx->damage_x1 || gfx->damage_y0 >= gfx->damage_y1) {
+        return;
+    }
+    
+    /* Queue the damage box in the shared ring; the commit carries no pixels */
+    struct neural_surface_shared *shared = gfx->surface;
+    uint32_t head = shared->damage_head;
+    if (head - shared->damage_tail >= NEURAL_SURFACE_DAMAGE_RING) {
+        shared->damage_overflow = 1;
+    } else {
+        struct neural_surface_damage *damage = &shared->damage[head % NEURAL_SURFACE_DAMAGE_RING];
+        damage->x = gfx->damage_x0;
+        damage->y = gfx->damage_y0;
+        damage->width = gfx->damage_x1 - gfx->damage_x0;
+        damage->height = gfx->damage_y1 - gfx->damage_y0;
+        __atomic_store_n(&shared->damage_head, head + 1, __ATOMIC_RELEASE);
+    }
+    
+    surface_commit(shared->id);
+    neural_graphics_reset_damage(gfx);
+}
+
+/* Input Interface Functions */
+
+int neural_input_open(struct neural_input_context *input, const char *path) {
+    if (!input || !path) return -1;
+    
+    input->ring = NULL;
+    input->fd = open(path, O_RDONLY);
+    if (input->fd < 0) {
+        return -1;
+    }
+    
+    /* Events land in this ring directly; no syscall per event */
+    int64_t addr = ioctl(input->fd, NEURAL_INPUT_IOCTL_MAP_RING, NULL);
+    struct neural_input_shared *ring = (struct neural_input_shared *)addr;
+    if (addr <= 0 || ring->magic != NEURAL_INPUT_MAGIC) {
+        close(input->fd);
+        input->fd = -1;
+        neural_error("Neural input ring unavailable");
+        return -1;
+    }
+    
+    input->ring = ring;
+    return 0;
+}
+
+void neural_input_close(struct neural_input_context *input) {
+    if (!input || input->fd < 0) return;
+    
+    close(input->fd);
+    input->fd = -1;
+    input->ring = NULL;
+}
+
+/* Take the next event; returns 0 when the ring is empty */
+int neural_input_poll(struct neural_input_context *input, struct neural_input_event *event) {
+    if (!input || !input->ring || !event) return 0;
+    
+    struct neural_input_shared *ring = input->ring;
+    uint32_t tail = ring->tail;
+    if (tail == __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE)) {
+        return 0;
+    }
+    
+    *event = ring->events[tail % NEURAL_INPUT_RING_SIZE];
+    __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+    return 1;
+}
+
+/* Sleep until events are pending; returns 1 if ready, 0 on timeout */
+int neural_input_wait(struct neural_input_context *input, uint32_t timeout_ms) {
+    if (!input || !input->ring) return -1;
+    
+    struct neural_input_shared *ring = input->ring;
+    
+    /* Announce the sleep first so a racing event wakes us */
+    __atomic_store_n(&ring->waiting, 1, __ATOMIC_SEQ_CST);
+    if (ring->tail != __atomic_load_n(&ring->head, __ATOMIC_SEQ_CST)) {
+        ring->waiting = 0;
+        return 1;
+    }
     
-    /* In a real implementation, this would swap buffers */
-    neural_log(NEURAL_APP_TYPE_MEDIA, "Neural graphics buffer flipped");
+    return (int)ioctl(input->fd, NEURAL_INPUT_IOCTL_WAIT, (void *)(uintptr_t)timeout_ms);
 }
 
 /* Network Interface Functions */
@@ -36,6 +36,24 @@ ssize_t read(int fd, void *buf, size_t count) {
     return (ssize_t)result;
 }
 
+int32_t open(const char *pathname, int flags, ...) {
+    int64_t result;
+    asm volatile("syscall" : "=a"(result) : "a"(3), "D"(pathname), "S"(flags), "d"(0) : "rcx", "r11", "memory");
+    return (int32_t)result;
+}
+
+int32_t close(int fd) {
+    int64_t result;
+    asm volatile("syscall" : "=a"(result) : "a"(4), "D"(fd) : "rcx", "r11", "memory");
+    return (int32_t)result;
+}
+
+int64_t ioctl(int fd, uint32_t cmd, void *arg) {
+    int64_t result;
+    asm volatile("syscall" : "=a"(result) : "a"(18), "D"(fd), "S"(cmd), "d"(arg) : "rcx", "r11", "memory");
+    return result;
+}
+
 int32_t sleep(unsigned int seconds) {
     int64_t result;
     uint32_t milliseconds = seconds * 1000;
@@ -47,6 +65,31 @@ void yield(void) {
     asm volatile("syscall" : : "a"(10) : "rcx", "r11", "memory");
 }
 
+void *surface_create(uint32_t width, uint32_t height, uint32_t flags) {
+    int64_t result;
+    asm volatile("syscall" : "=a"(result) : "a"(33), "D"(width), "S"(height), "d"(flags) : "rcx", "r11", "memory");
+    return result < 0 ? NULL : (void *)result;
+}
+
+int32_t surface_commit(uint32_t id) {
+    int64_t result;
+    asm volatile("syscall" : "=a"(result) : "a"(34), "D"(id) : "rcx", "r11", "memory");
+    return (int32_t)result;
+}
+
+int32_t surface_destroy(uint32_t id) {
+    int64_t result;
+    asm volatile("syscall" : "=a"(result) : "a"(35), "D"(id) : "rcx", "r11", "memory");
+    return (int32_t)result;
+}
+
+int32_t surface_configure(uint32_t id, int32_t x, int32_t y, int32_t z) {
+    int64_t result;
+    register int64_t r10 asm("r10") = z;
+    asm volatile("syscall" : "=a"(result) : "a"(36), "D"(id), "S"(x), "d"(y), "r"(r10) : "rcx", "r11", "memory");
+    return (int32_t)result;
+}
+
 /* String functions */
 
 size_t strlen(const char *s) {
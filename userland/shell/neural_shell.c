@@ -31,6 +31,8 @@ int cmd_network(int argc, char *argv[]);
 int cmd_security(int argc, char *argv[]);
 int cmd_memory(int argc, char *argv[]);
 int cmd_processes(int argc, char *argv[]);
+int cmd_interrupts(int argc, char *argv[]);
+int cmd_profile(int argc, char *argv[]);
 int cmd_clear(int argc, char *argv[]);
 int cmd_exit(int argc, char *argv[]);
 
@@ -45,6 +47,8 @@ static struct neural_command neural_commands[] = {
     {"security", "Security system status", cmd_security},
     {"memory", "Neural memory analysis", cmd_memory},
     {"processes", "Display neural processes", cmd_processes},
+    {"interrupts", "Interrupt counts, latency and spurious events", cmd_interrupts},
+    {"profile", "Sampling profiler: start [hz] | stop | reset | flat | graph | folded", cmd_profile},
     {"clear", "Clear neural interface", cmd_clear},
     {"exit", "Terminate neural session", cmd_exit},
     {NULL, NULL, NULL}
@@ -109,21 +113,39 @@ void neural_shell_prompt(void) {
 }
 
 void neural_shell_read_command(void) {
-    /* Simple command reading (placeholder) */
-    /* In a real implementation, this would read from stdin */
-    static int command_counter = 0;
-    const char *demo_commands[] = {
-        "status", "matrix", "neural", "cyber", "network", 
-        "security", "memory", "processes", "help", "exit"
-    };
-    
-    int cmd_index = command_counter % 10;
-    strcpy(command_buffer, demo_commands[cmd_index]);
-    command_counter++;
-    
-    /* Simulate user input display */
-    write(1, command_buffer, strlen(command_buffer));
-    write(1, "\n", 1);
+    /* Read a line from the serial console; the kernel buffers input
+     * from the UART interrupt, so poll and sleep between keystrokes
+     */
+    size_t length = 0;
+    
+    while (1) {
+        char c;
+        if (read(0, &c, 1) != 1) {
+            neural_sleep(10);
+            continue;
+        }
+        
+        if (c == '\r' || c == '\n') {
+            write(1, "\n", 1);
+            break;
+        }
+        
+        /* Backspace / delete */
+        if (c == '\b' || c == 0x7F) {
+            if (length > 0) {
+                length--;
+                write(1, "\b \b", 3);
+            }
+            continue;
+        }
+        
+        if (c >= ' ' && c <= '~' && length < MAX_COMMAND_LENGTH - 1) {
+            command_buffer[length++] = c;
+            write(1, &c, 1);
+        }
+    }
+    
+    command_buffer[length] = '\0';
 }
 
 void neural_shell_execute_command(struct neural_app_context *ctx) {
@@ -319,6 +341,74 @@ int cmd_processes(int argc, char *argv[]) {
     return 0;
 }
 
+int cmd_interrupts(int argc, char *argv[]) {
+    (void)argc;
+    (void)argv;
+    
+    int fd = open("/dev/interrupts", O_RDONLY);
+    if (fd < 0) {
+        neural_error("Interrupt statistics unavailable");
+        return -1;
+    }
+    
+    char buffer[512];
+    ssize_t count;
+    while ((count = read(fd, buffer, sizeof(buffer))) > 0) {
+        write(1, buffer, count);
+    }
+    
+    close(fd);
+    return 0;
+}
+
+int cmd_profile(int argc, char *argv[]) {
+    int fd = open("/dev/profile", O_RDONLY);
+    if (fd < 0) {
+        neural_error("Sampling profiler unavailable");
+        return -1;
+    }
+    
+    const char *action = argc > 1 ? argv[1] : "flat";
+    int64_t result = 0;
+    int format = -1;
+    
+    if (strcmp(action, "start") == 0) {
+        uint32_t hz = argc > 2 ? (uint32_t)atoi(argv[2]) : 0;
+        result = ioctl(fd, NEURAL_PROFILE_IOCTL_START, (void *)(uintptr_t)hz);
+    } else if (strcmp(action, "stop") == 0) {
+        result = ioctl(fd, NEURAL_PROFILE_IOCTL_STOP, NULL);
+    } else if (strcmp(action, "reset") == 0) {
+        result = ioctl(fd, NEURAL_PROFILE_IOCTL_RESET, NULL);
+    } else if (strcmp(action, "flat") == 0) {
+        format = NEURAL_PROFILE_FLAT;
+    } else if (strcmp(action, "graph") == 0) {
+        format = NEURAL_PROFILE_GRAPH;
+    } else if (strcmp(action, "folded") == 0) {
+        format = NEURAL_PROFILE_FOLDED;
+    } else {
+        neural_error("Usage: profile start [hz] | stop | reset | flat | graph | folded");
+        close(fd);
+        return -1;
+    }
+    
+    if (format >= 0) {
+        result = ioctl(fd, NEURAL_PROFILE_IOCTL_FORMAT, (void *)(uintptr_t)format);
+        
+        char buffer[512];
+        ssize_t count;
+        while (result == 0 && (count = read(fd, buffer, sizeof(buffer))) > 0) {
+            write(1, buffer, count);
+        }
+    }
+    
+    if (result < 0) {
+        neural_error("Profiler request failed");
+    }
+    
+    close(fd);
+    return result < 0 ? -1 : 0;
+}
+
 int cmd_clear(int argc, char *argv[]) {
     (void)argc;
     (void)argv;